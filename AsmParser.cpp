@@ -9,30 +9,54 @@
 //-------------------------------------------------------------------------------------------------
 #include "AsmParser.h"
 #include "StringHelper.h"
+#include "Logger.h"
+#include "DxbcReader.h"
+#include "PackWriter.h"
 #include <cstdio>
+#include <cstring>
+#include <io.h>
+#include <fcntl.h>
 #include <new>
 #include <cassert>
 #include <algorithm>
-#include <fstream>
+#include <charconv>
 #include <iostream>
 #include <sstream>
 
 
 #ifndef DLOG
 #if defined(DEBUG) || defined(_DEBUG)
-#define DLOG( x, ... ) fprintf_s( stdout, "[File:%s, Line:%d] " x "\n", __FILE__, __LINE__, ##__VA_ARGS__ )
+// 標準出力は変換結果 ("-o -") にも使うので，デバッグログは標準エラー出力に流す.
+#define DLOG( x, ... ) Logger::Print( stderr, "[File:%s, Line:%d] " x "\n", __FILE__, __LINE__, ##__VA_ARGS__ )
 #else
 #define DLOG( x, ... )
 #endif
 #endif//DLOG
 
 #ifndef ELOG
-#define ELOG( x, ... ) fprintf_s( stderr, x "\n", ##__VA_ARGS__)
+#define ELOG( x, ... ) Logger::Print( stderr, x "\n", ##__VA_ARGS__)
 #endif//ELOG
 
 
 namespace {
 
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+const char kToolVersion[] = "revert_shader-11";  // 出力形式を変えたら更新すること (キャッシュキーに含まれる).
+
+const char kStandardStream[] = "-";             // 入出力に指定すると標準入出力を使う.
+const size_t kStreamChunkSize = 64 * 1024;      // 標準入力の読み込み単位.
+
+const std::string kOutputSuffix[] = {
+    "_vs.hlsl",
+    "_ps.hlsl",
+    "_gs.hlsl",
+    "_ds.hlsl",
+    "_hs.hlsl",
+    "_cs.hlsl"
+};
+
 
 std::string ToVarName(const std::string& name)
 {
@@ -59,6 +83,318 @@ std::string ToVarName(const std::string& name)
     return result;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      ヘッダのシグニチャ行 (Name Index Mask Register SysValue Format Used) を読み込みます.
+//-------------------------------------------------------------------------------------------------
+a3d::Signature ToSignature(const std::string& line)
+{
+    auto decl = StringHelper::Replace(line, "//", "");
+    auto args = StringHelper::Split(decl, " ");
+    assert(args.size() >= 6);
+
+    a3d::Signature result = {};
+    result.Semantics      = args[0];
+    result.Index          = std::stoi(args[1]);
+    result.Mask           = args[2];
+    result.Register       = std::stoi(args[3]);
+    result.SystemValue    = args[4];
+    result.Format         = args[5];
+    result.Used           = (args.size() == 7) ? args[6] : "";
+    result.VarName        = ToVarName(result.Semantics);
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      行内に指定文字列が含まれるかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool ContainText(const char* pHead, const char* pTail, const char* text)
+{
+    auto length = strlen(text);
+    return std::search(pHead, pTail, text, text + length) != pTail;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      コンパイル済みシェーダのシグニチャとリソース定義をリフレクションに登録します.
+//-------------------------------------------------------------------------------------------------
+bool ReadReflection(const DxbcReader& reader, a3d::Reflection& reflection)
+{
+    std::vector<a3d::Signature> signatures;
+    if (reader.ReadInputSignature(signatures))
+    {
+        for(auto& itr : signatures)
+        {
+            itr.VarName = ToVarName(itr.Semantics);
+            reflection.AddInputSignature(itr);
+        }
+    }
+
+    if (reader.ReadOutputSignature(signatures))
+    {
+        for(auto& itr : signatures)
+        {
+            itr.VarName = ToVarName(itr.Semantics);
+            reflection.AddOutputSignature(itr);
+        }
+    }
+
+    // ハルシェーダとドメインシェーダのみが持つ.
+    if (reader.ReadPatchConstantSignature(signatures))
+    {
+        for(auto& itr : signatures)
+        {
+            itr.VarName = ToVarName(itr.Semantics);
+            reflection.AddPatchConstantSignature(itr);
+        }
+    }
+
+    // リソース定義が取り除かれている場合は，リソースを持たないシェーダとして扱う.
+    if (reader.FindChunk("RDEF", nullptr) == nullptr)
+    { return true; }
+
+    return reader.ReadResourceDefinition(reflection);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      名前解決済みのリフレクション同士を比較します.
+//-------------------------------------------------------------------------------------------------
+bool CompareReflection(const a3d::Reflection& expected, const a3d::Reflection& actual)
+{
+    struct Section
+    {
+        const char* Name;
+        const std::vector<std::string>& (a3d::Reflection::*Getter)() const;
+    };
+
+    const Section kSections[] = {
+        { "ConstantBuffer",  &a3d::Reflection::GetDefConstantBuffer  },
+        { "InputSignature",  &a3d::Reflection::GetDefInputSignature  },
+        { "OutputSignature", &a3d::Reflection::GetDefOutputSignature },
+        { "PatchConstant",   &a3d::Reflection::GetDefPatchConstantSignature },
+        { "BuiltInOutput",   &a3d::Reflection::GetDefBuiltInOutput   },
+        { "Sampler",         &a3d::Reflection::GetDefSamplers        },
+        { "Texture",         &a3d::Reflection::GetDefTextures        },
+        { "Structure",       &a3d::Reflection::GetDefStructures      },
+        { "Uav",             &a3d::Reflection::GetDefUavs            },
+    };
+
+    auto result = true;
+    for(auto& section : kSections)
+    {
+        auto& lhs = (expected.*section.Getter)();
+        auto& rhs = (actual.*section.Getter)();
+
+        auto count = std::max(lhs.size(), rhs.size());
+        for(size_t i=0; i<count; ++i)
+        {
+            auto pLhs = (i < lhs.size()) ? lhs[i].c_str() : "(none)";
+            auto pRhs = (i < rhs.size()) ? rhs[i].c_str() : "(none)";
+            if (strcmp(pLhs, pRhs) == 0)
+            { continue; }
+
+            ELOG( "Warning : %s[%zu] differs.\n  text   : %s\n  binary : %s", section.Name, i, pLhs, pRhs );
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      出力パスからパックのエントリ名 (ディレクトリを除いたファイル名) を取得します.
+//-------------------------------------------------------------------------------------------------
+std::string GetEntryName(const std::string& path)
+{
+    auto pos = path.find_last_of("/\\");
+    if (pos == std::string::npos)
+    { return path; }
+
+    return path.substr(pos + 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      シェーダプロファイル (vs_5_0 など) かどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool IsProfile(std::string_view token)
+{
+    return token.size() >= 4
+        && token[1] == 's'
+        && token[2] == '_'
+        && ('0' <= token[3] && token[3] <= '9');
+}
+
+//-------------------------------------------------------------------------------------------------
+//      シェーダの種別を命令表のステージに変換します.
+//-------------------------------------------------------------------------------------------------
+uint8_t ToStageFlag(SHADER_TYPE type)
+{
+    switch(type)
+    {
+    case SHADER_TYPE_VERTEX:    return a3d::OPCODE_FLAG_VERTEX;
+    case SHADER_TYPE_PIXEL:     return a3d::OPCODE_FLAG_PIXEL;
+    case SHADER_TYPE_GEOMETRY:  return a3d::OPCODE_FLAG_GEOMETRY;
+    case SHADER_TYPE_DOMAIN:    return a3d::OPCODE_FLAG_DOMAIN;
+    case SHADER_TYPE_HULL:      return a3d::OPCODE_FLAG_HULL;
+    case SHADER_TYPE_COMPUTE:   return a3d::OPCODE_FLAG_COMPUTE;
+    }
+
+    return a3d::OPCODE_FLAG_STAGE_MASK;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      シェーダプロファイルからシェーダの種別を取得します.
+//-------------------------------------------------------------------------------------------------
+bool ToShaderType(std::string_view profile, SHADER_TYPE& result)
+{
+    struct Tag
+    {
+        std::string_view    Prefix;
+        SHADER_TYPE         Type;
+    };
+
+    const Tag kTags[] = {
+        { "vs_", SHADER_TYPE_VERTEX   },
+        { "ps_", SHADER_TYPE_PIXEL    },
+        { "gs_", SHADER_TYPE_GEOMETRY },
+        { "ds_", SHADER_TYPE_DOMAIN   },
+        { "hs_", SHADER_TYPE_HULL     },
+        { "cs_", SHADER_TYPE_COMPUTE  },
+    };
+
+    for(auto& tag : kTags)
+    {
+        if (profile.substr(0, tag.Prefix.size()) == tag.Prefix)
+        {
+            result = tag.Type;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      条件判定の比較式を取得します (_z は 0 と等しい, _nz は 0 と異なる).
+//-------------------------------------------------------------------------------------------------
+const char* ToTestString(const a3d::Modifier& modifier)
+{ return ((modifier.Flags & a3d::MODIFIER_TEST_NZ) != 0) ? " != 0" : " == 0"; }
+
+//-------------------------------------------------------------------------------------------------
+//      テクセルオフセットを文字列に変換します.
+//-------------------------------------------------------------------------------------------------
+std::string ToOffsetString(const a3d::Modifier& modifier, int count)
+{
+    // 次元が分からない場合は全成分を出力する.
+    if (count < 1 || count > 3)
+    { count = 3; }
+
+    std::string result = (count == 1) ? "int(" : "int" + std::to_string(count) + "(";
+    for(auto i=0; i<count; ++i)
+    {
+        if (i > 0)
+        { result += ", "; }
+        result += std::to_string(modifier.Offset[i]);
+    }
+    result += ")";
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      abs() による修飾を取り除き，取り除いた先頭部分 ("abs(" または "-abs(") を返却します.
+//-------------------------------------------------------------------------------------------------
+std::string StripAbs(std::string& value)
+{
+    for(auto head : { "abs(", "-abs(" })
+    {
+        auto length = strlen(head);
+        if (value.size() > length + 1 && value.compare(0, length, head) == 0 && value.back() == ')')
+        {
+            value = value.substr(length, value.size() - length - 1);
+            return head;
+        }
+    }
+
+    return std::string();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      整数のオペランドを数値に変換します.
+//-------------------------------------------------------------------------------------------------
+int ToInt(std::string_view value)
+{
+    auto result = 0;
+    std::from_chars(value.data(), value.data() + value.size(), result);
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      即値 (l(...)) かどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool IsLiteral(std::string_view value)
+{ return value.size() >= 2 && value[0] == 'l' && value[1] == '('; }
+
+//-------------------------------------------------------------------------------------------------
+//      即値を式に変換します. 2成分以上は floatN(...) で囲みます.
+//      <ex> "l(1.000000, 0, 0, 0)" -> "float4(1.000000, 0, 0, 0)"
+//-------------------------------------------------------------------------------------------------
+std::string ToLiteralString(std::string_view value)
+{
+    auto body = value.substr(2);
+    if (!body.empty() && body.back() == ')')
+    { body.remove_suffix(1); }
+
+    std::string_view items[4];
+    auto count = a3d::SplitOperands(body, items, 4);
+    if (count <= 1)
+    { return std::string((count == 1) ? items[0] : body); }
+
+    std::string result = "float" + std::to_string(count) + "(";
+    for(auto i=0; i<count; ++i)
+    {
+        if (i > 0)
+        { result += ", "; }
+        result += items[i];
+    }
+    result += ")";
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      空白を含む添字 (相対アドレス) を詰めて，整数に変換する式にします.
+//      <ex> "cb0[r1.x + 2].x" -> "cb0[asuint(r1.x+2)].x"
+//-------------------------------------------------------------------------------------------------
+std::string ToIndexedString(std::string_view value)
+{
+    auto bracket = value.find('[');
+    if (bracket == std::string_view::npos || value.find_first_of(" \t", bracket) == std::string_view::npos)
+    { return std::string(value); }
+
+    std::string result;
+    result.reserve(value.size() + 16);
+    for(auto c : value)
+    {
+        if (c == ' ' || c == '\t')
+        { continue; }
+
+        if (c == '[')
+        { result += "[asuint("; }
+        else if (c == ']')
+        { result += ")]"; }
+        else
+        { result += c; }
+    }
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      先頭が指定文字列と一致するかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool StartsWith(std::string_view value, std::string_view tag)
+{ return value.substr(0, tag.size()) == tag; }
+
 } // namespace
 
 
@@ -71,7 +407,9 @@ std::string ToVarName(const std::string& name)
 //-------------------------------------------------------------------------------------------------
 AsmParser::AsmParser()
 : m_pBuffer     (nullptr)
+, m_pHeapBuffer (nullptr)
 , m_BufferSize  (0)
+, m_MappedFile  ()
 , m_Tokenizer   ()
 { /* DO_NOTHING */ }
 
@@ -80,12 +418,7 @@ AsmParser::AsmParser()
 //-------------------------------------------------------------------------------------------------
 AsmParser::~AsmParser()
 {
-    if (m_pBuffer != nullptr)
-    {
-        delete[] m_pBuffer;
-        m_pBuffer = nullptr;
-    }
-
+    ReleaseAsm();
     m_Tokenizer.Term();
 }
 
@@ -93,6 +426,33 @@ AsmParser::~AsmParser()
 //      アセンブリファイルをロードします.
 //-------------------------------------------------------------------------------------------------
 bool AsmParser::LoadAsm(const char* filename)
+{
+    ReleaseAsm();
+
+    if (strcmp(filename, kStandardStream) == 0)
+    { return ReadStream(stdin); }
+
+    // ファイルマッピングを優先して，コピー無しでバッファを参照する.
+    if (!m_Argument.DisableMapping && m_MappedFile.Open(filename))
+    {
+        // ページ境界ぴったりのファイルは終端が保証されないので読み込みに切り替える.
+        if (m_MappedFile.IsTerminated())
+        {
+            m_pBuffer    = m_MappedFile.GetData();
+            m_BufferSize = m_MappedFile.GetSize();
+            return true;
+        }
+
+        m_MappedFile.Close();
+    }
+
+    return ReadAsm(filename);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      アセンブリファイルをメモリに読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool AsmParser::ReadAsm(const char* filename)
 {
     FILE* pFile;
 
@@ -113,19 +473,20 @@ bool AsmParser::LoadAsm(const char* filename)
     m_BufferSize = static_cast<size_t>(endpos - curpos);
 
     // メモリを確保.
-    m_pBuffer = new(std::nothrow) char[m_BufferSize + 1]; // null終端させるために +1 している.
-    if (m_pBuffer == nullptr)
+    m_pHeapBuffer = new(std::nothrow) char[m_BufferSize + 1]; // null終端させるために +1 している.
+    if (m_pHeapBuffer == nullptr)
     {
         ELOG( "Error : Out of memory." );
         fclose(pFile);
         return false;
     }
 
-    // null終端になるようゼロクリア.
-    memset(m_pBuffer, 0, sizeof(char) * (m_BufferSize + 1));
-
     // 一括読み込み.
-    fread(m_pBuffer, sizeof(char) * m_BufferSize, 1, pFile);
+    m_BufferSize = fread(m_pHeapBuffer, sizeof(char), m_BufferSize, pFile);
+
+    // 読み込めた位置でnull終端させる.
+    m_pHeapBuffer[m_BufferSize] = '\0';
+    m_pBuffer = m_pHeapBuffer;
 
     // ファイルを閉じる.
     fclose(pFile);
@@ -134,12 +495,96 @@ bool AsmParser::LoadAsm(const char* filename)
     return true;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      ストリームからアセンブリを終端まで読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool AsmParser::ReadStream(FILE* pStream)
+{
+    // コンパイル済みバイナリも受け取れるように改行コードを変換させない.
+    _setmode(_fileno(pStream), _O_BINARY);
+
+    // サイズが事前に分からないので，届いた分だけ追記しながら領域を広げる.
+    size_t capacity = kStreamChunkSize;
+    size_t size     = 0;
+    auto pBuffer    = new(std::nothrow) char[capacity + 1]; // null終端させるために +1 している.
+    if (pBuffer == nullptr)
+    {
+        ELOG( "Error : Out of memory." );
+        return false;
+    }
+
+    for(;;)
+    {
+        if (size == capacity)
+        {
+            auto pNext = new(std::nothrow) char[capacity * 2 + 1];
+            if (pNext == nullptr)
+            {
+                ELOG( "Error : Out of memory." );
+                delete[] pBuffer;
+                return false;
+            }
+
+            memcpy(pNext, pBuffer, size);
+            delete[] pBuffer;
+
+            pBuffer   = pNext;
+            capacity *= 2;
+        }
+
+        auto count = fread(pBuffer + size, sizeof(char), capacity - size, pStream);
+        size += count;
+
+        if (count == 0)
+        { break; }
+    }
+
+    if (ferror(pStream))
+    {
+        ELOG( "Error : Stream Read Failed." );
+        delete[] pBuffer;
+        return false;
+    }
+
+    // 読み込めた位置でnull終端させる.
+    pBuffer[size] = '\0';
+
+    m_pHeapBuffer = pBuffer;
+    m_pBuffer     = m_pHeapBuffer;
+    m_BufferSize  = size;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      読み込んだアセンブリを解放します.
+//-------------------------------------------------------------------------------------------------
+void AsmParser::ReleaseAsm()
+{
+    if (m_pHeapBuffer != nullptr)
+    {
+        delete[] m_pHeapBuffer;
+        m_pHeapBuffer = nullptr;
+    }
+
+    // 命令はテキストを指しているので，テキストと一緒に破棄する.
+    m_Program.clear();
+    m_OperandText.clear();
+
+    m_MappedFile.Close();
+    m_LineIndex.Clear();
+
+    m_pBuffer    = nullptr;
+    m_BufferSize = 0;
+}
+
 //-------------------------------------------------------------------------------------------------
 //      アセンブリファイルを解析します.
 //-------------------------------------------------------------------------------------------------
 bool AsmParser::Parse()
 {
-    if (!LoadAsm(m_Argument.Input.c_str()))
+    // キャッシュキーの計算のために読み込み済みの場合がある.
+    if (m_pBuffer == nullptr && !LoadAsm(m_Argument.Input.c_str()))
     {
         ELOG( "Error : HLSL Asm File Load Failed. filename = %s", m_Argument.Input.c_str());
         return false;
@@ -153,18 +598,63 @@ bool AsmParser::Parse()
 
     m_Tokenizer.SetSeparator(" \t\r\n,");
     m_Tokenizer.SetCutOff("{}():");
-    m_Tokenizer.SetBuffer( m_pBuffer );
 
-    std::ifstream file;
-    file.open(m_Argument.Input.c_str(), std::ios::in);
-    if (!file.is_open())
-    { return false; }
+    // コンパイル済みバイナリの場合はコンテナから直接読み込む.
+    if (DxbcReader::IsDxbc(m_pBuffer, m_BufferSize))
+    { return ParseDxbc(); }
+
+    // 行の索引を作っておき，ヘッダの走査と命令行のデコードに使う.
+    m_LineIndex.Build(m_pBuffer, m_BufferSize);
+
+    // リフレクションは指定が無ければコメントのヘッダから読み込み，指定があればヘッダは -rcheck の照合にだけ使う.
+    a3d::Reflection headerReflection;
+    auto pHeaderReflection = &m_Reflection;
+    if (!m_Argument.Reflection.empty())
+    {
+        if (!LoadReflection(m_Argument.Reflection, m_Reflection))
+        {
+            ELOG( "Error : Reflection Load Failed. filename = %s", m_Argument.Reflection.c_str());
+            return false;
+        }
+
+        pHeaderReflection = m_Argument.CheckReflection ? &headerReflection : nullptr;
+    }
+
+    if (pHeaderReflection != nullptr)
+    { ParseHeader(*pHeaderReflection); }
+
+    m_Instructions.clear();
+    m_Program.reserve(m_LineIndex.GetInstructionCount());
+    m_Instructions.reserve(m_LineIndex.GetInstructionCount());
+
+    // 名前解決.
+    m_Reflection.Resolve();
+
+    // 両方の経路で同じ定義が得られるか照合する.
+    if (pHeaderReflection == &headerReflection)
+    {
+        headerReflection.Resolve();
+        if (!CompareReflection(headerReflection, m_Reflection))
+        {
+            ELOG( "Error : Reflection Mismatch. filename = %s, reflection = %s",
+                m_Argument.Input.c_str(), m_Argument.Reflection.c_str());
+            return false;
+        }
+    }
+
+    // ヘッダのコメントはトークン化せず，最初の命令行から解析する.
+    ParseAsm(m_pBuffer, m_LineIndex.GetFirstInstruction());
 
-    int index = -1;
-    char buf[4096];
-    memset(buf, 0, sizeof(buf));
+    m_Instructions.shrink_to_fit();
+
+    return true;
+}
 
-    auto instructionCount = 0;
+//-------------------------------------------------------------------------------------------------
+//      アセンブリのコメントに含まれるヘッダを解析します.
+//-------------------------------------------------------------------------------------------------
+void AsmParser::ParseHeader(a3d::Reflection& reflection)
+{
     bool uavInfo = false;
     bool structInfo = false;
     std::string uavName;
@@ -172,60 +662,60 @@ bool AsmParser::Parse()
     a3d::ConstantBuffer cbDef = {};
     a3d::Structure structDef = {};
 
+    // 行の索引を使って，ロード済みのバッファのコメント行を走査する (ファイルを再度開かない).
     std::string line;
-    for(;;)
+    for(size_t i=0; i<m_LineIndex.GetCount(); ++i)
     {
-        std::getline(file, line);
-        if (!file)
-            break;
+        auto& info  = m_LineIndex.GetLine(i);
+        auto pHead  = m_pBuffer + info.Offset;
+        auto pTail  = pHead + info.Size;
+        auto length = size_t(info.Size);
 
-        if (file.eof())
-            break;
-
-        strcpy_s(buf, line.c_str());
-
-        if (buf[0] == '/' && buf[1] == '/')
+        if (info.Type == LINE_TYPE_COMMENT)
         {
+            line.assign(pHead, length);
+
             // 改行コードは飛ばす.
-            if (strlen(buf) == 2)
+            if (length == 2)
             {
                 continue; 
             }
-            else if (strstr(buf, "=") != nullptr)
+            else if (ContainText(pHead, pTail, "="))
             {
                 // 定数代入文は無視.
                 continue;
             }
-            else if (strstr(buf, "Definitions:") != nullptr)
+            else if (ContainText(pHead, pTail, "Definitions:"))
             {
                 m_BufferSection = true;
             }
-            else if (strstr(buf, "Bindings:") != nullptr)
+            else if (ContainText(pHead, pTail, "Bindings:"))
             {
                 m_ResourceSection   = true;
                 m_BufferSection     = false;
                 m_InputSection      = false;
                 m_OutputSection     = false;
+                m_PatchConstantSection = false;
             }
-            else if (strstr(buf, "signature:") != nullptr)
+            else if (ContainText(pHead, pTail, "signature:"))
             {
-                if (strstr(buf, "Input") != nullptr)
-                {
-                    m_ResourceSection   = false;
-                    m_BufferSection     = false;
-                    m_InputSection      = true;
-                    m_OutputSection     = false;
-                }
-                else if (strstr(buf, "Output") != nullptr)
-                {
-                    m_ResourceSection   = false;
-                    m_BufferSection     = false;
-                    m_InputSection      = false;
-                    m_OutputSection     = true;
-                }
+                m_ResourceSection   = false;
+                m_BufferSection     = false;
+                m_InputSection      = ContainText(pHead, pTail, "Input");
+                m_OutputSection     = ContainText(pHead, pTail, "Output");
+                m_PatchConstantSection = ContainText(pHead, pTail, "Patch Constant");
+            }
+            else if (ContainText(pHead, pTail, "Tessellation"))
+            {
+                // テッセレーションの設定は命令の宣言から得られるので，表は読み飛ばす.
+                m_ResourceSection   = false;
+                m_BufferSection     = false;
+                m_InputSection      = false;
+                m_OutputSection     = false;
+                m_PatchConstantSection = false;
             }
-            else if((buf[3] == 'N' && buf[4] == 'a' && buf[5] == 'm' && buf[6] == 'e')
-                 || (buf[3] == '-'))
+            else if((length >= 7 && memcmp(&pHead[3], "Name", 4) == 0)
+                 || (length >= 4 && pHead[3] == '-'))
             {
                 continue;
             }
@@ -260,7 +750,7 @@ bool AsmParser::Parse()
                         structDef.Members.shrink_to_fit();
                         structInfo = false;
 
-                        m_Reflection.AddStructure(structDef);
+                        reflection.AddStructure(structDef);
 
                         continue;
                     }
@@ -269,7 +759,7 @@ bool AsmParser::Parse()
                     {
                         if (structDef.Name == "" && !structDef.Members.empty())
                         {
-                            m_Reflection.AddUavStructPair(uavName, structDef.Members.front().Type);
+                            reflection.AddUavStructPair(uavName, structDef.Members.front().Type);
                         }
 
                         structDef = a3d::Structure();
@@ -281,7 +771,7 @@ bool AsmParser::Parse()
 
                     // 追加登録.
                     cbDef.Variables.shrink_to_fit();
-                    m_Reflection.AddConstantBuffer(cbDef);
+                    reflection.AddConstantBuffer(cbDef);
                 }
                 else if (StringHelper::Contain(decl, "{") >= 1)
                 {
@@ -299,7 +789,7 @@ bool AsmParser::Parse()
                 {
                     structDef.Name = args[1];
                     structInfo = true;
-                    m_Reflection.AddUavStructPair(uavName, structDef.Name);
+                    reflection.AddUavStructPair(uavName, structDef.Name);
                 }
                 else
                 {
@@ -340,7 +830,7 @@ bool AsmParser::Parse()
                 def.HLSLBind    = item[4];
                 def.Count       = std::stoi(item[5]);
 
-                m_Reflection.AddResource(def);
+                reflection.AddResource(def);
             }
             // 入力定義.
             else if (m_InputSection)
@@ -351,21 +841,7 @@ bool AsmParser::Parse()
                     continue;
                 }
 
-                auto decl = StringHelper::Replace(line, "//", "");
-                auto args = StringHelper::Split(decl, " ");
-                assert(args.size() >= 6);
-
-                a3d::Signature inputDef = {};
-                inputDef.Semantics      = args[0];
-                inputDef.Index          = std::stoi(args[1]);
-                inputDef.Mask           = args[2];
-                inputDef.Register       = std::stoi(args[3]);
-                inputDef.SystemValue    = args[4];
-                inputDef.Format         = args[5];
-                inputDef.Used           = (args.size() == 7) ? args[6] : "";
-                inputDef.VarName        = ToVarName(inputDef.Semantics);
-
-                m_Reflection.AddInputSignature(inputDef);
+                reflection.AddInputSignature(ToSignature(line));
             }
             else if (m_OutputSection)
             {
@@ -375,21 +851,11 @@ bool AsmParser::Parse()
                     continue;
                 }
 
-                auto decl = StringHelper::Replace(line, "//", "");
-                auto args = StringHelper::Split(decl, " ");
-                assert(args.size() >= 6);
-
-                a3d::Signature outputDef = {};
-                outputDef.Semantics      = args[0];
-                outputDef.Index          = std::stoi(args[1]);
-                outputDef.Mask           = args[2];
-                outputDef.Register       = std::stoi(args[3]);
-                outputDef.SystemValue    = args[4];
-                outputDef.Format         = args[5];
-                outputDef.Used           = (args.size() == 7) ? args[6] : "";
-                outputDef.VarName        = ToVarName(outputDef.Semantics);
-
-                m_Reflection.AddOutputSignature(outputDef);
+                reflection.AddOutputSignature(ToSignature(line));
+            }
+            else if (m_PatchConstantSection)
+            {
+                reflection.AddPatchConstantSignature(ToSignature(line));
             }
         }
         else
@@ -397,33 +863,128 @@ bool AsmParser::Parse()
             //break;
             m_InputSection  = false;
             m_OutputSection = false;
+            m_PatchConstantSection = false;
             m_BufferSection = false;
             m_ResourceSection = false;
-            instructionCount++;
         }
     }
+}
 
-    // ファイルを閉じる.
-    file.close();
+//-------------------------------------------------------------------------------------------------
+//      コンパイル済みシェーダ (DXBCコンテナ) を解析します.
+//-------------------------------------------------------------------------------------------------
+bool AsmParser::ParseDxbc()
+{
+    DxbcReader reader;
+    if (!reader.Open(m_pBuffer, m_BufferSize))
+    {
+        ELOG( "Error : Invalid DXBC Container. filename = %s", m_Argument.Input.c_str());
+        return false;
+    }
+
+    // リフレクションはテキストのコメントを経由せずに直接登録する.
+    if (!ReadReflection(reader, m_Reflection))
+    {
+        ELOG( "Error : Invalid Resource Definition. filename = %s", m_Argument.Input.c_str());
+        return false;
+    }
+
+    // 命令列はテキストを経由せずに，トークンから直接デコードする.
+    if (!reader.Decode(m_ShaderProfile, m_OperandText, m_Program))
+    {
+        ELOG( "Error : Shader Code Decode Failed. filename = %s", m_Argument.Input.c_str());
+        return false;
+    }
+
+    if (!ToShaderType(m_ShaderProfile, m_ShaderType))
+    {
+        ELOG( "Error : Unknown Shader Profile. filename = %s, profile = %s", m_Argument.Input.c_str(), m_ShaderProfile.c_str());
+        return false;
+    }
+
+    // プロファイルで使用できない命令はテキストと同じく取り除く.
+    auto shaderModel = m_ShaderProfile[3] - '0';
+    auto stage       = ToStageFlag(m_ShaderType);
+    auto itr = std::remove_if(m_Program.begin(), m_Program.end(), [&](const a3d::Instruction& instruction)
+    {
+        if (a3d::IsSupported(instruction.Opcode, shaderModel, stage))
+        { return false; }
+
+        ELOG( "Warning : Unsupported Instruction. profile = %s, instruction = %s",
+            m_ShaderProfile.c_str(), std::string(a3d::GetOpcodeInfo(instruction.Opcode).Mnemonic).c_str());
+        return true;
+    });
+    m_Program.erase(itr, m_Program.end());
 
     m_Instructions.clear();
-    m_Instructions.reserve(instructionCount);
+    m_Instructions.reserve(m_Program.size());
 
     // 名前解決.
     m_Reflection.Resolve();
 
-    // アセンブリ命令を解析.
-    ParseAsm();
+    // デコード済みの命令を変換.
+    m_pProgramText = m_OperandText.c_str();
+    EmitAsm();
 
     m_Instructions.shrink_to_fit();
 
     return true;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      コンパイル済みシェーダからリフレクションを読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool AsmParser::LoadReflection(const std::string& filename, a3d::Reflection& reflection)
+{
+    MappedFile mappedFile;
+    std::vector<char> buffer;
+
+    const char* pData = nullptr;
+    size_t      size  = 0;
+
+    if (!m_Argument.DisableMapping && mappedFile.Open(filename.c_str()))
+    {
+        pData = mappedFile.GetData();
+        size  = mappedFile.GetSize();
+    }
+    else
+    {
+        FILE* pFile;
+        if (fopen_s(&pFile, filename.c_str(), "rb") != 0)
+        { return false; }
+
+        fseek(pFile, 0, SEEK_END);
+        auto endpos = ftell(pFile);
+        fseek(pFile, 0, SEEK_SET);
+
+        buffer.resize(static_cast<size_t>(std::max(endpos, 0L)));
+        size  = fread(buffer.data(), sizeof(char), buffer.size(), pFile);
+        pData = buffer.data();
+
+        fclose(pFile);
+    }
+
+    DxbcReader reader;
+    if (!reader.Open(pData, size))
+    { return false; }
+
+    return ReadReflection(reader, reflection);
+}
+
 //-------------------------------------------------------------------------------------------------
 //      アセンブリファイルを解析します.
 //-------------------------------------------------------------------------------------------------
-void AsmParser::ParseAsm()
+void AsmParser::ParseAsm(const char* pText, size_t firstLine)
+{
+    // 命令列を全てデコードしてから，まとめてHLSLに変換する.
+    DecodeAsm(pText, firstLine);
+    EmitAsm();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      アセンブリ命令をデコードします.
+//-------------------------------------------------------------------------------------------------
+void AsmParser::DecodeAsm(const char* pText, size_t firstLine)
 {
     /* HLSL Shader Compiler 10.1 を対象としています. */
 
@@ -431,2019 +992,1572 @@ void AsmParser::ParseAsm()
     m_ResourceSection   = false;
     m_InputSection      = false;
     m_OutputSection     = false;
+    m_PatchConstantSection = false;
     m_ShaderType        = SHADER_TYPE_VERTEX;
+    m_pProgramText      = pText;
 
     bool find = false;
 
-    int instructionCount = 0;
+    const a3d::OpcodeSet* pOpcodeSet = nullptr;
 
-    while (!m_Tokenizer.IsEnd())
+    m_Program.clear();
+
+    // 命令は1行に1つなので，行の索引から各行を独立にデコードする (行番号も索引から求まる).
+    for(auto i=firstLine; i<m_LineIndex.GetCount(); ++i)
     {
-        // シェーダプロファイルを取得.
-        if (FindTag("vs"))
-        {
-            m_ShaderProfile = m_Tokenizer.GetAsChar();
-            m_ShaderType    = SHADER_TYPE_VERTEX;
-            find = true;
-        }
-        else if (FindTag("ps"))
-        {
-            m_ShaderProfile = m_Tokenizer.GetAsChar();
-            m_ShaderType    = SHADER_TYPE_PIXEL;
-            find = true;
-        }
-        else if (FindTag("gs"))
-        {
-            m_ShaderProfile = m_Tokenizer.GetAsChar();
-            m_ShaderType    = SHADER_TYPE_GEOMETRY;
-            find = true;
-        }
-        else if (FindTag("ds"))
+        if (m_LineIndex.GetLine(i).Type != LINE_TYPE_INSTRUCTION)
+        { continue; }
+
+        auto text = m_LineIndex.GetText(i);
+        m_Tokenizer.SetBuffer(text.data(), text.size());
+
+        // シェーダプロファイルを取得 ("hs_decls" などを誤認しないように書式も確認する).
+        if (!find)
         {
-            m_ShaderProfile = m_Tokenizer.GetAsChar();
-            m_ShaderType    = SHADER_TYPE_DOMAIN;
-            find = true;
+            if (!IsProfile(m_Tokenizer.GetView()))
+            { /* DO_NOTHING */ }
+            else if (FindTag("vs"))
+            {
+                m_ShaderProfile = m_Tokenizer.GetView();
+                m_ShaderType    = SHADER_TYPE_VERTEX;
+                find = true;
+            }
+            else if (FindTag("ps"))
+            {
+                m_ShaderProfile = m_Tokenizer.GetView();
+                m_ShaderType    = SHADER_TYPE_PIXEL;
+                find = true;
+            }
+            else if (FindTag("gs"))
+            {
+                m_ShaderProfile = m_Tokenizer.GetView();
+                m_ShaderType    = SHADER_TYPE_GEOMETRY;
+                find = true;
+            }
+            else if (FindTag("ds"))
+            {
+                m_ShaderProfile = m_Tokenizer.GetView();
+                m_ShaderType    = SHADER_TYPE_DOMAIN;
+                find = true;
+            }
+            else if (FindTag("hs"))
+            {
+                m_ShaderProfile = m_Tokenizer.GetView();
+                m_ShaderType    = SHADER_TYPE_HULL;
+                find = true;
+            }
+            else if (FindTag("cs"))
+            {
+                m_ShaderProfile = m_Tokenizer.GetView();
+                m_ShaderType    = SHADER_TYPE_COMPUTE;
+                find = true;
+            }
+
+            // プロファイルのシェーダモデルとステージで使用できる命令だけを引き当てる.
+            if (find)
+            { pOpcodeSet = &a3d::GetOpcodeSet(m_ShaderProfile[3] - '0', ToStageFlag(m_ShaderType)); }
+
+            // プロファイルが出るまではコメント行とみなしてすっ飛ばす.
+            continue;
         }
-        else if (FindTag("hs"))
+
+        // ニーモニックから命令を1回で引き当てる.
+        a3d::Modifier modifier = {};
+        auto pInfo = a3d::FindOpcode(*pOpcodeSet, m_Tokenizer.GetView(), modifier);
+        if (pInfo == nullptr)
         {
-            m_ShaderProfile = m_Tokenizer.GetAsChar();
-            m_ShaderType    = SHADER_TYPE_HULL;
-            find = true;
+            // プロファイルで使用できない命令は行ごと読み飛ばす.
+            if (a3d::FindOpcode(m_Tokenizer.GetView(), modifier) != nullptr)
+            {
+                ELOG( "Warning : Unsupported Instruction. profile = %s, instruction = %s",
+                    m_ShaderProfile.c_str(), std::string(m_Tokenizer.GetView()).c_str());
+            }
+            continue;
         }
-        else if (FindTag("cs"))
+
+        ParseModifier(modifier);
+
+        a3d::Instruction instruction = {};
+        instruction.Opcode    = pInfo->Opcode;
+        instruction.Modifiers = modifier;
+        instruction.Line      = static_cast<uint32_t>(i + 1);
+
+        // オペランドは行末まで.
+        auto pHead = m_Tokenizer.GetPtr();
+        auto pTail = m_Tokenizer.GetEnd();
+
+        std::string_view operands[a3d::Instruction::MaxOperand];
+        auto count = a3d::SplitOperands(
+            std::string_view(pHead, size_t(pTail - pHead)),
+            operands,
+            a3d::Instruction::MaxOperand);
+
+        instruction.OperandCount = static_cast<uint32_t>(count);
+        for(auto j=0; j<count; ++j)
         {
-            m_ShaderProfile = m_Tokenizer.GetAsChar();
-            m_ShaderType    = SHADER_TYPE_COMPUTE;
-            find = true;
+            instruction.Operand[j].Offset = static_cast<uint32_t>(operands[j].data() - pText);
+            instruction.Operand[j].Length = static_cast<uint32_t>(operands[j].size());
         }
 
-        // アセンブリ命令を解析.
-        if (find)
-        {
-            if (ParseInstructionSM5())
-            { continue; }
+        m_Program.push_back(instruction);
+    }
+}
 
-            if (ParseInstructionSM4())
-            { continue; }
+//-------------------------------------------------------------------------------------------------
+//      デコード済みの命令からHLSLを出力します.
+//-------------------------------------------------------------------------------------------------
+void AsmParser::EmitAsm()
+{
+    for(auto& instruction : m_Program)
+    {
+        // 各命令はデコード済みのオペランドを先頭から順に取り出して変換する.
+        m_pInstruction = &instruction;
+        m_OperandIndex = 0;
 
-            m_Tokenizer.Next(); // 見つからない場合.
+        auto& info = a3d::GetOpcodeInfo(instruction.Opcode);
+        if (!ParseInstruction(info, instruction.Modifiers))
+        {
+            ELOG( "Warning : Instruction Not Converted. line = %u, instruction = %s",
+                instruction.Line, std::string(info.Mnemonic).c_str());
         }
-        else
-        { m_Tokenizer.Next(); } // プロファイルが出るまではコメント行とみなしてすっ飛ばす.
     }
+
+    m_pInstruction = nullptr;
 }
 
 //-------------------------------------------------------------------------------------------------
-//      Shader Model 4.0 の命令を解析します.
+//      ニーモニックに続く修飾子を解析します.
 //-------------------------------------------------------------------------------------------------
-bool AsmParser::ParseInstructionSM4()
+void AsmParser::ParseModifier(a3d::Modifier& modifier)
 {
-    // MSDN - Shader Model 4 Assembly.
-    // https://msdn.microsoft.com/en-us/library/windows/desktop/bb943998(v=vs.85).aspx 参照.
+    // 括弧はニーモニックの直後に空白を挟まずに続く.
+    // <ex> sample_l_aoffimmi_indexable(-1,0,0)(texture2d)(float,float,float,float)
 
-    bool sat = ContainTag("_sat");
+    // 行の範囲外は読まないように，直後の文字は範囲内に限って調べる.
+    auto isNext = [this](char c)
+    { return !m_Tokenizer.IsEnd() && *m_Tokenizer.GetPtr() == c; };
 
-    if (FindTag("add"))
-    {
-        PushOp2("+", sat);
-    }
-    else if (FindTag("and"))
-    {
-        PushLogicOp("&");
-    }
-    else if (m_Tokenizer.Compare("break"))
-    {
-        PushInstruction("break;\n");
-        m_Indent--;
-        m_Tokenizer.Next();
-    }
-    else if (m_Tokenizer.Compare("breakc_z"))
-    {
-        auto cond = GetOperand();
-        std::string cmd = "if (" + cond + " == 0) { break; }\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("breakc_nz"))
-    {
-        auto cond = GetOperand();
-        std::string cmd = "if (" + cond + " != 0) { break; }\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("call"))
-    {
-        // TODO : Implementation
-        auto tag = m_Tokenizer.NextAsChar();
-        m_Tokenizer.SkipLine();
-    }
-    else if (m_Tokenizer.Compare("callc"))
-    {
-        // TODO : Implementation
-        auto tag = m_Tokenizer.NextAsChar();
-        m_Tokenizer.SkipLine();
-    }
-    else if (FindTag("case"))
-    {
-        std::string val;
-        Get1(val);
-        std::string cmd = "case " + val + ":\n";
-        PushInstruction(cmd);
-        m_Indent++;
-    }
-    else if (FindTag("cut"))
-    {
-        // TODO : Implementation
-        auto tag = m_Tokenizer.NextAsChar();
-        m_Tokenizer.SkipLine();
-    }
-    else if (FindTag("continue"))
-    {
-        PushInstruction("continue;\n");
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("continuec"))
-    {
-        // TODO : Implementation
-        auto tag = m_Tokenizer.NextAsChar();
-        m_Tokenizer.SkipLine();
-    }
-    else if (FindTag("dcl_constantBuffer"))
-    {
-        // TODO : Implementation
-        std::string cb = m_Tokenizer.NextAsChar();
-        std::string pt = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_globalFlags"))
-    {
-        // TODO : Implementation
-        std::string flag = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_immediateConstantBuffer"))
-    {
-        // TODO : Implementation
-        std::string value = m_Tokenizer.NextAsChar();
-        std::string size  = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_indexableTemp"))
-    {
-        std::string reg = m_Tokenizer.NextAsChar();
-        std::string cnt = m_Tokenizer.NextAsChar();
-        std::string cmd = StringHelper::Format("float%s %s;\n", cnt.c_str(), reg.c_str());
-        PushInstruction(cmd);
-    }
-    else if (FindTag("dcl_indexRange"))
-    {
-        // TODO : Implementation
-        std::string maxM = m_Tokenizer.NextAsChar();
-        std::string maxN = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_inputPrimitive"))
-    {
-        // TODO : Implementation
-        std::string type = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_input_sv"))
-    {
-        // TODO : Implementation
-        std::string value    = m_Tokenizer.NextAsChar();
-        std::string sysValue = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_input"))
-    {
-        // TODO : Implementation
-        std::string value = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_maxOutputVertexCount"))
-    {
-        // TODO : Implementation
-        std::string count = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_output_sgv"))
+    // テクセルオフセット.
+    if ((modifier.Flags & a3d::MODIFIER_AOFFIMMI) != 0 && isNext('('))
     {
-        // TODO : Implementation
-        std::string reg      = m_Tokenizer.NextAsChar();
-        std::string sysValue = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_output_siv"))
-    {
-        // TODO : Implementation
-        std::string reg = m_Tokenizer.NextAsChar();
-        std::string sysValue = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_outputTopology"))
-    {
-        // TODO : Implementation
-        std::string type = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_output"))
-    {
-        // TODO : Implementation
-        std::string reg = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_resource"))
-    {
-        // TODO : Implementation
-        std::string reg     = m_Tokenizer.NextAsChar();
-        std::string resType = GetArgs();
-        std::string retType = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_sampler"))
-    {
-        // TODO : Implementation
-        std::string reg  = m_Tokenizer.NextAsChar();
-        std::string mode = m_Tokenizer.NextAsChar();
+        m_Tokenizer.Next(); // "("
         m_Tokenizer.Next();
+        for(auto i=0; i<3 && !m_Tokenizer.IsEnd() && !m_Tokenizer.Compare(")"); ++i)
+        {
+            modifier.Offset[i] = static_cast<int8_t>(m_Tokenizer.GetAsInt());
+            m_Tokenizer.Next();
+        }
+        SkipGroup();
     }
-    else if (FindTag("dcl_temps"))
+
+    if ((modifier.Flags & a3d::MODIFIER_INDEXABLE) != 0)
     {
-        auto count = m_Tokenizer.NextAsInt();
-        char buf[5];
-        for(auto i=0; i<count; ++i)
+        // リソースの次元 (構造化バッファは ", stride=N" が続く).
+        if (isNext('('))
         {
-            sprintf_s(buf, "r%d", i);
-            std::string temp = "float4 " + std::string(buf) + ";\n";
-            PushInstruction(temp);
+            m_Tokenizer.Next(); // "("
+            modifier.Dimension = m_Tokenizer.NextAsView();
+            SkipGroup();
         }
 
-        // 空行を入れる.
-        m_Instructions.push_back("\n");
-    }
-    else if (FindTag("default"))
-    {
-        PushInstruction("default:\n");
-        m_Indent++;
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("deriv_rtx"))
-    {
-        PushCmd2("ddx", sat);
-    }
-    else if (FindTag("deriv_rty"))
-    {
-        PushCmd2("ddy", sat);
-    }
-    else if (FindTag("discard_nz"))
-    {
-        std::string val;
-        Get1(val);
-        std::string cmd = "if (" + val + " != 0 ) { discard; }\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("discard_z"))
-    {
-        std::string val;
-        Get1(val);
-        std::string cmd = "if (" + val + " == 0 ) { discard; }\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("div"))
-    {
-        PushOp2("/", sat);
-    }
-    else if (FindTag("dp2"))
-    {
-        PushDp(2, sat);
-    }
-    else if (FindTag("dp3"))
-    {
-        PushDp(3, sat);
-    }
-    else if (FindTag("dp4"))
-    {
-        PushDp(4, sat);
-    }
-    else if (FindTag("else"))
-    {
-        m_Indent--;
-        PushInstruction("}\n");
-        PushInstruction("else\n");
-        PushInstruction("{\n");
-        m_Indent++;
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("emit"))
-    {
-        // TODO : HLSL Implement.
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("emitThenCut"))
-    {
-        // TODO : HLSL Implement.
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("endif"))
-    {
-        m_Indent--;
-        PushInstruction("}\n");
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("endloop"))
-    {
-        m_Indent--;
-        PushInstruction("}\n");
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("endswitch"))
-    {
-        m_Indent--;
-        PushInstruction("}\n");
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("eq"))
-    {
-        PushCmp("==", false);
-    }
-    else if (FindTag("exp"))
-    {
-        PushCmd2("exp", sat);
-    }
-    else if (FindTag("frc"))
-    {
-        PushCmd2("frac", sat);
-    }
-    else if (FindTag("ftoi"))
-    {
-        PushConvFromFloat("asint", sat);
-    }
-    else if (FindTag("ftou"))
-    {
-        PushConvFromFloat("asuint", sat);
-    }
-    else if (FindTag("ge"))
-    {
-        PushCmp(">=", false);
-    }
-    else if (FindTag("iadd"))
-    {
-        PushOp2("+", sat);
-    }
-    else if (FindTag("ieq"))
-    {
-        PushCmp("==", true);
-    }
-    else if (FindTag("if_z"))
-    {
-        std::string val;
-        Get1(val);
-        std::string cmd = "if (" + FilterSat( val, sat ) + ")\n";
-        PushInstruction(cmd);
-        PushInstruction("{\n");
-        m_Indent++;
-    }
-    else if (FindTag("if_nz"))
-    {
-        std::string val;
-        Get1(val);
-        std::string cmd = "if (" + FilterSat( val, sat ) + " != 0)\n";
-        PushInstruction(cmd);
-        PushInstruction("{\n");
-        m_Indent++;
-    }
-    else if (FindTag("ige"))
-    {
-        PushCmp(">=", true);
-    }
-    else if (m_Tokenizer.Compare("ilt"))
-    {
-        PushCmp("<", true);
-    }
-    else if (FindTag("imad"))
-    {
-        PushOp3("*", "+", sat);
+        // 戻り値型.
+        if (isNext('('))
+        {
+            m_Tokenizer.Next(); // "("
+            modifier.ReturnType = m_Tokenizer.NextAsView();
+            SkipGroup();
+        }
     }
-    else if (FindTag("imin"))
+
+    // 括弧の後に続く修飾子 <ex> resinfo_indexable(texture2d)(float,float,float,float)_uint
+    while (isNext('_'))
+    { modifier.Flags |= a3d::FindModifier(m_Tokenizer.NextAsView()); }
+
+    // 精度修飾子 <ex> mad [precise(x)] r0.x, ...
+    auto ptr = m_Tokenizer.GetPtr();
+    auto end = m_Tokenizer.GetEnd();
+    while (ptr < end && (*ptr == ' ' || *ptr == '\t'))
+    { ptr++; }
+
+    if (end - ptr >= 8 && strncmp(ptr, "[precise", 8) == 0)
     {
-        PushCmd3("min", sat);
+        modifier.Flags |= a3d::MODIFIER_PRECISE;
+        do
+        { m_Tokenizer.Next(); }
+        while (!m_Tokenizer.IsEnd() && m_Tokenizer.GetView().find(']') == std::string_view::npos);
     }
-    else if (FindTag("imul"))
+}
+
+//-------------------------------------------------------------------------------------------------
+//      閉じ括弧までトークンを読み飛ばします.
+//-------------------------------------------------------------------------------------------------
+void AsmParser::SkipGroup()
+{
+    while (!m_Tokenizer.IsEnd() && !m_Tokenizer.Compare(")"))
+    { m_Tokenizer.Next(); }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      命令を解析します.
+//-------------------------------------------------------------------------------------------------
+bool AsmParser::ParseInstruction(const a3d::OpcodeInfo& info, const a3d::Modifier& modifier)
+{
+    // 出力パターンが決まっている命令は命令表の記述から生成する.
+    auto saturate = ((modifier.Flags & a3d::MODIFIER_SATURATE) != 0)
+                 && ((info.Flags & a3d::OPCODE_FLAG_SATURATE) != 0);
+
+    switch(info.Emit)
     {
-        std::string dstHi;
-        std::string dstLo;
-        std::string lhs;
-        std::string rhs;
-        Get4(dstHi, dstLo, lhs, rhs);
+    case a3d::EMIT_FUNCTION:
+        {
+            if (info.SrcCount == 1)
+            { PushCmd<1>(info.Symbol, saturate); }
+            else if (info.SrcCount == 2)
+            { PushCmd<2>(info.Symbol, saturate); }
+            else
+            { PushCmd<3>(info.Symbol, saturate); }
+        }
+        break;
 
-        if (dstLo == "null")
+    case a3d::EMIT_BINARY:
         {
-            std::string cmd = dstHi + " = " + lhs + " * " + rhs + ";\n";
-            PushInstruction(cmd);
+            PushOp2(std::string(info.Symbol), saturate);
         }
-        else
+        break;
+
+    case a3d::EMIT_MULTIPLY_ADD:
         {
-            std::string cmd = dstLo + " = " + lhs + " * " + rhs + ";\n";
-            PushInstruction(cmd);
+            PushOp3(std::string(info.Symbol), std::string(info.Symbol2), saturate);
         }
-    }
-    else if (m_Tokenizer.Compare("ine"))
-    {
-        PushCmp("!=", true);
-    }
-    else if (m_Tokenizer.Compare("ineg"))
-    {
-        std::string dst, src;
-        Get2(dst, src);
+        break;
 
-        std::string cmd = dst + " = " + "~" + src + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("ishl"))
-    {
-        PushShiftOp("<<");
-    }
-    else if (FindTag("ishr"))
-    {
-        PushShiftOp(">>");
-    }
-    else if (FindTag("itof"))
-    {
-        PushConvToFloat("asfloat", sat);
-    }
-    else if (FindTag("label"))
-    {
-        // TODO : Implementation
-        std::string tag = m_Tokenizer.NextAsChar();
-    }
-    else if (m_Tokenizer.Compare("ld"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string texcoord;
-        GetLoad(dest, texture, texcoord);
-        std::string cmd = dest + " = " + texture + ".Load(" + texcoord + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("ld_aoffimmi"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string texcoord;
-        std::string offset;
-        GetLoadOffset(dest, texture, texcoord, offset);
-        std::string cmd = dest + " = " + texture + ".Load(" + texcoord + ", " + offset + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("log"))
-    {
-        PushCmd2("log", sat);
-    }
-    else if (FindTag("loop"))
-    {
-        PushInstruction("while(1)\n");
-        PushInstruction("{\n");
-        m_Indent++;
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("lt"))
-    {
-        PushCmp("<", false);
-    }
-    else if (FindTag("mad"))
-    {
-        PushCmd4("mad", sat);
-    }
-    else if (FindTag("max"))
-    {
-        PushCmd3("max", sat);
-    }
-    else if (FindTag("min"))
-    {
-        PushCmd3("min", sat);
-    }
-    else if (m_Tokenizer.Compare("mov"))
-    {
-        PushMov(sat);
-    }
-    else if (m_Tokenizer.Compare("movc"))
-    {
-        PushMovc(sat);
-    }
-    else if (FindTag("mul"))
-    {
-        PushOp2("*", sat);
-    }
-    else if (FindTag("ne"))
-    {
-        PushCmp("!=", false);
-    }
-    else if (FindTag("nop"))
-    {
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("not"))
-    {
-        PushCmd2("not", sat);
-    }
-    else if (FindTag("or"))
-    {
-        PushLogicOp("|");
-    }
-    else if (FindTag("resinfo")) // resinfo_uint, resinfo_rcpFloat 共通.
-    {
-        std::string dest;
-        std::string texture;
-        std::string mipLevel;
-        GetResInfo(dest, texture, mipLevel);
+    case a3d::EMIT_COMPARE:
+        {
+            PushCmp(std::string(info.Symbol), info.DataType != a3d::DATA_TYPE_FLOAT);
+        }
+        break;
 
-        std::string cmd = dest + " = " + "GetResourceInfo(" + texture + ", " + mipLevel + ");\n";
-        PushInstruction(cmd);
+    case a3d::EMIT_LOGIC:
+        {
+            PushLogicOp(std::string(info.Symbol));
+        }
+        break;
 
-        m_HasGetResourceInfo = true;
-    }
-    else if (m_Tokenizer.Compare("retc_z"))
-    {
-        std::string op = GetOperand();
-        std::string cmd = "if (" + op + ") return;\n";
-        PushInstruction(cmd);
-        m_Indent++;
-    }
-    else if (m_Tokenizer.Compare("retc_nz"))
-    {
-        std::string op = GetOperand();
-        std::string cmd = "if (!" + op + ") return;\n";
-        PushInstruction(cmd);
-        m_Indent++;
-    }
-    else if (m_Tokenizer.Compare("ret"))
-    {
-        m_Tokenizer.Next();
-    }
-    else if (FindTag("round_ne"))
-    {
-        PushCmd2("round", sat);
-    }
-    else if (FindTag("round_ni"))
-    {
-        PushCmd2("floor", sat);
-    }
-    else if (FindTag("round_pi"))
-    {
-        PushCmd2("ceil", sat);
-    }
-    else if (FindTag("round_z"))
-    {
-        PushCmd2("frac", sat);
-    }
-    else if (FindTag("rsq"))
-    {
-        PushCmd2("rsqrt", sat);
-    }
-    else if (m_Tokenizer.Compare("sample"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        GetSample0(dest, texture, sampler, texcoord);
+    case a3d::EMIT_CONVERT_FROM_FLOAT:
+        {
+            PushConvFromFloat(std::string(info.Symbol), saturate);
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + ".Sample(" + sampler + ", " + texcoord + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_aoffimmi"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        GetSampleOffset0(dest, texture, sampler, texcoord, offset);
+    case a3d::EMIT_CONVERT_TO_FLOAT:
+        {
+            PushConvToFloat(std::string(info.Symbol), saturate);
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + ".Sample(" + sampler + ", " + texcoord + ", " + offset + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_b"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string lodBias;
-        GetSample1( dest, texture, sampler, texcoord, lodBias);
+    case a3d::EMIT_DOT:
+        {
+            PushDp(info.Width, saturate);
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + "SampleBias(" + sampler + "," + texcoord + ", " + lodBias + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_b_aoffimmi"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string lodBias;
-        GetSampleOffset1( dest, texture, sampler, texcoord, offset, lodBias );
+    case a3d::EMIT_MOVE:
+        {
+            PushMov(saturate);
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + ".SampleBias(" + sampler + ", " + texcoord + ", " + lodBias + ", " + offset + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_c"))
-    {
-        std::string dst;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string refValue;
-        GetSample1(dst, texture, sampler, texcoord, refValue);
+    case a3d::EMIT_SELECT:
+        {
+            PushMovc(saturate);
+        }
+        break;
 
-        std::string cmd = dst + " = " + texture + ".SampleCmp(" + sampler + ", " + texcoord + ", " + refValue + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_c_aoffimmi"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string refValue;
-        GetSampleOffset1(dest, texture, sampler, texcoord, offset, refValue);
+    case a3d::EMIT_SAMPLE:
+        {
+            PushSample(info, modifier, saturate);
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + ".SampleCmp(" + sampler + ", " + texcoord + ", " + refValue + ", " + offset + ");\n";
-        PushInstruction(cmd);
+    default:
+        {
+            // 個別に解析する.
+            return (info.ShaderModel >= 5)
+                ? ParseInstructionSM5(info.Opcode, modifier)
+                : ParseInstructionSM4(info.Opcode, modifier);
+        }
     }
-    else if (m_Tokenizer.Compare("sample_c_lz"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string refValue;
-        GetSample1( dest, texture, sampler, texcoord, refValue );
 
-        std::string cmd = dest + " = " + texture + ".SampleCmpLevelZero(" + sampler + ", " + texcoord + ", "  + refValue + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_c_lz_aoffimmi"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string refValue;
-        GetSampleOffset1( dest, texture, sampler, texcoord, offset, refValue );
+    return true;
+}
 
-        std::string cmd = dest + " = " + texture + ".SampleCmpLevelZero(" + sampler + ", " + texcoord + ", " + refValue + ", " + offset + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_d"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string xDerivative;
-        std::string yDerivative;
-        GetSample2( dest, texture, sampler, texcoord, xDerivative, yDerivative );
+//-------------------------------------------------------------------------------------------------
+//      Shader Model 4.0 の命令を解析します.
+//-------------------------------------------------------------------------------------------------
+bool AsmParser::ParseInstructionSM4(a3d::OPCODE_TYPE opcode, const a3d::Modifier& modifier)
+{
+    // MSDN - Shader Model 4 Assembly.
+    // https://msdn.microsoft.com/en-us/library/windows/desktop/bb943998(v=vs.85).aspx 参照.
 
-        std::string left = texture + ".SampleGrad(" + sampler + ", " + texcoord + ", " + xDerivative + ", " + yDerivative + ")";
-        std::string cmd = dest + " = " + FilterSat( left, sat ) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if(m_Tokenizer.Compare("sample_d_aoffimmi"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string xDerivative;
-        std::string yDerivative;
-        GetSampleOffset2(dest, texture, sampler, texcoord, offset, xDerivative, yDerivative);
+    auto sat = (modifier.Flags & a3d::MODIFIER_SATURATE) != 0;
 
-        std::string left = texture + ".SampleGrad(" + sampler + ", " + texcoord + ", " + xDerivative + ", " + yDerivative + ", " + offset + ")";
-        std::string cmd  = dest + " = " + FilterSat( left, sat ) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_l"))
+    switch(opcode)
     {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string lod;
-        GetSample1(dest, texture, sampler, texcoord, lod);
+    case a3d::OPCODE_BREAK:
+        {
+            PushInstruction("break;\n");
+            m_Indent--;
+        }
+        break;
 
-        std::string left = texture + ".SampleLevel(" + sampler + ", " + texcoord + ", " + lod + ")";
-        std::string cmd  = dest + " = " + FilterSat( left, sat ) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_l_aoffimmi"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string lod;
-        GetSampleOffset1( dest, texture, sampler, texcoord, offset, lod );
+    case a3d::OPCODE_BREAKC:
+        {
+            auto cond = GetOperand();
+            std::string cmd = "if (" + cond + ToTestString(modifier) + ") { break; }\n";
+            PushInstruction(cmd);
+        }
+        break;
 
-        std::string left = texture + ".SampleLevel(" + sampler + ", " + texcoord + ", " + lod + ", " + offset + ")";
-        std::string cmd  = dest + " = " + FilterSat( left, sat ) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("sincos"))
-    {
-        std::string dstSin = m_Tokenizer.NextAsChar();
-        std::string dstCos = m_Tokenizer.NextAsChar();
-        std::string src    = GetOperand();
+    case a3d::OPCODE_CALL:
+        {
+            // TODO : Implementation
+            auto tag = NextOperand();
+        }
+        break;
 
-        auto sinInfo = a3d::Reflection::ToSwizzleInfo(dstSin);
-        auto cosInfo = a3d::Reflection::ToSwizzleInfo(dstCos);
+    case a3d::OPCODE_CALLC:
+        {
+            // TODO : Implementation
+            auto tag = NextOperand();
+        }
+        break;
 
-        dstSin = StringHelper::GetWithSwizzle(dstSin);
-        dstCos = StringHelper::GetWithSwizzle(dstCos);
-        
-        std::string srcSin = m_Reflection.GetCastedString(src, sinInfo);
-        std::string srcCos = m_Reflection.GetCastedString(src, cosInfo);
+    case a3d::OPCODE_CASE:
+        {
+            std::string val;
+            Get1(val);
+            std::string cmd = "case " + val + ":\n";
+            PushInstruction(cmd);
+            m_Indent++;
+        }
+        break;
 
-        std::string left1 = "sin(" + srcSin + ")";
-        std::string left2 = "cos(" + srcCos + ")";
+    case a3d::OPCODE_CUT:
+        {
+            // TODO : Implementation
+            auto tag = NextOperand();
+        }
+        break;
 
-        std::string cmd1, cmd2;
-        if (dstSin != "null")
+    case a3d::OPCODE_CONTINUE:
         {
-            cmd1 = dstSin + " = " + FilterSat( left1, sat ) + ";\n";
-            PushInstruction(cmd1);
+            PushInstruction("continue;\n");
         }
-        if (dstCos != "null")
-        { 
-            cmd2 = dstCos + " = " + FilterSat( left2, sat ) + ";\n";
-            PushInstruction(cmd2);
+        break;
+
+    case a3d::OPCODE_CONTINUEC:
+        {
+            // TODO : Implementation
+            auto tag = NextOperand();
         }
-    }
-    else if (FindTag("sqrt"))
-    {
-        PushCmd2("sqrt", sat);
-    }
-    else if (m_Tokenizer.Compare("switch"))
-    {
-        std::string val = m_Tokenizer.NextAsChar();
-        std::string cmd = "switch(" + val + ") {\n";
-        PushInstruction(cmd);
-        m_Indent++;
-    }
-    else if (FindTag("udiv"))
-    {
-        std::string dstQUOT, dstREM, lhs, rhs;
-        Get4(dstQUOT, dstREM, lhs, rhs);
+        break;
 
-        if (dstREM != "null")
+    case a3d::OPCODE_DCL_CONSTANT_BUFFER:
         {
-            std::string cmd = dstREM + " = " + lhs + " % " + rhs + ";\n";
-            PushInstruction(cmd);
+            // TODO : Implementation
+            std::string cb(NextOperand());
+            std::string pt(NextOperand());
         }
-        if (dstQUOT != "null")
+        break;
+
+    case a3d::OPCODE_DCL_GLOBAL_FLAGS:
         {
-            std::string cmd = dstQUOT + " = " + lhs + " / " + rhs + ";\n";
-            PushInstruction(cmd);
+            // TODO : Implementation
+            std::string flag(NextOperand());
         }
-    }
-    else if (FindTag("uge"))
-    {
-        PushCmp(">=", true);
-    }
-    else if (FindTag("ult"))
-    {
-        PushCmp("<", true);
-    }
-    else if (FindTag("umad"))
-    {
-        PushOp3("*", "+", sat);
-    }
-    else if (FindTag("umax"))
-    {
-        PushCmd3("max", sat);
-    }
-    else if (FindTag("umin"))
-    {
-        PushCmd3("min", sat);
-    }
-    else if (FindTag("umul"))
-    {
-        PushOp2("*", sat);
-    }
-    else if (FindTag("ushr"))
-    {   
-        PushShiftOp(">>");
-    }
-    else if (FindTag("utof"))
-    {
-        PushConvToFloat("asfloat", sat);
-    }
-    else if (FindTag("xor"))
-    {
-        PushLogicOp("^");
-    }
-    else
-    {
-        return false;
-    }
+        break;
 
-    return true;
-}
+    case a3d::OPCODE_DCL_IMMEDIATE_CONSTANT_BUFFER:
+        {
+            // TODO : Implementation
+            std::string value(NextOperand());
+            std::string size (NextOperand());
+        }
+        break;
 
-//-------------------------------------------------------------------------------------------------
-//      Shader Model 5.0 の命令を解析します.
-//-------------------------------------------------------------------------------------------------
-bool AsmParser::ParseInstructionSM5()
-{
-    // MSDN - Shader Model 5 Assembly.
-    // https://learn.microsoft.com/en-us/windows/win32/direct3dhlsl/shader-model-5-assembly--directx-hlsl- 参照.
+    case a3d::OPCODE_DCL_INDEXABLE_TEMP:
+        {
+            std::string reg(NextOperand());
+            std::string cnt(NextOperand());
+            std::string cmd = StringHelper::Format("float%s %s;\n", cnt.c_str(), reg.c_str());
+            PushInstruction(cmd);
+        }
+        break;
 
-    bool sat = ContainTag("_sat");
+    case a3d::OPCODE_DCL_INDEX_RANGE:
+        {
+            // TODO : Implementation
+            std::string maxM(NextOperand());
+            std::string maxN(NextOperand());
+        }
+        break;
 
-    if (FindTag("atomic_and"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        Get3(dst, dstAddress, src0);
+    case a3d::OPCODE_DCL_INPUT:
+        {
+            auto reg = NextOperand();
+            if (reg == "vForkInstanceID")
+            {
+                // TODO : Implement.
+            }
+            else if (reg == "vGSInstanceID")
+            {
+                auto instanceCount = NextOperand();
 
-        std::string cmd = std::string("InterlockedAnd(") + dst + ", " + src0 + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("atomic_cmp_store"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        std::string src1;
-        Get4(dst, dstAddress, src0, src1);
+                std::string cmd = "uint gsInstanceId : SV_InstanceID";
+                m_Reflection.AddInputArgs(cmd);
+            }
+            else if (reg == "vJoinInstanceID")
+            {
+                // TODO : Implement.
+            }
+            else if (reg == "vOutputControlPointID")
+            {
+                std::string cmd = "uint controlPointId : SV_OutputControlPointID";
+                m_Reflection.AddInputArgs(cmd);
+            }
+            else if (StartsWith(reg, "vThreadID"))
+            {
+                std::string id(reg);
+                auto info = a3d::Reflection::ToSwizzleInfo(id);
 
-        // TODO : Implement.
-    }
-    else if (FindTag("atomic_iadd"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        Get3(dst, dstAddress, src0);
+                std::string cmd = StringHelper::Format("uint%d dispatchId : SV_DispatchThreadID", info.Count);
+                m_Reflection.AddInputArgs(cmd);
+            }
+            else if (StartsWith(reg, "vThreadGroupID"))
+            {
+                std::string id(reg);
+                auto info = a3d::Reflection::ToSwizzleInfo(id);
 
-        std::string cmd = std::string("InterlockedAdd(") + dst + ", " + src0 + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("atomic_imax"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        Get3(dst, dstAddress, src0);
+                std::string cmd = StringHelper::Format("uint%d groupId : SV_GroupID", info.Count);
+                m_Reflection.AddInputArgs(cmd);
+            }
+            else if (StartsWith(reg, "vThreadIDInGroup"))
+            {
+                std::string id(reg);
+                auto info = a3d::Reflection::ToSwizzleInfo(id);
 
-        std::string cmd = std::string("InterlockedMax(") + dst + ", " + src0 + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("atomic_imin"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        Get3(dst, dstAddress, src0);
+                std::string cmd = StringHelper::Format("uint%d groupThreadId : SV_GroupThreadID", info.Count);
+                m_Reflection.AddInputArgs(cmd);
+            }
+            else if (StartsWith(reg, "vThreadIDInGroupFlattened"))
+            {
+                std::string id(reg);
+                auto info = a3d::Reflection::ToSwizzleInfo(id);
 
-        std::string cmd = std::string("InterlockedMin(") + dst + ", " + src0 + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("atomic_or"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        Get3(dst, dstAddress, src0);
+                std::string cmd = StringHelper::Format("uint%d groupIndex : SV_GroupIndex", info.Count);
+                m_Reflection.AddInputArgs(cmd);
+            }
+        }
+        break;
 
-        std::string cmd = std::string("InterlockedOr(") + dst + ", " + src0 + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("atomic_umax"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        Get3(dst, dstAddress, src0);
+    case a3d::OPCODE_DCL_INPUT_PRIMITIVE:
+        {
+            // TODO : Implementation
+            std::string type(NextOperand());
+        }
+        break;
 
-        std::string cmd = std::string("InterlockedMax(") + dst + ", " + src0 + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("atomic_umin"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        Get3(dst, dstAddress, src0);
+    case a3d::OPCODE_DCL_INPUT_SV:
+        {
+            // TODO : Implementation
+            std::string value   (NextOperand());
+            std::string sysValue(NextOperand());
+        }
+        break;
 
-        std::string cmd = std::string("InterlockedMin(") + dst + ", " + src0 + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("atomic_xor"))
-    {
-        std::string dst;
-        std::string dstAddress;
-        std::string src0;
-        Get3(dst, dstAddress, src0);
+    case a3d::OPCODE_DCL_MAX_OUTPUT_VERTEX_COUNT:
+        {
+            // TODO : Implementation
+            std::string count(NextOperand());
+        }
+        break;
 
-        std::string cmd = std::string("InterlockedXor(") + dst + ", " + src0 + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("bfi"))
-    {
-        std::string dst;
-        std::string src0;
-        std::string src1;
-        std::string src2;
-        std::string src3;
-        Get5(dst, src0, src1, src2, src3);
+    case a3d::OPCODE_DCL_OUTPUT:
+        {
+            auto mask = GetOperand();
 
-        // TODO : Implement.
-    }
-    else if (FindTag("bfrev"))
-    {
-        PushCmd2("reversebits", sat);
-    }
-    else if (FindTag("bufinfo"))
-    {
-        std::string dst;
-        std::string srcResource;
-        Get2(dst, srcResource);
+            // TODO : Implement.
+        }
+        break;
 
-        std::string cmd = srcResource + ".GetDimensions(" + dst + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("countbits"))
-    {
-        PushCmd2("countbits", sat);
-    }
-    else if (FindTag("cut_stream"))
-    {
-        std::string streamIndex = GetOperand();
+    case a3d::OPCODE_DCL_OUTPUT_SGV:
+        {
+            // TODO : Implementation
+            std::string reg     (NextOperand());
+            std::string sysValue(NextOperand());
+        }
+        break;
 
-        // TODO : Implement.
-    }
-    else if (FindTag("dadd"))
-    {
-        PushOp2("+", sat);
-    }
-    else if (FindTag("dcl_function_body"))
-    {
-        auto label = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_function_table"))
-    {
-        // TODO : Implement.
-        auto table = GetOperand();
-        while(m_Tokenizer.Compare("}"))
+    case a3d::OPCODE_DCL_OUTPUT_SIV:
         {
-            m_Tokenizer.Next();
+            // TODO : Implementation
+            std::string reg(NextOperand());
+            std::string sysValue(NextOperand());
         }
-    }
-    else if (FindTag("dcl_hs_fork_phase_instance_count"))
-    {
-        // TODO : Implement.
-        while(m_Tokenizer.Compare("}"))
+        break;
+
+    case a3d::OPCODE_DCL_OUTPUT_TOPOLOGY:
         {
-            m_Tokenizer.Next();
+            // TODO : Implementation
+            std::string type(NextOperand());
         }
-    }
-    else if (FindTag("dcl_hs_join_phase_instance_count"))
-    {
-        // TODO : Implement.
-        while(m_Tokenizer.Compare("}"))
+        break;
+
+    case a3d::OPCODE_DCL_RESOURCE:
         {
-            m_Tokenizer.Next();
+            // TODO : Implementation
+            std::string reg(NextOperand()); // (type,type,type,type) t#
         }
-    }
-    else if (FindTag("dcl_hs_max_tessfactor"))
-    {
-        // TODO : Implement.
-        auto count = m_Tokenizer.NextAsChar();
-    }
-    else if (FindTag("dcl_input"))
-    {
-        m_Tokenizer.Next();
-        if (m_Tokenizer.Compare("vForkInstanceID"))
+        break;
+
+    case a3d::OPCODE_DCL_RESOURCE_RAW:
         {
+            auto uav = GetOperand();
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("vGSInstanceID"))
+        break;
+
+    case a3d::OPCODE_DCL_RESOURCE_STRUCTURED:
         {
-            auto instanceCount = m_Tokenizer.NextAsChar();
+            auto uav = GetOperand();
+            auto stride = GetOperand();
+            // TODO : Implement.
+        }
+        break;
 
-            std::string cmd = "uint gsInstanceId : SV_InstanceID";
-            m_Reflection.AddInputArgs(cmd);
+    case a3d::OPCODE_DCL_SAMPLER:
+        {
+            // TODO : Implementation
+            std::string reg (NextOperand());
+            std::string mode(NextOperand());
         }
-        else if (m_Tokenizer.Compare("vJoinInstanceID"))
+        break;
+
+    case a3d::OPCODE_DCL_TEMPS:
         {
+            auto count = ToInt(NextOperand());
+            char buf[5];
+            for(auto i=0; i<count; ++i)
+            {
+                sprintf_s(buf, "r%d", i);
+                std::string temp = "float4 " + std::string(buf) + ";\n";
+                PushInstruction(temp);
+            }
+
+            // 空行を入れる.
+            m_Instructions.push_back("\n");
+        }
+        break;
+
+    case a3d::OPCODE_DCL_TGSM_RAW:
+        {
+            auto group     = NextOperand();
+            auto byteCount = NextOperand();
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("vOutputControlPointID"))
+        break;
+
+    case a3d::OPCODE_DCL_TGSM_STRUCTURED:
         {
-            std::string cmd = "uint controlPointId : SV_OutputControlPointID";
-            m_Reflection.AddInputArgs(cmd);
+            auto group  = NextOperand();
+            auto stride = NextOperand();
+            auto count  = NextOperand();
+            // TODO : Implement.
         }
-        else if (FindTag("vThreadID"))
+        break;
+
+    case a3d::OPCODE_DCL_THREAD_GROUP:
         {
-            std::string id = m_Tokenizer.GetAsChar();
-            auto info = a3d::Reflection::ToSwizzleInfo(id);
+            auto x = ToInt(NextOperand());
+            auto y = ToInt(NextOperand());
+            auto z = ToInt(NextOperand());
 
-            std::string cmd = StringHelper::Format("uint%d dispatchId : SV_DispatchThreadID", info.Count);
-            m_Reflection.AddInputArgs(cmd);
+            m_ThreadCountX = uint32_t(x);
+            m_ThreadCountY = uint32_t(y);
+            m_ThreadCountZ = uint32_t(z);
         }
-        else if (FindTag("vThreadGroupID"))
+        break;
+
+    case a3d::OPCODE_DCL_UAV_RAW:
         {
-            std::string id = m_Tokenizer.GetAsChar();
-            auto info = a3d::Reflection::ToSwizzleInfo(id);
+            auto uav = GetOperand();
+            // TODO : Implement.
+        }
+        break;
 
-            std::string cmd = StringHelper::Format("uint%d groupId : SV_GroupID", info.Count);
-            m_Reflection.AddInputArgs(cmd);
+    case a3d::OPCODE_DCL_UAV_STRUCTURED:
+        {
+            auto uav = GetOperand();
+            auto stride = NextOperand();
+            // TODO : Implement.
         }
-        else if (FindTag("vThreadIDInGroup"))
+        break;
+
+    case a3d::OPCODE_DEFAULT:
         {
-            std::string id = m_Tokenizer.GetAsChar();
-            auto info = a3d::Reflection::ToSwizzleInfo(id);
+            PushInstruction("default:\n");
+            m_Indent++;
+        }
+        break;
 
-            std::string cmd = StringHelper::Format("uint%d groupThreadId : SV_GroupThreadID", info.Count);
-            m_Reflection.AddInputArgs(cmd);
+    case a3d::OPCODE_DISCARD:
+        {
+            std::string val;
+            Get1(val);
+            std::string cmd = "if (" + val + ToTestString(modifier) + " ) { discard; }\n";
+            PushInstruction(cmd);
         }
-        else if (FindTag("vThreadIDInGroupFlattened"))
+        break;
+
+    case a3d::OPCODE_ELSE:
         {
-            std::string id = m_Tokenizer.GetAsChar();
-            auto info = a3d::Reflection::ToSwizzleInfo(id);
+            m_Indent--;
+            PushInstruction("}\n");
+            PushInstruction("else\n");
+            PushInstruction("{\n");
+            m_Indent++;
+        }
+        break;
 
-            std::string cmd = StringHelper::Format("uint%d groupIndex : SV_GroupIndex", info.Count);
-            m_Reflection.AddInputArgs(cmd);
+    case a3d::OPCODE_EMIT:
+        {
+            // TODO : HLSL Implement.
         }
-    }
-    else if (FindTag("dcl_input_control_point_count"))
-    {
-        // TODO : Implement.
-        while(m_Tokenizer.Compare("}"))
+        break;
+
+    case a3d::OPCODE_EMIT_THEN_CUT:
         {
-            m_Tokenizer.Next();
+            // TODO : HLSL Implement.
         }
-    }
-    else if (FindTag("dcl_interface"))
-    {
-        // TODO : Implement.
-        auto fp = GetOperand();
-        m_Tokenizer.Next(); // =
-        while(m_Tokenizer.Compare("}"))
+        break;
+
+    case a3d::OPCODE_ENDIF:
         {
-            m_Tokenizer.Next();
+            m_Indent--;
+            PushInstruction("}\n");
         }
-    }
-    else if (FindTag("dcl_interface_dynamicindexed"))
-    {
-        // TODO : Implement.
-        auto fp = GetOperand();
-        m_Tokenizer.Next(); // =
-        while(m_Tokenizer.Compare("}"))
+        break;
+
+    case a3d::OPCODE_ENDLOOP:
         {
-            m_Tokenizer.Next();
+            m_Indent--;
+            PushInstruction("}\n");
         }
-    }
-    else if (FindTag("dcl_output"))
-    {
-        auto mask = GetOperand();
+        break;
 
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_output_control_point_count"))
-    {
-        auto count = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_resource_raw"))
-    {
-        auto uav = GetOperand();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_resource_structured"))
-    {
-        auto uav = GetOperand();
-        auto stride = GetOperand();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_stream"))
-    {
-        auto count = m_Tokenizer.NextAsChar(); // m0, m1, m2, m3.
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_tessellator_domain"))
-    {
-        auto domain = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_tessellator_output_primitive"))
-    {
-        auto primitive = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_tessellator_partitioning"))
-    {
-        auto partition = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_tgsm_raw"))
-    {
-        auto group     = m_Tokenizer.NextAsChar();
-        auto byteCount = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_tgsm_structured"))
-    {
-        auto group  = m_Tokenizer.NextAsChar();
-        auto stride = m_Tokenizer.NextAsChar();
-        auto count  = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_thread_group"))
-    {
-        auto x = m_Tokenizer.NextAsInt();
-        auto y = m_Tokenizer.NextAsInt();
-        auto z = m_Tokenizer.NextAsInt();
+    case a3d::OPCODE_ENDSWITCH:
+        {
+            m_Indent--;
+            PushInstruction("}\n");
+        }
+        break;
 
-        m_ThreadCountX = uint32_t(x);
-        m_ThreadCountY = uint32_t(y);
-        m_ThreadCountZ = uint32_t(z);
-    }
-    else if (FindTag("dcl_uav_raw"))
-    {
-        auto uav = GetOperand();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_uav_structured"))
-    {
-        auto uav = GetOperand();
-        auto stride = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("dcl_uav_typed"))
-    {
-        auto uav       = GetOperand();
-        auto dimension = m_Tokenizer.NextAsChar();
-        auto type      = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("ddiv"))
-    {
-        PushOp2("/", sat);
-    }
-    else if (FindTag("deq"))
-    {
-        PushOp2("==", sat);
-    }
-    else if (FindTag("deriv_rtx_coarse"))
-    {
-        PushCmd2("ddx_coarse", sat);
-    }
-    else if (FindTag("deriv_rtx_fine"))
-    {
-        PushCmd2("ddx_fine", sat);
-    }
-    else if (FindTag("deriv_rty_coarse"))
-    {
-        PushCmd2("ddy_coarse", sat);
-    }
-    else if (FindTag("deriv_rty_fine"))
-    {
-        PushCmd2("ddy_fine", sat);
-    }
-    else if (FindTag("dfma"))
-    {
-        PushCmd4("fma", sat);
-    }
-    else if (FindTag("dge"))
-    {
-        PushOp2(">=", sat);
-    }
-    else if (FindTag("dlt"))
-    {
-        PushOp2("<", sat);
-    }
-    else if (FindTag("dmax"))
-    {
-        PushCmd2("max", sat);
-    }
-    else if (FindTag("dmin"))
-    {
-        PushCmd2("min", sat);
-    }
-    else if (FindTag("dmov"))
-    {
-        PushMov(sat);
-    }
-    else if (FindTag("dmovc"))
-    {
-        PushMovc(sat);
-    }
-    else if (FindTag("dmul"))
-    {
-        PushOp2("*", sat);
-    }
-    else if (FindTag("dne"))
-    {
-        PushOp2("!=", sat);
-    }
-    else if (FindTag("drcp"))
-    {
-        PushCmd2("rcp", sat);
-    }
-    else if (FindTag("dtof"))
-    {
-        PushCmd2("asfloat", sat);
-    }
-    else if (FindTag("emit_stream"))
-    {
-        auto streamIndex = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("emitThenCut_stream"))
-    {
-        auto streamIndex = m_Tokenizer.NextAsChar();
-        // TODO : Implement.
-    }
-    else if (FindTag("f16tof32"))
-    {
-        PushCmd2("f16tof32", sat);
-    }
-    else if (FindTag("f32tof16"))
-    {
-        PushCmd2("f32tof16", sat);
-    }
-    else if (FindTag("fcall"))
-    {
-        auto fp = GetOperand();
-        // TODO : Implement.
-    }
-    else if (FindTag("firstbit"))
-    {
-        if (m_Tokenizer.Compare("firstbit_hi"))
+    case a3d::OPCODE_IF:
         {
-            PushCmd2("firstbithigh", sat);
+            std::string val;
+            Get1(val);
+            std::string cmd = "if (" + FilterSat( val, sat ) + ToTestString(modifier) + ")\n";
+            PushInstruction(cmd);
+            PushInstruction("{\n");
+            m_Indent++;
+        }
+        break;
+
+    case a3d::OPCODE_IMUL:
+        {
+            std::string dstHi;
+            std::string dstLo;
+            std::string lhs;
+            std::string rhs;
+            Get4(dstHi, dstLo, lhs, rhs);
+
+            if (dstLo == "null")
+            {
+                std::string cmd = dstHi + " = " + lhs + " * " + rhs + ";\n";
+                PushInstruction(cmd);
+            }
+            else
+            {
+                std::string cmd = dstLo + " = " + lhs + " * " + rhs + ";\n";
+                PushInstruction(cmd);
+            }
         }
-        else if (m_Tokenizer.Compare("firstbit_lo"))
+        break;
+
+    case a3d::OPCODE_INEG:
         {
-            PushCmd2("firstbitlow", sat);
+            std::string dst, src;
+            Get2(dst, src);
+
+            std::string cmd = dst + " = " + "~" + src + ";\n";
+            PushInstruction(cmd);
         }
-        else if (m_Tokenizer.Compare("fistbit_shi"))
+        break;
+
+    case a3d::OPCODE_LABEL:
         {
-            PushCmd2("firstbithigh", sat);
+            // TODO : Implementation
+            std::string tag(NextOperand());
         }
-    }
-    else if (FindTag("ftod"))
-    {
-        PushCmd2("asdouble", sat);
-    }
-    else if (FindTag("gather4"))
-    {
-        if (m_Tokenizer.Compare("gather4_aoffimmi_indexable"))
+        break;
+
+    case a3d::OPCODE_LD:
         {
             std::string dest;
             std::string texture;
-            std::string sampler;
             std::string texcoord;
-            std::string offset;
-            GetSampleOffsetIndexable0(dest, texture, sampler, texcoord, offset);
+            auto dimension = GetLoad(dest, texture, texcoord);
+
+            std::string args = texcoord;
+            if ((modifier.Flags & a3d::MODIFIER_AOFFIMMI) != 0)
+            { args += ", " + ToOffsetString(modifier, dimension); }
 
-            std::string cmd = dest + " = " + texture + ".Gather(" + sampler + ", " + texcoord + ", " + offset + ");\n";
+            std::string cmd = dest + " = " + texture + ".Load(" + args + ");\n";
             PushInstruction(cmd);
         }
-        else if (m_Tokenizer.Compare("gather4_indexable"))
+        break;
+
+    case a3d::OPCODE_LD_RAW:
         {
-            std::string dest;
-            std::string texcoord;
-            std::string texture;
-            std::string sampler;
-            GetSampleIndexable0(dest, texture, sampler, texcoord);
+            std::string dst0;
+            Get1(dst0);
 
-            std::string left = texture + ".Gather(" + sampler + ", " + texcoord + ")";
-            std::string cmd = dest + " = " + FilterSat(left, sat) + ";\n";
+            auto srcByteOffset = GetOperand();
+            auto src0 = GetOperand();
+
+            // TODO : 実装が怪しいので後でチェック.
+            std::string cmd = dst0 + " = " + src0 + "[" + srcByteOffset + "];\n";
             PushInstruction(cmd);
         }
-    }
-    else if (FindTag("gather4_c"))
-    {
-        if (m_Tokenizer.Compare("gather4_c_aoffimmi_indexable"))
+        break;
+
+    case a3d::OPCODE_LD_STRUCTURED:
+        {
+            std::string dst0;
+            Get1(dst0);
+
+            auto srcAddress    = GetOperand();
+            auto srcByteOffset = GetOperand();
+            auto src0          = GetOperand();
+
+            // TODO : 実装が怪しいので後でチェック.
+            std::string cmd = dst0 + " = " + src0 + "[" + srcAddress + "];\n";
+            PushInstruction(cmd);
+        }
+        break;
+
+    case a3d::OPCODE_LOOP:
+        {
+            PushInstruction("while(1)\n");
+            PushInstruction("{\n");
+            m_Indent++;
+        }
+        break;
+
+    case a3d::OPCODE_NOP:
+        {
+            /* DO_NOTHING */
+        }
+        break;
+
+    case a3d::OPCODE_RESINFO: // resinfo_uint, resinfo_rcpFloat 共通.
         {
             std::string dest;
             std::string texture;
-            std::string sampler;
-            std::string texcoord;
-            std::string offset;
-            std::string refValue;
-            GetSampleOffsetIndexable1(dest, texture, sampler, texcoord, offset, refValue);
+            std::string mipLevel;
+            GetResInfo(dest, texture, mipLevel);
+
+            std::string cmd = dest + " = " + "GetResourceInfo(" + texture + ", " + mipLevel + ");\n";
+            PushInstruction(cmd);
+
+            m_HasGetResourceInfo = true;
+        }
+        break;
 
-            std::string cmd = dest + " = " + texture + ".GatherCmp(" + sampler + ", " + texcoord + ", " + refValue + ", " + offset + ");\n";
+    case a3d::OPCODE_RETC:
+        {
+            std::string op = GetOperand();
+            std::string cmd = "if (" + op + ToTestString(modifier) + ") { return; }\n";
             PushInstruction(cmd);
         }
-        else if (m_Tokenizer.Compare("gather4_c_indexable"))
+        break;
+
+    case a3d::OPCODE_RET:
         {
-            std::string dst;
-            std::string texture;
-            std::string sampler;
-            std::string texcoord;
-            std::string refValue;
-            GetSampleIndexable1(dst, texture, sampler, texcoord, refValue);
+            /* DO_NOTHING */
+        }
+        break;
+
+    case a3d::OPCODE_SINCOS:
+        {
+            std::string dstSin(NextOperand());
+            std::string dstCos(NextOperand());
+            std::string src    = GetOperand();
+
+            auto sinInfo = a3d::Reflection::ToSwizzleInfo(dstSin);
+            auto cosInfo = a3d::Reflection::ToSwizzleInfo(dstCos);
+
+            dstSin = StringHelper::GetWithSwizzle(dstSin);
+            dstCos = StringHelper::GetWithSwizzle(dstCos);
+
+            std::string srcSin = m_Reflection.GetCastedString(src, sinInfo);
+            std::string srcCos = m_Reflection.GetCastedString(src, cosInfo);
+
+            std::string left1 = "sin(" + srcSin + ")";
+            std::string left2 = "cos(" + srcCos + ")";
+
+            std::string cmd1, cmd2;
+            if (dstSin != "null")
+            {
+                cmd1 = dstSin + " = " + FilterSat( left1, sat ) + ";\n";
+                PushInstruction(cmd1);
+            }
+            if (dstCos != "null")
+            { 
+                cmd2 = dstCos + " = " + FilterSat( left2, sat ) + ";\n";
+                PushInstruction(cmd2);
+            }
+        }
+        break;
+
+    case a3d::OPCODE_STORE_RAW:
+        {
+            auto dstUAV = GetOperand();
+
+            auto dim   = 0;
+            auto pInfo = m_Reflection.QueryUav(dstUAV);
+            if (pInfo != nullptr)
+            {
+                dstUAV = pInfo->ExpandName;
+                dim    = pInfo->DimValue;
+            }
+
+            char pat[] = { 'x', 'y', 'z', 'w' };
+            a3d::SwizzleInfo swz = {};
+            swz.Count = dim;
+            for(auto i=0; i<dim; ++i)
+            {
+                swz.Pattern[i] = pat[i];
+                swz.Index[i] = i;
+            }
 
-            std::string cmd = dst + " = " + texture + ".GatherCmp(" + sampler + ", " + texcoord + ", " + refValue + ");\n";
+            auto dstAddress = GetOperand(swz);
+            auto src0       = GetOperand();
+
+            std::string cmd = dstUAV + "[" + dstAddress + "]" + " = " + src0 + ";\n";
             PushInstruction(cmd);
         }
-    }
-    else if (FindTag("gather4_po"))
-    {
-        if (m_Tokenizer.Compare("gather4_po_aoffimmi_indexable"))
+        break;
+
+    case a3d::OPCODE_STORE_STRUCTURED:
         {
-            std::string dest;
-            std::string srcAddress;
-            std::string srcOffset;
-            std::string srcResource;
-            std::string srcSampler;
-            Get5(dest, srcAddress, srcOffset, srcResource, srcSampler);
-            // TODO : Implement.
+            auto dstUAV = GetOperand();
+
+            auto dim   = 0;
+            auto pInfo = m_Reflection.QueryUav(dstUAV);
+            if (pInfo != nullptr)
+            {
+                dstUAV = pInfo->ExpandName;
+                dim    = pInfo->DimValue;
+            }
+
+            char pat[] = { 'x', 'y', 'z', 'w' };
+            a3d::SwizzleInfo swz = {};
+            swz.Count = dim;
+            for(auto i=0; i<dim; ++i)
+            {
+                swz.Pattern[i] = pat[i];
+                swz.Index[i] = i;
+            }
+
+            auto dstAddress = GetOperand(swz);
+            auto src0       = GetOperand();
+
+            std::string cmd = dstUAV + "[" + dstAddress + "]" + " = " + src0 + ";\n";
+            PushInstruction(cmd);
         }
-        else if (m_Tokenizer.Compare("gather4_po_indexable"))
+        break;
+
+    case a3d::OPCODE_SWITCH:
         {
-            std::string dest;
-            std::string srcAddress;
-            std::string srcOffset;
-            std::string srcResource;
-            std::string srcSampler;
-            Get5(dest, srcAddress, srcOffset, srcResource, srcSampler);
-            // TODO : Implement.
+            std::string val(NextOperand());
+            std::string cmd = "switch(" + val + ") {\n";
+            PushInstruction(cmd);
+            m_Indent++;
+        }
+        break;
+
+    case a3d::OPCODE_SYNC:
+        {
+            // TODO : Implement. (_uglobal, _ugroup, _g, _t の組み合わせで同期の種類が決まる.)
+        }
+        break;
+
+    case a3d::OPCODE_UDIV:
+        {
+            std::string dstQUOT, dstREM, lhs, rhs;
+            Get4(dstQUOT, dstREM, lhs, rhs);
+
+            if (dstREM != "null")
+            {
+                std::string cmd = dstREM + " = " + lhs + " % " + rhs + ";\n";
+                PushInstruction(cmd);
+            }
+            if (dstQUOT != "null")
+            {
+                std::string cmd = dstQUOT + " = " + lhs + " / " + rhs + ";\n";
+                PushInstruction(cmd);
+            }
         }
+        break;
+
+    default:
+        return false;
     }
-    else if (FindTag("gather4_po_c"))
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      Shader Model 5.0 の命令を解析します.
+//-------------------------------------------------------------------------------------------------
+bool AsmParser::ParseInstructionSM5(a3d::OPCODE_TYPE opcode, const a3d::Modifier& modifier)
+{
+    // MSDN - Shader Model 5 Assembly.
+    // https://learn.microsoft.com/en-us/windows/win32/direct3dhlsl/shader-model-5-assembly--directx-hlsl- 参照.
+
+    auto sat = (modifier.Flags & a3d::MODIFIER_SATURATE) != 0;
+
+    switch(opcode)
     {
-        if (m_Tokenizer.Compare("gather4_po_c_aoffimmi_indexable"))
+    case a3d::OPCODE_ATOMIC_AND:
         {
-            std::string dest;
-            std::string srcAddress;
-            std::string srcOffset;
-            std::string srcResource;
-            std::string srcSampler;
-            std::string srcReferenceValue;
-            Get6(dest, srcAddress, srcOffset, srcResource, srcSampler, srcReferenceValue);
-            // TODO : Implement.
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            Get3(dst, dstAddress, src0);
+
+            std::string cmd = std::string("InterlockedAnd(") + dst + ", " + src0 + ");\n";
+            PushInstruction(cmd);
         }
-        else if (m_Tokenizer.Compare("gather4_po_c_indexable"))
+        break;
+
+    case a3d::OPCODE_ATOMIC_CMP_STORE:
         {
-            std::string dest;
-            std::string srcAddress;
-            std::string srcOffset;
-            std::string srcResource;
-            std::string srcSampler;
-            std::string srcReferenceValue;
-            Get6(dest, srcAddress, srcOffset, srcResource, srcSampler, srcReferenceValue);
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            std::string src1;
+            Get4(dst, dstAddress, src0, src1);
+
             // TODO : Implement.
         }
-    }
-    else if (FindTag("hs_control_point_phase"))
-    {
-        // TODO : Implement.
-    }
-    else if (FindTag("hs_decls"))
-    {
-        // TODO : Implement.
-    }
-    else if (FindTag("hs_fork_phase"))
-    {
-        // TODO : Implement.
-    }
-    else if (FindTag("hs_join_phase"))
-    {
-        // TODO : Implement.
-    }
-    else if (FindTag("ibfe"))
-    {
-        auto dest = GetOperand();
-        auto src0 = GetOperand();
-        auto src1 = GetOperand();
-        auto src2 = GetOperand();
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_alloc"))
-    {
-        std::string dst;
-        std::string dstUAV;
-        Get2(dst, dstUAV);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_and"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_cmp_exch"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        std::string src1;
-        Get5(dst0, dst1, dstAddress, src0, src1);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_consume"))
-    {
-        std::string dst0;
-        std::string dstUAV;
-        Get2(dst0, dstUAV);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_exch"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODOl : Implement.
-    }
-    else if (FindTag("imm_atomic_iadd"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_imax"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_imin"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_or"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_umax"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODOl : Implement.
-    }
-    else if (FindTag("imm_atomic_umin"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODO : Implement.
-    }
-    else if (FindTag("imm_atomic_xor"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string dstAddress;
-        std::string src0;
-        Get4(dst0, dst1, dstAddress, src0);
-        // TODO : Implement.
-    }
-    else if (FindTag("ishl"))
-    {
-        PushOp2("<<", sat);
-    }
-    else if (FindTag("ishr"))
-    {
-        PushOp2(">>", sat);
-    }
-    else if (FindTag("ld_raw"))
-    {
-        std::string dst0;
-        Get1(dst0);
+        break;
 
-        auto srcByteOffset = GetOperand();
-        auto src0 = GetOperand();
+    case a3d::OPCODE_ATOMIC_IADD:
+        {
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            Get3(dst, dstAddress, src0);
 
-        // TODO : 実装が怪しいので後でチェック.
-        std::string cmd = dst0 + " = " + src0 + "[" + srcByteOffset + "];\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("ld_structured"))
-    {
-        std::string dst0;
-        Get1(dst0);
+            std::string cmd = std::string("InterlockedAdd(") + dst + ", " + src0 + ");\n";
+            PushInstruction(cmd);
+        }
+        break;
 
-        auto srcAddress    = GetOperand();
-        auto srcByteOffset = GetOperand();
-        auto src0          = GetOperand();
+    case a3d::OPCODE_ATOMIC_IMAX:
+        {
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            Get3(dst, dstAddress, src0);
 
-        // TODO : 実装が怪しいので後でチェック.
-        std::string cmd = dst0 + " = " + src0 + "[" + srcAddress + "];\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("ld_uav_typed"))
-    {
-        std::string dst0;
-        Get1(dst0);
+            std::string cmd = std::string("InterlockedMax(") + dst + ", " + src0 + ");\n";
+            PushInstruction(cmd);
+        }
+        break;
+
+    case a3d::OPCODE_ATOMIC_IMIN:
+        {
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            Get3(dst, dstAddress, src0);
 
-        auto srcAddress = GetOperand();
-        auto srcUAV = GetOperand();
+            std::string cmd = std::string("InterlockedMin(") + dst + ", " + src0 + ");\n";
+            PushInstruction(cmd);
+        }
+        break;
 
-        std::string cmd = dst0 + " = " + srcUAV + "[" + srcAddress + "];\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("rcp"))
-    {
-        PushCmd2("rcp", sat);
-    }
-    else if (m_Tokenizer.Compare("sample_indexable"))
-    {
-        std::string dest;
-        std::string texcoord;
-        std::string texture;
-        std::string sampler;
-        GetSampleIndexable0(dest, texture, sampler, texcoord);
+    case a3d::OPCODE_ATOMIC_OR:
+        {
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            Get3(dst, dstAddress, src0);
 
-        std::string left = texture + ".Sample(" + sampler + ", " + texcoord + ")";
-        std::string cmd = dest + " = " + FilterSat(left, sat) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_aoffimmi_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        GetSampleOffsetIndexable0(dest, texture, sampler, texcoord, offset);
+            std::string cmd = std::string("InterlockedOr(") + dst + ", " + src0 + ");\n";
+            PushInstruction(cmd);
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + ".Sample(" + sampler + ", " + texcoord + ", " + offset + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_b"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string lodBias;
-        GetSampleIndexable1( dest, texture, sampler, texcoord, lodBias);
+    case a3d::OPCODE_ATOMIC_UMAX:
+        {
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            Get3(dst, dstAddress, src0);
 
-        std::string cmd = dest + " = " + texture + "SampleBias(" + sampler + "," + texcoord + ", " + lodBias + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_b_aoffimmi_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string lodBias;
-        GetSampleOffsetIndexable1( dest, texture, sampler, texcoord, offset, lodBias );
+            std::string cmd = std::string("InterlockedMax(") + dst + ", " + src0 + ");\n";
+            PushInstruction(cmd);
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + ".SampleBias(" + sampler + ", " + texcoord + ", " + lodBias + ", " + offset + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_c_indexable"))
-    {
-        std::string dst;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string refValue;
-        GetSampleIndexable1(dst, texture, sampler, texcoord, refValue);
+    case a3d::OPCODE_ATOMIC_UMIN:
+        {
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            Get3(dst, dstAddress, src0);
 
-        std::string cmd = dst + " = " + texture + ".SampleCmp(" + sampler + ", " + texcoord + ", " + refValue + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_c_aoffimmi_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string refValue;
-        GetSampleOffsetIndexable1(dest, texture, sampler, texcoord, offset, refValue);
+            std::string cmd = std::string("InterlockedMin(") + dst + ", " + src0 + ");\n";
+            PushInstruction(cmd);
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + ".SampleCmp(" + sampler + ", " + texcoord + ", " + refValue + ", " + offset + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_c_lz_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string refValue;
-        GetSampleIndexable1( dest, texture, sampler, texcoord, refValue );
+    case a3d::OPCODE_ATOMIC_XOR:
+        {
+            std::string dst;
+            std::string dstAddress;
+            std::string src0;
+            Get3(dst, dstAddress, src0);
 
-        std::string cmd = dest + " = " + texture + ".SampleCmpLevelZero(" + sampler + ", " + texcoord + ", "  + refValue + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_c_lz_aoffimmi_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string refValue;
-        GetSampleOffsetIndexable1( dest, texture, sampler, texcoord, offset, refValue );
+            std::string cmd = std::string("InterlockedXor(") + dst + ", " + src0 + ");\n";
+            PushInstruction(cmd);
+        }
+        break;
+
+    case a3d::OPCODE_BFI:
+        {
+            std::string dst;
+            std::string src0;
+            std::string src1;
+            std::string src2;
+            std::string src3;
+            Get5(dst, src0, src1, src2, src3);
+
+            // TODO : Implement.
+        }
+        break;
+
+    case a3d::OPCODE_BUFINFO:
+        {
+            std::string dst;
+            std::string srcResource;
+            Get2(dst, srcResource);
+
+            std::string cmd = srcResource + ".GetDimensions(" + dst + ");\n";
+            PushInstruction(cmd);
+        }
+        break;
+
+    case a3d::OPCODE_CUT_STREAM:
+        {
+            std::string streamIndex = GetOperand();
+
+            // TODO : Implement.
+        }
+        break;
 
-        std::string cmd = dest + " = " + texture + ".SampleCmpLevelZero(" + sampler + ", " + texcoord + ", " + refValue + ", " + offset + ");\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_d_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string xDerivative;
-        std::string yDerivative;
-        GetSample2( dest, texture, sampler, texcoord, xDerivative, yDerivative );
+    case a3d::OPCODE_DCL_FUNCTION_BODY:
+        {
+            auto label = NextOperand();
+            // TODO : Implement.
+        }
+        break;
 
-        std::string left = texture + ".SampleGrad(" + sampler + ", " + texcoord + ", " + xDerivative + ", " + yDerivative + ")";
-        std::string cmd = dest + " = " + FilterSat( left, sat ) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if(m_Tokenizer.Compare("sample_d_aoffimmi_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string xDerivative;
-        std::string yDerivative;
-        GetSampleOffsetIndexable2(dest, texture, sampler, texcoord, offset, xDerivative, yDerivative);
+    case a3d::OPCODE_DCL_FUNCTION_TABLE:
+        {
+            // TODO : Implement.
+            auto table = GetOperand();
+        }
+        break;
 
-        std::string left = texture + ".SampleGrad(" + sampler + ", " + texcoord + ", " + xDerivative + ", " + yDerivative + ", " + offset + ")";
-        std::string cmd  = dest + " = " + FilterSat( left, sat ) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_l_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string lod;
-        GetSampleIndexable1(dest, texture, sampler, texcoord, lod);
+    case a3d::OPCODE_DCL_HS_FORK_PHASE_INSTANCE_COUNT:
+        {
+            // TODO : Implement.
+        }
+        break;
 
-        std::string left = texture + ".SampleLevel(" + sampler + ", " + texcoord + ", " + lod + ")";
-        std::string cmd  = dest + " = " + FilterSat( left, sat ) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (m_Tokenizer.Compare("sample_l_aoffimmi_indexable"))
-    {
-        std::string dest;
-        std::string texture;
-        std::string sampler;
-        std::string texcoord;
-        std::string offset;
-        std::string lod;
-        GetSampleOffsetIndexable1( dest, texture, sampler, texcoord, offset, lod );
+    case a3d::OPCODE_DCL_HS_JOIN_PHASE_INSTANCE_COUNT:
+        {
+            // TODO : Implement.
+        }
+        break;
 
-        std::string left = texture + ".SampleLevel(" + sampler + ", " + texcoord + ", " + lod + ", " + offset + ")";
-        std::string cmd  = dest + " = " + FilterSat( left, sat ) + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("store_raw"))
-    {
-        auto dstUAV = GetOperand();
+    case a3d::OPCODE_DCL_HS_MAX_TESSFACTOR:
+        {
+            // TODO : Implement.
+            auto count = NextOperand();
+        }
+        break;
 
-        a3d::Reflection::ResourceInfo info;
-        if (m_Reflection.QueryUav(dstUAV, &info))
+    case a3d::OPCODE_DCL_INPUT_CONTROL_POINT_COUNT:
         {
-            dstUAV = info.ExpandName;
+            // TODO : Implement.
+            auto count = NextOperand();
         }
+        break;
 
-        char pat[] = { 'x', 'y', 'z', 'w' };
-        a3d::SwizzleInfo swz = {};
-        swz.Count = info.DimValue;
-        for(auto i=0; i<info.DimValue; ++i)
+    case a3d::OPCODE_DCL_INTERFACE:
         {
-            swz.Pattern[i] = pat[i];
-            swz.Index[i] = i;
+            // TODO : Implement.
+            auto fp = GetOperand();
         }
+        break;
 
-        auto dstAddress = GetOperand(swz);
-        auto src0       = GetOperand();
+    case a3d::OPCODE_DCL_INTERFACE_DYNAMICINDEXED:
+        {
+            // TODO : Implement.
+            auto fp = GetOperand();
+        }
+        break;
 
-        std::string cmd = dstUAV + "[" + dstAddress + "]" + " = " + src0 + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("store_structured"))
-    {
-        auto dstUAV = GetOperand();
+    case a3d::OPCODE_DCL_OUTPUT_CONTROL_POINT_COUNT:
+        {
+            auto count = NextOperand();
+            // TODO : Implement.
+        }
+        break;
 
-        a3d::Reflection::ResourceInfo info;
-        if (m_Reflection.QueryUav(dstUAV, &info))
+    case a3d::OPCODE_DCL_STREAM:
         {
-            dstUAV = info.ExpandName;
+            auto count = NextOperand(); // m0, m1, m2, m3.
+            // TODO : Implement.
         }
+        break;
 
-        char pat[] = { 'x', 'y', 'z', 'w' };
-        a3d::SwizzleInfo swz = {};
-        swz.Count = info.DimValue;
-        for(auto i=0; i<info.DimValue; ++i)
+    case a3d::OPCODE_DCL_TESSELLATOR_DOMAIN:
         {
-            swz.Pattern[i] = pat[i];
-            swz.Index[i] = i;
+            auto domain = NextOperand();
+            // TODO : Implement.
         }
+        break;
 
-        auto dstAddress = GetOperand(swz);
-        auto src0       = GetOperand();
+    case a3d::OPCODE_DCL_TESSELLATOR_OUTPUT_PRIMITIVE:
+        {
+            auto primitive = NextOperand();
+            // TODO : Implement.
+        }
+        break;
 
-        std::string cmd = dstUAV + "[" + dstAddress + "]" + " = " + src0 + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("store_uav_typed"))
-    {
-        std::string dstUAV;
-        Get1(dstUAV);
+    case a3d::OPCODE_DCL_TESSELLATOR_PARTITIONING:
+        {
+            auto partition = NextOperand();
+            // TODO : Implement.
+        }
+        break;
 
-        a3d::Reflection::ResourceInfo info;
-        if (m_Reflection.QueryUav(dstUAV, &info))
+    case a3d::OPCODE_DCL_UAV_TYPED:
         {
-            dstUAV = info.ExpandName;
+            auto uav       = GetOperand();
+            auto dimension = NextOperand();
+            auto type      = NextOperand();
+            // TODO : Implement.
         }
+        break;
 
-        char pat[] = { 'x', 'y', 'z', 'w' };
-        a3d::SwizzleInfo swz = {};
-        swz.Count = info.DimValue;
-        for(auto i=0; i<info.DimValue; ++i)
+    case a3d::OPCODE_EMIT_STREAM:
         {
-            swz.Pattern[i] = pat[i];
-            swz.Index[i] = i;
+            auto streamIndex = NextOperand();
+            // TODO : Implement.
         }
+        break;
 
-        auto dstAddress = GetOperand(swz);
-        auto src0       = GetOperand();
+    case a3d::OPCODE_EMIT_THEN_CUT_STREAM:
+        {
+            auto streamIndex = NextOperand();
+            // TODO : Implement.
+        }
+        break;
 
-        std::string cmd = dstUAV + "[" + dstAddress + "]" + " = " + src0 + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("swapc"))
-    {
-        std::string dst0;
-        std::string dst1;
-        std::string src0;
-        std::string src1;
-        std::string src2;
-        Get5(dst0, dst1, src0, src1, src2);
-        // TODO : Implement.
-    }
-    else if (FindTag("sync"))
-    {
-        if (m_Tokenizer.Compare("sync_uglobal"))
+    case a3d::OPCODE_FCALL:
         {
+            auto fp = GetOperand();
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_uglobal_g"))
+        break;
+
+    case a3d::OPCODE_FIRSTBIT:
+        {
+            if ((modifier.Flags & a3d::MODIFIER_LO) != 0)
+            {
+                PushCmd<1>("firstbitlow", sat);
+            }
+            else if ((modifier.Flags & (a3d::MODIFIER_HI | a3d::MODIFIER_SHI)) != 0)
+            {
+                PushCmd<1>("firstbithigh", sat);
+            }
+        }
+        break;
+
+    case a3d::OPCODE_GATHER4_PO:
         {
+            std::string dest;
+            std::string srcAddress;
+            std::string srcOffset;
+            std::string srcResource;
+            std::string srcSampler;
+            Get5(dest, srcAddress, srcOffset, srcResource, srcSampler);
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_uglobal_g_t"))
+        break;
+
+    case a3d::OPCODE_GATHER4_PO_C:
         {
+            std::string dest;
+            std::string srcAddress;
+            std::string srcOffset;
+            std::string srcResource;
+            std::string srcSampler;
+            std::string srcReferenceValue;
+            Get6(dest, srcAddress, srcOffset, srcResource, srcSampler, srcReferenceValue);
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_uglobal_t"))
+        break;
+
+    case a3d::OPCODE_HS_CONTROL_POINT_PHASE:
         {
+            m_Reflection.SetPatchConstantPhase(false);
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_ugroup"))
+        break;
+
+    case a3d::OPCODE_HS_DECLS:
         {
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_ugroup_g"))
+        break;
+
+    case a3d::OPCODE_HS_FORK_PHASE:
         {
+            m_Reflection.SetPatchConstantPhase(true);
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_ugroup_g_t"))
+        break;
+
+    case a3d::OPCODE_HS_JOIN_PHASE:
         {
+            m_Reflection.SetPatchConstantPhase(true);
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_ugroup_t"))
+        break;
+
+    case a3d::OPCODE_IBFE:
         {
+            auto dest = GetOperand();
+            auto src0 = GetOperand();
+            auto src1 = GetOperand();
+            auto src2 = GetOperand();
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_g"))
+        break;
+
+    case a3d::OPCODE_IMM_ATOMIC_ALLOC:
         {
+            std::string dst;
+            std::string dstUAV;
+            Get2(dst, dstUAV);
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_g_t"))
+        break;
+
+    case a3d::OPCODE_IMM_ATOMIC_AND:
         {
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
             // TODO : Implement.
         }
-        else if (m_Tokenizer.Compare("sync_t"))
+        break;
+
+    case a3d::OPCODE_IMM_ATOMIC_CMP_EXCH:
         {
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            std::string src1;
+            Get5(dst0, dst1, dstAddress, src0, src1);
             // TODO : Implement.
         }
-    }
-    else if (FindTag("uaddc"))
-    {
-        std::string dst0;
-        Get1(dst0);
+        break;
 
-        auto dst1 = GetOperand();
-        auto src0 = GetOperand();
-        auto src1 = GetOperand();
+    case a3d::OPCODE_IMM_ATOMIC_CONSUME:
+        {
+            std::string dst0;
+            std::string dstUAV;
+            Get2(dst0, dstUAV);
+            // TODO : Implement.
+        }
+        break;
 
-        std::string cmd = dst0 + " = " + src0 + " + " + src1 + ";\n";
-        PushInstruction(cmd);
-    }
-    else if (FindTag("ubfe"))
-    {
-        std::string dst0;
-        std::string src0;
-        std::string src1;
-        std::string src2;
-        Get4(dst0, src0, src1, src2);
-        // TODO : Implement.
-    }
-    else if (FindTag("ushr"))
-    {
-        PushOp2(">>", sat);
-    }
-    else if (FindTag("usubb"))
-    {
-        std::string dst0;
-        Get1(dst0);
+    case a3d::OPCODE_IMM_ATOMIC_EXCH:
+        {
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
+            // TODOl : Implement.
+        }
+        break;
 
-        auto dst1 = GetOperand();
-        auto src0 = GetOperand();
-        auto src1 = GetOperand();
+    case a3d::OPCODE_IMM_ATOMIC_IADD:
+        {
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
+            // TODO : Implement.
+        }
+        break;
 
-        // TODO : 実装が怪しいので要確認.
-        std::string cmd = dst0 + "= " + src0 + " - " + src1 + ";\n";
-        PushInstruction(cmd);
-    }
-    else
-    {
-        return false;
-    }
+    case a3d::OPCODE_IMM_ATOMIC_IMAX:
+        {
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
+            // TODO : Implement.
+        }
+        break;
 
-    return true;
-}
+    case a3d::OPCODE_IMM_ATOMIC_IMIN:
+        {
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
+            // TODO : Implement.
+        }
+        break;
 
-//-------------------------------------------------------------------------------------------------
-//      オペランドを取得します.
-//-------------------------------------------------------------------------------------------------
-std::string AsmParser::GetOperand()
-{
-    std::string temp;
-    m_Tokenizer.Next();
-    if (m_Tokenizer.Compare("l"))
-    {
-        temp += m_Tokenizer.NextAsChar(); // (
-        temp += m_Tokenizer.NextAsChar(); // 数値X.
+    case a3d::OPCODE_IMM_ATOMIC_OR:
+        {
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
+            // TODO : Implement.
+        }
+        break;
 
-        m_Tokenizer.Next();
-        if (!m_Tokenizer.Compare(")"))
+    case a3d::OPCODE_IMM_ATOMIC_UMAX:
         {
-            temp += ", ";
-            temp += m_Tokenizer.GetAsChar(); // 数値Y
-            m_Tokenizer.Next();
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
+            // TODOl : Implement.
         }
-        else
+        break;
+
+    case a3d::OPCODE_IMM_ATOMIC_UMIN:
         {
-            temp += m_Tokenizer.GetAsChar();
-            temp = StringHelper::Replace(temp, "(", "");
-            temp = StringHelper::Replace(temp, ")", "");
-            return temp;
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
+            // TODO : Implement.
         }
+        break;
 
-        if (!m_Tokenizer.Compare(")"))
+    case a3d::OPCODE_IMM_ATOMIC_XOR:
         {
-            temp += ", ";
-            temp += m_Tokenizer.GetAsChar(); // 数値Z
-            m_Tokenizer.Next();
+            std::string dst0;
+            std::string dst1;
+            std::string dstAddress;
+            std::string src0;
+            Get4(dst0, dst1, dstAddress, src0);
+            // TODO : Implement.
         }
-        else
+        break;
+
+    case a3d::OPCODE_LD_UAV_TYPED:
         {
-            temp += m_Tokenizer.GetAsChar();
-            return std::string("float2") + temp;
+            std::string dst0;
+            Get1(dst0);
+
+            auto srcAddress = GetOperand();
+            auto srcUAV = GetOperand();
+
+            std::string cmd = dst0 + " = " + srcUAV + "[" + srcAddress + "];\n";
+            PushInstruction(cmd);
         }
+        break;
 
-        if (!m_Tokenizer.Compare(")"))
+    case a3d::OPCODE_STORE_UAV_TYPED:
         {
-            temp += ", ";
-            temp += m_Tokenizer.GetAsChar(); // 数値W
-            m_Tokenizer.Next();
+            std::string dstUAV;
+            Get1(dstUAV);
+
+            auto dim   = 0;
+            auto pInfo = m_Reflection.QueryUav(dstUAV);
+            if (pInfo != nullptr)
+            {
+                dstUAV = pInfo->ExpandName;
+                dim    = pInfo->DimValue;
+            }
+
+            char pat[] = { 'x', 'y', 'z', 'w' };
+            a3d::SwizzleInfo swz = {};
+            swz.Count = dim;
+            for(auto i=0; i<dim; ++i)
+            {
+                swz.Pattern[i] = pat[i];
+                swz.Index[i] = i;
+            }
+
+            auto dstAddress = GetOperand(swz);
+            auto src0       = GetOperand();
+
+            std::string cmd = dstUAV + "[" + dstAddress + "]" + " = " + src0 + ";\n";
+            PushInstruction(cmd);
         }
-        else
+        break;
+
+    case a3d::OPCODE_SWAPC:
         {
-            temp += m_Tokenizer.GetAsChar();
-            return std::string("float3") + temp;
+            std::string dst0;
+            std::string dst1;
+            std::string src0;
+            std::string src1;
+            std::string src2;
+            Get5(dst0, dst1, src0, src1, src2);
+            // TODO : Implement.
         }
-    
+        break;
 
-        return std::string("float4") + temp + m_Tokenizer.GetAsChar();
-    }
+    case a3d::OPCODE_UADDC:
+        {
+            std::string dst0;
+            Get1(dst0);
 
-    temp = m_Tokenizer.GetAsChar();
-    if (strstr(temp.c_str(), "[") != nullptr && strstr(temp.c_str(), "]" ) == nullptr)
-    {
-        std::string words;
+            auto dst1 = GetOperand();
+            auto src0 = GetOperand();
+            auto src1 = GetOperand();
+
+            std::string cmd = dst0 + " = " + src0 + " + " + src1 + ";\n";
+            PushInstruction(cmd);
+        }
+        break;
 
-        while(true)
+    case a3d::OPCODE_UBFE:
         {
-            words += m_Tokenizer.NextAsChar();
-            if (strstr(words.c_str(), "]") != nullptr)
-            { break; }
+            std::string dst0;
+            std::string src0;
+            std::string src1;
+            std::string src2;
+            Get4(dst0, src0, src1, src2);
+            // TODO : Implement.
         }
+        break;
 
-        std::string line = temp + words;
-        line = StringHelper::Replace(line, "[", "[asuint(");
-        line = StringHelper::Replace(line, "]", ")]");
-        temp = line;
-    }
+    case a3d::OPCODE_USUBB:
+        {
+            std::string dst0;
+            Get1(dst0);
 
-    std::string ret = temp;
-    if (!m_Reflection.QueryName(temp, ret))
-    {
-        ret = temp;
+            auto dst1 = GetOperand();
+            auto src0 = GetOperand();
+            auto src1 = GetOperand();
 
-        // 絶対値記号による修飾があるかどうかチェック.
-        auto pos1 = temp.find("|");
-        auto pos2 = temp.rfind("|");
-        if (pos1 != std::string::npos
-         && pos2 != std::string::npos
-         && pos1 != pos2)
-        { ret = "abs(" + temp.substr(pos1 + 1, pos2 - pos1 - 1) + ")"; }
-    }
-    else
-    {
-        // 絶対値記号による修飾があるかどうかチェック.
-        auto pos1 = ret.find("|");
-        auto pos2 = ret.rfind("|");
-        if (pos1 != std::string::npos 
-         && pos2 != std::string::npos 
-         && pos1 != pos2 )
-        { ret = "abs(" + ret + ")"; }
+            // TODO : 実装が怪しいので要確認.
+            std::string cmd = dst0 + "= " + src0 + " - " + src1 + ";\n";
+            PushInstruction(cmd);
+        }
+        break;
+
+    default:
+        return false;
     }
 
-    return ret;
+    return true;
 }
 
 //-------------------------------------------------------------------------------------------------
-//      スウィズル数を考慮してオペランドを取得します.
+//      変換中の命令から次のオペランドを取得します. 残っていない場合は空文字列を返却します.
 //-------------------------------------------------------------------------------------------------
-std::string AsmParser::GetOperand(const a3d::SwizzleInfo& info)
+std::string_view AsmParser::NextOperand()
 {
-    auto op = GetOperand();
-    return m_Reflection.GetCastedString(op, info);
+    if (m_pInstruction == nullptr || m_OperandIndex >= m_pInstruction->OperandCount)
+    { return std::string_view(); }
+
+    auto& span = m_pInstruction->Operand[m_OperandIndex++];
+    return std::string_view(m_pProgramText + span.Offset, span.Length);
 }
 
 //-------------------------------------------------------------------------------------------------
-//      最大4つまでの引数を取得します.
+//      オペランドを取得します.
 //-------------------------------------------------------------------------------------------------
-std::string AsmParser::GetArgs()
+std::string AsmParser::GetOperand()
 {
-    m_Tokenizer.Next(); // (
-    std::string a = m_Tokenizer.NextAsChar();
-    std::string b, c, d;
-    m_Tokenizer.Next();
-    if (!m_Tokenizer.Compare(")"))
-    {
-        b = ", ";
-        b += m_Tokenizer.GetAsChar();
-        m_Tokenizer.Next();
+    auto value = NextOperand();
 
-        if (!m_Tokenizer.Compare(")"))
-        {
-            c = ", ";
-            c += m_Tokenizer.GetAsChar();
-            m_Tokenizer.Next();
+    // 即値 <ex> l(1.000000, 0, 0, 0)
+    if (IsLiteral(value))
+    { return ToLiteralString(value); }
 
-            if (!m_Tokenizer.Compare(")"))
-            {
-                d = ", ";
-                d += m_Tokenizer.GetAsChar();
-            }
-        }
+    auto temp = ToIndexedString(value);
+    auto operand = a3d::ParseOperand(temp);
+
+    std::string ret;
+    auto found = m_Reflection.QueryName(operand, ret);
+    if (!operand.Abs)
+    { return found ? ret : temp; }
+
+    // 絶対値記号による修飾がある場合は，符号を abs() の外に出す.
+    std::string_view name = operand.Body;
+    if (found)
+    {
+        name = ret;
+        if (operand.Negate && !name.empty() && name[0] == '-')
+        { name.remove_prefix(1); }
     }
 
-    return a + b + c + d;
+    std::string result = operand.Negate ? "-abs(" : "abs(";
+    result += name;
+    result += ")";
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      スウィズル数を考慮してオペランドを取得します.
+//-------------------------------------------------------------------------------------------------
+std::string AsmParser::GetOperand(const a3d::SwizzleInfo& info)
+{
+    auto op = GetOperand();
+    return m_Reflection.GetCastedString(op, info);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -2451,11 +2565,14 @@ std::string AsmParser::GetArgs()
 //-------------------------------------------------------------------------------------------------
 a3d::SwizzleInfo AsmParser::Get1(std::string& op0)
 {
-    std::string temp = m_Tokenizer.NextAsChar();
-    auto info = a3d::Reflection::ToSwizzleInfo(temp);
+    auto value = NextOperand();
+    auto temp  = IsLiteral(value) ? ToLiteralString(value) : ToIndexedString(value);
 
-    if(!m_Reflection.QueryName(temp, op0))
-    { op0 = temp; }
+    auto operand = a3d::ParseOperand(temp);
+    auto info    = a3d::Reflection::ToSwizzleInfo(operand);
+
+    if(!m_Reflection.QueryName(operand, op0))
+    { op0 = operand.Text; }
 
     auto swz = StringHelper::GetSwizzle(op0);
     if (swz == ".xyzw")
@@ -2511,290 +2628,84 @@ a3d::SwizzleInfo AsmParser::Get5(std::string& op0, std::string& op1, std::string
 }
 
 //-------------------------------------------------------------------------------------------------
-//      命令に使用するオペランドを出力先のスウィズル数を考慮して6つ取得します.
-//-------------------------------------------------------------------------------------------------
-a3d::SwizzleInfo AsmParser::Get6(std::string& op0, std::string& op1, std::string& op2, std::string& op3, std::string& op4, std::string& op5)
-{
-    auto info = Get1(op0);
-    op1 = GetOperand(info);
-    op2 = GetOperand(info);
-    op3 = GetOperand(info);
-    op4 = GetOperand(info);
-    op5 = GetOperand(info);
-    return info;
-}
-
-//------------------------------------------------------------------------------------------------
-//      サンプル命令のオペランドを取得します.
-//------------------------------------------------------------------------------------------------
-void AsmParser::GetSample0(std::string& dest, std::string& texture, std::string& sampler, std::string& texcoord)
-{
-    std::string dst;
-    Get1(dst);
-    std::string uv  = GetOperand();
-    std::string tex = GetOperand();
-    std::string smp = m_Tokenizer.NextAsChar();
-
-    std::string texName;
-    int cnt;
-    {
-        auto idx = tex.find(".");
-        if (idx != -1)
-        { tex = tex.substr(0, idx); }
-
-        a3d::Reflection::ResourceInfo info = {};
-        m_Reflection.QueryTexture(tex, &info);
-
-        texName = info.Name;
-        cnt = info.DimValue;
-        if (info.ArraySize > 1)
-        { texName += "[" + std::to_string(info.ArrayIndex) + "]"; }
-    }
-
-    a3d::SwizzleInfo swzInfo = {};
-    swzInfo.Count = cnt;
-    if (cnt >= 1)
-    {
-        swzInfo.Pattern[0] = 'x';
-        swzInfo.Index[0] = 0;
-    }
-    if (cnt >= 2)
-    {
-        swzInfo.Pattern[1] = 'y';
-        swzInfo.Index[1] = 1;
-    }
-    if (cnt >= 3)
-    {
-        swzInfo.Pattern[2] = 'z';
-        swzInfo.Index[2] = 2;
-    }
-
-    dest    = dst;
-    texture = texName;
-    sampler = smp;
-    texcoord = m_Reflection.GetCastedString(uv, swzInfo);
-}
-
-//--------------------------------------------------------------------------------------------------
-//      サンプル命令のオペランドを取得します(オプション1個)
-//--------------------------------------------------------------------------------------------------
-void AsmParser::GetSample1(std::string& dest, std::string& texture, std::string& sampler, std::string& texcoord, std::string& arg1)
-{
-    GetSample0(dest, texture, sampler, texcoord);
-    arg1 = GetOperand();
-}
-
-//-------------------------------------------------------------------------------------------------
-//      サンプル命令のオペランドを取得します(オプション2個)
+//      命令に使用するオペランドを出力先のスウィズル数を考慮して6つ取得します.
 //-------------------------------------------------------------------------------------------------
-void AsmParser::GetSample2
-(
-    std::string& dest,
-    std::string& texture,
-    std::string& sampler,
-    std::string& texcoord,
-    std::string& arg1,
-    std::string& arg2
-)
+a3d::SwizzleInfo AsmParser::Get6(std::string& op0, std::string& op1, std::string& op2, std::string& op3, std::string& op4, std::string& op5)
 {
-    GetSample0(dest, texture, sampler, texcoord);
-    arg1 = GetOperand();
-    arg2 = GetOperand();
+    auto info = Get1(op0);
+    op1 = GetOperand(info);
+    op2 = GetOperand(info);
+    op3 = GetOperand(info);
+    op4 = GetOperand(info);
+    op5 = GetOperand(info);
+    return info;
 }
 
 //-------------------------------------------------------------------------------------------------
-//      サンプルオフセット命令のオペランドを取得します.
+//      ロード命令のオペランドを取得します.
 //-------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleOffset0
-(
-    std::string& dest,
-    std::string& texture,
-    std::string& sampler,
-    std::string& texcoord,
-    std::string& sampleOffset
-)
+int AsmParser::GetLoad(std::string& dest, std::string& texture, std::string& texcoord)
 {
     std::string dst;
-    std::string offset      = GetArgs();
     Get1(dst);
-    std::string uv  = GetOperand();
-    std::string tex = GetOperand();
-    std::string smp = m_Tokenizer.NextAsChar();
-
-    std::string texName;
-    int cnt;
-    {
-        auto idx = tex.find(".");
-        if (idx != -1)
-        { tex = tex.substr(0, idx); }
-
-        a3d::Reflection::ResourceInfo info = {};
-        m_Reflection.QueryTexture(tex, &info);
+    std::string srcAddress  = GetOperand();
+    std::string srcResource = GetOperand();
 
-        texName = info.Name;
-        cnt = info.DimValue;
-        if (info.ArraySize > 1)
-        { texName += "[" + std::to_string(info.ArrayIndex) + "]"; }
-    }
+    // SM5 ではリソースにスウィズルが付くので取り除く.
+    auto textureName = StringHelper::GetWithSwizzle(srcResource, 0);
+    // リフレクションが無い場合はレジスタ名のまま出力する.
+    std::string name = textureName;
+    auto dim = 0;
 
-    a3d::SwizzleInfo swzInfo = {};
-    swzInfo.Count = cnt;
-    if (cnt >= 1)
-    {
-        swzInfo.Pattern[0] = 'x';
-        swzInfo.Index[0] = 0;
-    }
-    if (cnt >= 2)
-    {
-        swzInfo.Pattern[1] = 'y';
-        swzInfo.Index[1] = 1;
-    }
-    if (cnt >= 3)
+    auto pInfo = m_Reflection.QueryTexture(textureName);
+    if (pInfo != nullptr)
     {
-        swzInfo.Pattern[2] = 'z';
-        swzInfo.Index[2] = 2;
-    }
+        name = pInfo->Name;
+        if (pInfo->ArraySize > 1)
+        { name += "[" + std::to_string(pInfo->ArrayIndex) + "]"; }
 
-    offset = "float3(" + offset + ")";
-    offset = m_Reflection.GetCastedString(offset, swzInfo);
-    offset = StringHelper::Replace(offset, "float", "uint");
+        dim = pInfo->DimValue;
+    }
 
-    dest         = dst;
-    texture      = texName;
-    sampler      = smp;
-    texcoord     = m_Reflection.GetCastedString(uv, swzInfo);
-    sampleOffset = offset;
-}
+    dest     = dst;
+    texture  = name;
+    texcoord = srcAddress;
 
-//-------------------------------------------------------------------------------------------------
-//      サンプルオフセット命令のオペランドを取得します(オプション1個).
-//-------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleOffset1
-(
-    std::string& dest,
-    std::string& texture,
-    std::string& sampler,
-    std::string& texcoord,
-    std::string& sampleOffset,
-    std::string& arg1
-)
-{
-    GetSampleOffset0(dest, texture, texcoord, sampler, sampleOffset);
-    arg1 = GetOperand();
+    return dim;
 }
 
 //-------------------------------------------------------------------------------------------------
-//      サンプルオフセット命令のオペランドを取得します(オプション2個)
+//      リソース情報取得命令のオペランドを取得します.
 //-------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleOffset2
-(
-    std::string& dest,
-    std::string& texture,
-    std::string& sampler,
-    std::string& texcoord,
-    std::string& sampleOffset,
-    std::string& arg1,
-    std::string& arg2
-)
-{
-    GetSampleOffset0(dest, texture, sampler, texcoord, sampleOffset);
-    arg1 = GetOperand();
-    arg2 = GetOperand();
-}
-
-//------------------------------------------------------------------------------------------------
-//      サンプル命令のオペランドを取得します.
-//------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleIndexable0(std::string& dest, std::string& texture, std::string& sampler, std::string& texcoord)
+void AsmParser::GetResInfo(std::string& dest, std::string& texture, std::string& mipLevel)
 {
-    m_Tokenizer.Next(); // "("
-    std::string type = m_Tokenizer.NextAsChar();
-    m_Tokenizer.Next(); // ")"
-
-    std::string args = GetArgs();
-    m_Tokenizer.Next();
-
     std::string dst;
     Get1(dst);
+    std::string srcMipLevel = GetOperand();
+    std::string srcResource = GetOperand();
 
-    std::string uv  = GetOperand();
-    std::string tex = GetOperand();
-    std::string smp = GetOperand();
-
-    std::string texName;
-    int cnt;
-    {
-        auto idx = tex.find(".");
-        if (idx != -1)
-        { tex = tex.substr(0, idx); }
-
-        a3d::Reflection::ResourceInfo info = {};
-        m_Reflection.QueryTexture(tex, &info);
-
-        texName = info.Name;
-        cnt = info.DimValue;
-        if (info.ArraySize > 1)
-        { texName += "[" + std::to_string(info.ArrayIndex) + "]"; }
-    }
-
-    a3d::SwizzleInfo swzInfo = {};
-    swzInfo.Count = cnt;
-    if (cnt >= 1)
-    {
-        swzInfo.Pattern[0] = 'x';
-        swzInfo.Index[0] = 0;
-    }
-    if (cnt >= 2)
-    {
-        swzInfo.Pattern[1] = 'y';
-        swzInfo.Index[1] = 1;
-    }
-    if (cnt >= 3)
+    std::string name;
     {
-        swzInfo.Pattern[2] = 'z';
-        swzInfo.Index[2] = 2;
+        auto textureName = StringHelper::GetWithSwizzle(srcResource, 0);
+        auto pInfo = m_Reflection.QueryTexture(textureName);
+        if (pInfo != nullptr)
+        {
+            name = pInfo->Name;
+            if (pInfo->ArraySize > 1)
+            { name += "[" + std::to_string(pInfo->ArrayIndex) + "]"; }
+        }
     }
 
-    dest = dst;
-    texture = texName;
-    sampler = smp;
-    texcoord = m_Reflection.GetCastedString(uv, swzInfo);
-}
-
-//------------------------------------------------------------------------------------------------
-//      サンプル命令のオペランドを取得します.
-//------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleIndexable1(std::string& dest, std::string& texture, std::string& sampler, std::string& texcoord, std::string& arg1)
-{
-    GetSampleIndexable0(dest, texture, sampler, texcoord);
-    arg1 = GetOperand();
-}
-
-//------------------------------------------------------------------------------------------------
-//      サンプル命令のオペランドを取得します.
-//------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleIndexable2(std::string& dest, std::string& texture, std::string& sampler, std::string& texcoord, std::string& arg1, std::string& arg2)
-{
-    GetSampleIndexable0(dest, texture, sampler, texcoord);
-    arg1 = GetOperand();
-    arg2 = GetOperand();
+    dest     = dst;
+    texture  = name;
+    mipLevel = srcMipLevel;
 }
 
 //-------------------------------------------------------------------------------------------------
-//      サンプルオフセット命令のオペランドを取得します.
+//      サンプル命令を追加します.
 //-------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleOffsetIndexable0(std::string& dest, std::string& texture, std::string& sampler, std::string& texcoord, std::string& sampleOffset)
+void AsmParser::PushSample(const a3d::OpcodeInfo& info, const a3d::Modifier& modifier, bool sat)
 {
-    m_Tokenizer.Next(); // "("
-    std::string type = m_Tokenizer.NextAsChar();
-    m_Tokenizer.Next(); // ")"
-
-    std::string args = GetArgs();
-    m_Tokenizer.Next();
-
-
-    std::string offset = GetArgs();
-
     std::string dst;
     Get1(dst);
 
@@ -2809,13 +2720,18 @@ void AsmParser::GetSampleOffsetIndexable0(std::string& dest, std::string& textur
         if (idx != -1)
         { tex = tex.substr(0, idx); }
 
-        a3d::Reflection::ResourceInfo info = {};
-        m_Reflection.QueryTexture(tex, &info);
+        // リフレクションが無い場合はレジスタ名のまま出力する.
+        texName = tex;
+        cnt     = 0;
 
-        texName = info.Name;
-        cnt = info.DimValue;
-        if (info.ArraySize > 1)
-        { texName += "[" + std::to_string(info.ArrayIndex) + "]"; }
+        auto pResInfo = m_Reflection.QueryTexture(tex);
+        if (pResInfo != nullptr)
+        {
+            texName = pResInfo->Name;
+            cnt     = pResInfo->DimValue;
+            if (pResInfo->ArraySize > 1)
+            { texName += "[" + std::to_string(pResInfo->ArrayIndex) + "]"; }
+        }
     }
 
     a3d::SwizzleInfo swzInfo = {};
@@ -2836,112 +2752,19 @@ void AsmParser::GetSampleOffsetIndexable0(std::string& dest, std::string& textur
         swzInfo.Index[2] = 2;
     }
 
-    offset = "float3(" + offset + ")";
-    offset = m_Reflection.GetCastedString(offset, swzInfo);
-    offset = StringHelper::Replace(offset, "float", "uint");
-
-    dest         = dst;
-    texture      = texName;
-    sampler      = smp;
-    texcoord     = m_Reflection.GetCastedString(uv, swzInfo);
-    sampleOffset = offset;
-}
-
-//-------------------------------------------------------------------------------------------------
-//      サンプルオフセット命令のオペランドを取得します(オプション1個).
-//-------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleOffsetIndexable1(std::string& dest, std::string& texture, std::string& sampler, std::string& texcoord, std::string& offset, std::string& arg1)
-{
-    GetSampleOffsetIndexable0(dest, texture, texcoord, sampler, offset);
-    arg1 = GetOperand();
-}
-
-//-------------------------------------------------------------------------------------------------
-//      サンプルオフセット命令のオペランドを取得します(オプション2個).
-//-------------------------------------------------------------------------------------------------
-void AsmParser::GetSampleOffsetIndexable2(std::string& dest, std::string& texture, std::string& sampler, std::string& texcoord, std::string& offset, std::string& arg1, std::string& arg2)
-{
-    GetSampleOffsetIndexable0(dest, texture, texcoord, sampler, offset);
-    arg1 = GetOperand();
-    arg2 = GetOperand();
-}
-
-//-------------------------------------------------------------------------------------------------
-//      ロード命令のオペランドを取得します.
-//-------------------------------------------------------------------------------------------------
-void AsmParser::GetLoad(std::string& dest, std::string& texture, std::string& texcoord)
-{
-    std::string dst;
-    Get1(dst);
-    std::string srcAddress  = GetOperand();
-    std::string srcResource = GetOperand();
-
-    a3d::Reflection::ResourceInfo info = {};
-    m_Reflection.QueryTexture(srcResource, &info);
-
-    std::string name = info.Name;
-    if (info.ArraySize > 1)
-    { name += "[" + std::to_string(info.ArrayIndex) + "]"; }
-
-    dest     = dst;
-    texture  = name;
-    texcoord = srcAddress;
-}
-
-//-------------------------------------------------------------------------------------------------
-//      ロードオフセット命令のオペランドを取得します.
-//-------------------------------------------------------------------------------------------------
-void AsmParser::GetLoadOffset
-(
-    std::string& dest,
-    std::string& texture,
-    std::string& texcoord,
-    std::string& loadOffset
-)
-{
-    std::string dst;
-    std::string offset      = GetArgs();
-    Get1(dst);
-    std::string srcAddress  = GetOperand();
-    std::string srcResource = GetOperand();
-
-    a3d::Reflection::ResourceInfo info = {};
-    m_Reflection.QueryTexture(srcResource, &info);
-
-    auto name = info.Name;
-    if (info.ArraySize > 1)
-    { name += "[" + std::to_string(info.ArrayIndex) + "]"; }
-
-    dest        = dst;
-    texture     = name;
-    texcoord    = srcAddress;
-    loadOffset  = offset;
-}
+    std::string args = smp + ", " + m_Reflection.GetCastedString(uv, swzInfo);
 
-//-------------------------------------------------------------------------------------------------
-//      リソース情報取得命令のオペランドを取得します.
-//-------------------------------------------------------------------------------------------------
-void AsmParser::GetResInfo(std::string& dest, std::string& texture, std::string& mipLevel)
-{
-    std::string dst;
-    Get1(dst);
-    std::string srcMipLevel = GetOperand();
-    std::string srcResource = GetOperand();
+    // 比較値, LOD, 勾配などテクスチャ座標, テクスチャ, サンプラー以外の入力.
+    for(auto i=3; i<info.SrcCount; ++i)
+    { args += ", " + GetOperand(); }
 
-    std::string name;
-    {
-        auto textureName = StringHelper::GetWithSwizzle(srcResource, 0);
-        a3d::Reflection::ResourceInfo info = {};
-        m_Reflection.QueryTexture(textureName, &info);
+    if ((modifier.Flags & a3d::MODIFIER_AOFFIMMI) != 0)
+    { args += ", " + ToOffsetString(modifier, cnt); }
 
-        name = info.Name;
-        if (info.ArraySize > 1)
-        { name += "[" + std::to_string(info.ArrayIndex) + "]"; }
-    }
+    std::string left = texName + "." + std::string(info.Symbol) + "(" + args + ")";
+    std::string cmd  = dst + " = " + FilterSat( left, sat ) + ";\n";
 
-    dest     = dst;
-    texture  = name;
-    mipLevel = srcMipLevel;
+    PushInstruction(cmd);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -2990,43 +2813,27 @@ void AsmParser::PushDp(int count, bool sat)
 }
 
 //-------------------------------------------------------------------------------------------------
-//      2つ数をとる命令を追加します.
-//-------------------------------------------------------------------------------------------------
-void AsmParser::PushCmd2(std::string tag, bool sat)
-{
-    std::string dst, src;
-    Get2(dst, src);
-
-    std::string right = tag + "(" + src + ")";
-    std::string cmd  = dst + " = " + FilterSat( right, sat ) + ";\n";
-
-    PushInstruction(cmd);
-}
-
-//-------------------------------------------------------------------------------------------------
-//      3つの数をとる命令を追加します.
+//      関数呼び出しの形式となる命令を追加します.
 //-------------------------------------------------------------------------------------------------
-void AsmParser::PushCmd3(std::string tag, bool sat)
+template<int Count>
+void AsmParser::PushCmd(std::string_view tag, bool sat)
 {
-    std::string dst, lhs, rhs;
-    Get3(dst, lhs, rhs);
-
-    std::string right = tag + "(" + lhs + ", " + rhs  + ")";
-    std::string cmd  = dst + " = " + FilterSat( right, sat ) + ";\n";
+    static_assert(1 <= Count && Count <= 3, "Invalid operand count.");
 
-    PushInstruction(cmd);
-}
+    std::string dst;
+    auto info = Get1(dst);
 
-//-------------------------------------------------------------------------------------------------
-//      4つの数を命令を追加します.
-//-------------------------------------------------------------------------------------------------
-void AsmParser::PushCmd4(std::string tag, bool sat)
-{
-    std::string dst, op1, op2, op3;
-    Get4(dst, op1, op2, op3);
+    std::string right(tag);
+    right += "(";
+    for(auto i=0; i<Count; ++i)
+    {
+        if (i > 0)
+        { right += ", "; }
+        right += GetOperand(info);
+    }
+    right += ")";
 
-    std::string right = tag + "(" + op1 + ", " + op2 + ", " + op3 + ")";
-    std::string cmd   = dst + " = " + FilterSat( right, sat ) + ";\n";
+    std::string cmd = dst + " = " + FilterSat( right, sat ) + ";\n";
 
     PushInstruction(cmd);
 }
@@ -3176,25 +2983,25 @@ void AsmParser::PushCmp(std::string tag, bool integer)
             leftZ = baseLhs;
             leftW = baseLhs;
 
-            if (swzDst.Count >= 1)
+            if (swzDst.Count >= 1 && swzLhs.Count > 0)
             {
                 auto idx = swzDst.Index[0] % swzLhs.Count;
                 leftX += StringHelper::Format( ".%c", swzLhs.Pattern[idx] );
             }
             
-            if (swzDst.Count >= 2)
+            if (swzDst.Count >= 2 && swzLhs.Count > 0)
             {
                 auto idx = swzDst.Index[1] % swzLhs.Count;
                 leftY += StringHelper::Format( ".%c", swzLhs.Pattern[idx] );
             }
 
-            if (swzDst.Count >= 3)
+            if (swzDst.Count >= 3 && swzLhs.Count > 0)
             {
                 auto idx = swzDst.Index[2] % swzLhs.Count;
                 leftZ += StringHelper::Format( ".%c", swzLhs.Pattern[idx] );
             }
 
-            if (swzDst.Count >= 4)
+            if (swzDst.Count >= 4 && swzLhs.Count > 0)
             {
                 auto idx = swzDst.Index[3] % swzLhs.Count;
                 leftW += StringHelper::Format( ".%c", swzLhs.Pattern[idx] );
@@ -3241,25 +3048,25 @@ void AsmParser::PushCmp(std::string tag, bool integer)
             rightZ = baseRhs;
             rightW = baseRhs;
 
-            if (swzDst.Count >= 1)
+            if (swzDst.Count >= 1 && swzRhs.Count > 0)
             {
                 auto idx = swzDst.Index[0] % swzRhs.Count;
                 rightX += StringHelper::Format( ".%c", swzRhs.Pattern[idx] );
             }
             
-            if (swzDst.Count >= 2)
+            if (swzDst.Count >= 2 && swzRhs.Count > 0)
             {
                 auto idx = swzDst.Index[1] % swzRhs.Count;
                 rightY += StringHelper::Format( ".%c", swzRhs.Pattern[idx] );
             }
 
-            if (swzDst.Count >= 3)
+            if (swzDst.Count >= 3 && swzRhs.Count > 0)
             {
                 auto idx = swzDst.Index[2] % swzRhs.Count;
                 rightZ += StringHelper::Format( ".%c", swzRhs.Pattern[idx] );
             }
 
-            if (swzDst.Count >= 4)
+            if (swzDst.Count >= 4 && swzRhs.Count > 0)
             {
                 auto idx = swzDst.Index[3] % swzRhs.Count;
                 rightW += StringHelper::Format( ".%c", swzRhs.Pattern[idx] );
@@ -3484,11 +3291,16 @@ void AsmParser::PushMovc(bool sat)
 
     if (swzDst.Count == 1)
     {
-        std::string cmd = dst + " = ( " + op0 + " >= 0 ) ? " + op1 + " : " + op2 + ";\n";
+        std::string cmd = dst + " = " + FilterSat( "( " + op0 + " >= 0 ) ? " + op1 + " : " + op2, sat ) + ";\n";
         PushInstruction(cmd);
     }
     else
     {
+        // 成分ごとに分解するので，絶対値の修飾は一旦外して各成分に付け直す.
+        auto absOp0 = StripAbs(op0);
+        auto absOp1 = StripAbs(op1);
+        auto absOp2 = StripAbs(op2);
+
         auto swzOp0 = a3d::Reflection::ToSwizzleInfo(op0);
         auto swzOp1 = a3d::Reflection::ToSwizzleInfo(op1);
         auto swzOp2 = a3d::Reflection::ToSwizzleInfo(op2);
@@ -3574,10 +3386,17 @@ void AsmParser::PushMovc(bool sat)
 
         for(auto i=0; i<swzDst.Count; ++i)
         {
-            std::string cmd = baseDst + "." + swzDst.Pattern[i] + " = ( " 
-                                + modOp0[i] + " > 0 ) ? " 
-                                + modOp1[i] + " : "
-                                + modOp2[i] + ";\n";
+            if (!absOp0.empty())
+            { modOp0[i] = absOp0 + modOp0[i] + ")"; }
+            if (!absOp1.empty())
+            { modOp1[i] = absOp1 + modOp1[i] + ")"; }
+            if (!absOp2.empty())
+            { modOp2[i] = absOp2 + modOp2[i] + ")"; }
+
+            std::string value = "( " + modOp0[i] + " > 0 ) ? "
+                              + modOp1[i] + " : "
+                              + modOp2[i];
+            std::string cmd = baseDst + "." + swzDst.Pattern[i] + " = " + FilterSat( value, sat ) + ";\n";
             PushInstruction(cmd);
         }
     }
@@ -3594,22 +3413,14 @@ std::string AsmParser::FilterSat(std::string value, bool sat)
 //-------------------------------------------------------------------------------------------------
 //      指定された部分文字列を含むかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
-bool AsmParser::FindTag(std::string value)
-{
-    std::string token = m_Tokenizer.GetAsChar();
-    auto pos = token.find(value);
-    return (pos != std::string::npos) && (pos == 0);
-}
+bool AsmParser::FindTag(std::string_view tag)
+{ return m_Tokenizer.StartsWith(tag); }
 
 //-------------------------------------------------------------------------------------------------
 //      指定された部分文字列を含むかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
-bool AsmParser::ContainTag(std::string value)
-{
-    std::string token = m_Tokenizer.GetAsChar();
-    auto pos = token.find(value);
-    return (pos != std::string::npos);
-}
+bool AsmParser::ContainTag(std::string_view tag)
+{ return m_Tokenizer.Contain(tag); }
 
 void AsmParser::PushInstruction(const std::string& cmd)
 {
@@ -3676,6 +3487,23 @@ void AsmParser::GenerateCode(std::string& sourceCode)
         sourceCode += "\n\n";
     }
 
+    // パッチ定数データ書き込み.
+    if (m_Reflection.HasPatchConstant())
+    {
+        sourceCode += "//-------------------------------------------------------------------------------------------------\n";
+        sourceCode += "// Patch Constant Definitions.\n";
+        sourceCode += "//-------------------------------------------------------------------------------------------------\n";
+
+        sourceCode += StringHelper::Format("struct %sPatchConstant\n", kShaderTag[m_ShaderType].c_str());
+        sourceCode += "{\n";
+        const auto& code = m_Reflection.GetDefPatchConstantSignature();
+        for( auto& itr : code )
+        { sourceCode += StringHelper::Format("    %s", itr.c_str()); }
+        sourceCode += "};\n";
+
+        sourceCode += "\n\n";
+    }
+
     if (m_Reflection.HasStructure())
     {
         sourceCode += "//-------------------------------------------------------------------------------------------------\n";
@@ -3828,6 +3656,11 @@ void AsmParser::GenerateCode(std::string& sourceCode)
         }
 
         sourceCode += StringHelper::Format("%s %s(%sInput input", returnType.c_str(), m_Argument.EntryPoint.c_str(), kShaderTag[m_ShaderType].c_str());
+
+        // ドメインシェーダはパッチ定数 (vpc#) を引数で受け取る.
+        if (m_ShaderType == SHADER_TYPE_DOMAIN && m_Reflection.HasPatchConstant())
+        { sourceCode += StringHelper::Format(", %sPatchConstant patch", kShaderTag[m_ShaderType].c_str()); }
+
         const auto& args = m_Reflection.GetDefInputArgs();
         if (!args.empty())
         {
@@ -3869,43 +3702,66 @@ void AsmParser::GenerateCode(std::string& sourceCode)
 //-------------------------------------------------------------------------------------------------
 bool AsmParser::WriteCode(const std::string& sourceCode)
 {
-    FILE* pFile;
-
-    std::string filename = m_Argument.Output;
+    // パックに追記する場合はシェーダ毎のファイルは作らない.
+    if (m_Argument.pPack != nullptr)
     {
-        std::string ext[] = {
-            "_vs.hlsl",
-            "_ps.hlsl",
-            "_gs.hlsl",
-            "_ds.hlsl",
-            "_hs.hlsl",
-            "_cs.hlsl"
-        };
+        auto name = GetEntryName(m_Argument.Output + kOutputSuffix[m_ShaderType]);
+        return m_Argument.pPack->Append(m_Argument.PackSequence, name, m_ShaderType, sourceCode);
+    }
 
-        filename = m_Argument.Output + ext[m_ShaderType];
+    // 標準出力の場合は一時ファイルを介さずそのまま流す.
+    if (m_Argument.Output == kStandardStream)
+    {
+        auto written = fwrite(sourceCode.data(), 1, sourceCode.size(), stdout);
+        return (written == sourceCode.size()) && (fflush(stdout) == 0);
     }
 
-    auto err = fopen_s(&pFile, filename.c_str(), "w");
+    FILE* pFile;
+
+    std::string filename = m_Argument.Output + kOutputSuffix[m_ShaderType];
+
+    // キャッシュには同じバイト列を保存するので，改行コードを変換させない.
+    auto err = fopen_s(&pFile, filename.c_str(), "wb");
     if (err != 0)
     { return false; }
 
-    fwrite(sourceCode.data(), sourceCode.size(), 1, pFile);
-    fclose(pFile);
+    auto written = fwrite(sourceCode.data(), 1, sourceCode.size(), pFile);
+    auto closed  = fclose(pFile);
 
-    return true;
+    return (written == sourceCode.size()) && (closed == 0);
 }
 
 //-------------------------------------------------------------------------------------------------
 //      HLSLアセンブリをHLSLコードに変換します.
 //-------------------------------------------------------------------------------------------------
 bool AsmParser::Convert(const Argument& args)
+{ return Convert(args, nullptr, 0); }
+
+//-------------------------------------------------------------------------------------------------
+//      メモリ上のHLSLアセンブリをHLSLコードに変換します.
+//-------------------------------------------------------------------------------------------------
+bool AsmParser::Convert(const Argument& args, const char* pSource, size_t size)
 {
     bool attach = false;
     m_Argument = args;
 
-    m_Indent = 0;
+    // 前回の変換結果を引き継がないようにリセット.
+    ReleaseAsm();
+    m_Instructions.clear();
+    m_Reflection.Clear();
+    m_ShaderProfile.clear();
+    m_Indent             = 0;
+    m_ThreadCountX       = 1;
+    m_ThreadCountY       = 1;
+    m_ThreadCountZ       = 1;
+    m_HasGetResourceInfo = false;
 
-    if (m_Argument.Output.empty())
+    // 標準入力から読む場合の出力先は標準出力とする.
+    if (m_Argument.Output.empty() && m_Argument.Input == kStandardStream)
+    {
+        m_Argument.Output = kStandardStream;
+    }
+    else if (m_Argument.Output.empty())
     {
         attach = true;
         m_Argument.Output = m_Argument.Input;
@@ -3914,6 +3770,69 @@ bool AsmParser::Convert(const Argument& args)
         { m_Argument.Output = m_Argument.Input.substr(0, pos); }
     }
 
+    // バンドルから切り出したシェーダは終端されていないので，null終端したコピーを解析する.
+    if (pSource != nullptr)
+    {
+        m_SourceBuffer.assign(pSource, pSource + size);
+        m_SourceBuffer.push_back('\0');
+
+        m_pBuffer    = m_SourceBuffer.data();
+        m_BufferSize = size;
+    }
+
+    // ファイルへの出力と同じバイト列になるように，標準出力でも改行コードを変換させない.
+    if (m_Argument.Output == kStandardStream)
+    { _setmode(_fileno(stdout), _O_BINARY); }
+
+    // 入力内容と変換オプションが同じであればキャッシュ済みの出力をそのまま使う.
+    uint64_t cacheKey = 0;
+    if (!m_Argument.CacheDir.empty() && m_Cache.Init(m_Argument.CacheDir, m_Argument.CacheSize))
+    {
+        if (m_pBuffer != nullptr || LoadAsm(m_Argument.Input.c_str()))
+        {
+            cacheKey = OutputCache::ComputeHash(m_pBuffer, m_BufferSize);
+            cacheKey = OutputCache::ComputeHash(kToolVersion, sizeof(kToolVersion), cacheKey);
+            cacheKey = OutputCache::ComputeHash(m_Argument.EntryPoint.c_str(), m_Argument.EntryPoint.size() + 1, cacheKey);
+
+            // リフレクションを別ファイルから読む場合はその内容も出力に影響する.
+            MappedFile reflection;
+            auto restore = !m_Argument.CheckReflection;
+            if (!m_Argument.Reflection.empty())
+            {
+                restore = restore && reflection.Open(m_Argument.Reflection.c_str());
+                cacheKey = OutputCache::ComputeHash(reflection.GetData(), reflection.GetSize(), cacheKey);
+            }
+
+            // 照合モードは実際に変換しないと意味が無いので登録のみ行う.
+            uint32_t shaderType = 0;
+            for(auto& suffix : kOutputSuffix)
+            {
+                bool hit;
+                if (m_Argument.pPack != nullptr)
+                {
+                    std::string code;
+                    hit = restore && m_Cache.Load(cacheKey, suffix, code)
+                       && m_Argument.pPack->Append(m_Argument.PackSequence, GetEntryName(m_Argument.Output + suffix), shaderType, code);
+                }
+                else if (m_Argument.Output == kStandardStream)
+                { hit = restore && m_Cache.Restore(cacheKey, suffix, stdout); }
+                else
+                { hit = restore && m_Cache.Restore(cacheKey, suffix, m_Argument.Output + suffix); }
+
+                shaderType++;
+                if (hit)
+                {
+                    ReleaseAsm();
+                    return true;
+                }
+            }
+        }
+    }
+    else
+    {
+        m_Cache.Term();
+    }
+
     auto ret = Parse();
     if (!ret)
     {
@@ -3930,10 +3849,16 @@ bool AsmParser::Convert(const Argument& args)
     {
         ELOG( "Error : Convert Failed." );
     }
+    else if (m_Cache.IsEnabled())
+    {
+        // キャッシュへの登録に失敗しても変換自体は成功しているので無視する.
+        m_Cache.Store(cacheKey, kOutputSuffix[m_ShaderType], sourceCode);
+    }
 
+    // トークンバッファは次の変換で再利用するため解放しない.
     m_Instructions.clear();
-    m_Tokenizer.Term();
     m_Reflection.Clear();
+    ReleaseAsm();
 
     if (!ret)
     {
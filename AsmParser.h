@@ -9,12 +9,21 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include "Tokenizer.h"
+#include "MappedFile.h"
+#include "OutputCache.h"
+#include "LineIndex.h"
+#include "Opcode.h"
+#include <cstdio>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include "Reflection.h"
 
 
+class PackWriter;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // SHADER_TYPE enum
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,9 +54,16 @@ public:
     //=============================================================================================
     struct Argument
     {
-        std::string Input;      // asm file path.
-        std::string Output;     // hlsl file path.
+        std::string Input;      // asm file path ("-" reads stdin).
+        std::string Output;     // hlsl file path ("-" writes stdout).
         std::string EntryPoint; // entry point name.
+        bool        DisableMapping; // read input via fread instead of memory mapping.
+        std::string CacheDir;   // output cache directory (empty disables cache).
+        uint64_t    CacheSize;  // output cache capacity in bytes (0 means default).
+        std::string Reflection; // compiled shader to read reflection from (empty uses the asm comment header).
+        bool        CheckReflection; // compare the compiled shader reflection with the asm comment header.
+        PackWriter* pPack;      // append outputs to this pack instead of writing hlsl files (nullptr disables).
+        size_t      PackSequence; // order of this conversion in the pack data (see PackWriter::Append).
     };
 
     //=============================================================================================
@@ -57,18 +73,29 @@ public:
     ~AsmParser();
 
     bool Convert(const Argument& args);
+    bool Convert(const Argument& args, const char* pSource, size_t size); // pSource is converted instead of args.Input.
 
 private:
     //=============================================================================================
     // private variables.
     //=============================================================================================
-    char*                       m_pBuffer       = nullptr;
+    const char*                 m_pBuffer       = nullptr;
+    char*                       m_pHeapBuffer   = nullptr;
     size_t                      m_BufferSize    = 0;
+    MappedFile                  m_MappedFile;
+    OutputCache                 m_Cache;
     Tokenizer                   m_Tokenizer;
+    LineIndex                   m_LineIndex;
     Argument                    m_Argument;
     a3d::Reflection             m_Reflection;
     std::string                 m_ShaderProfile;
+    std::vector<a3d::Instruction> m_Program;
+    const char*                 m_pProgramText  = nullptr;  // 命令のオペランド位置の基準となるテキスト.
+    const a3d::Instruction*     m_pInstruction  = nullptr;  // 変換中の命令.
+    uint32_t                    m_OperandIndex  = 0;        // 変換中の命令で次に取り出すオペランド.
     std::vector<std::string>    m_Instructions;
+    std::string                 m_OperandText;              // バイナリからデコードした命令のオペランド.
+    std::vector<char>           m_SourceBuffer;
     SHADER_TYPE                 m_ShaderType    = SHADER_TYPE_VERTEX;
     int                         m_Indent        = 0;
 
@@ -80,19 +107,28 @@ private:
     bool m_ResourceSection      = false;
     bool m_InputSection         = false;;
     bool m_OutputSection        = false;
+    bool m_PatchConstantSection = false;
     bool m_HasGetResourceInfo   = false;
 
     //=============================================================================================
     // private methods.
     //=============================================================================================
     bool LoadAsm(const char* filename);
-    void ParseAsm();
-    bool ParseInstructionSM4();
-    bool ParseInstructionSM5();
+    bool ReadAsm(const char* filename);
+    bool ReadStream(FILE* pStream);
+    void ReleaseAsm();
+    void ParseAsm(const char* pText, size_t firstLine);
+    void DecodeAsm(const char* pText, size_t firstLine);
+    void EmitAsm();
+    void ParseModifier(a3d::Modifier& modifier);
+    void SkipGroup();
+    bool ParseInstruction(const a3d::OpcodeInfo& info, const a3d::Modifier& modifier);
+    bool ParseInstructionSM4(a3d::OPCODE_TYPE opcode, const a3d::Modifier& modifier);
+    bool ParseInstructionSM5(a3d::OPCODE_TYPE opcode, const a3d::Modifier& modifier);
 
+    std::string_view NextOperand();
     std::string GetOperand();
     std::string GetOperand(const a3d::SwizzleInfo& info);
-    std::string GetArgs();
 
     a3d::SwizzleInfo Get1(std::string& op0);
     a3d::SwizzleInfo Get2(std::string& op0, std::string& op1);
@@ -100,25 +136,12 @@ private:
     a3d::SwizzleInfo Get4(std::string& op0, std::string& op1, std::string& op2, std::string& op3);
     a3d::SwizzleInfo Get5(std::string& op0, std::string& op1, std::string& op2, std::string& op3, std::string& op4);
     a3d::SwizzleInfo Get6(std::string& op0, std::string& op1, std::string& op2, std::string& op3, std::string& op4, std::string& op5);
-    void GetSample0(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord );
-    void GetSample1(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& arg1);
-    void GetSample2(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& arg1, std::string& arg2);
-    void GetSampleOffset0(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& offset);
-    void GetSampleOffset1(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& offset, std::string& arg1);
-    void GetSampleOffset2(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& offset, std::string& arg1, std::string& arg2);
-    void GetSampleIndexable0(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord);
-    void GetSampleIndexable1(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& arg1);
-    void GetSampleIndexable2(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& args1, std::string& arg2);
-    void GetSampleOffsetIndexable0(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& offset);
-    void GetSampleOffsetIndexable1(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& offset, std::string& arg1);
-    void GetSampleOffsetIndexable2(std::string& dst, std::string& texture, std::string& sampler, std::string& texcoord, std::string& offset, std::string& args1, std::string& arg2);
-    void GetLoad(std::string& dest, std::string& texture, std::string& texcoord);
-    void GetLoadOffset(std::string& dest, std::string& texture, std::string& texcoord, std::string& offset);
+    int  GetLoad(std::string& dest, std::string& texture, std::string& texcoord);
     void GetResInfo(std::string& dest, std::string& texture, std::string& mipLevel);
+    void PushSample(const a3d::OpcodeInfo& info, const a3d::Modifier& modifier, bool sat);
     void PushDp(int count, bool sat);
-    void PushCmd2(std::string tag, bool sat); // A = tag( B );
-    void PushCmd3(std::string tag, bool sat); // A = tag( B, C );
-    void PushCmd4(std::string tag, bool sat); // A = tag( B, C, D );
+    template<int Count>
+    void PushCmd(std::string_view tag, bool sat); // A = tag( B, ... );  Count は入力オペランド数.
     void PushOp2(std::string tag, bool sat);  // A = B tag C;      <ex> A = B + C;
     void PushOp3(std::string tag1, std::string tag2, bool sat); // A = B tag1 C tag2 D  <ex> A = B + C * D;
     void PushCmp(std::string op, bool integer);
@@ -129,9 +152,12 @@ private:
     void PushMov(bool sat);
     void PushMovc(bool sat);
     std::string FilterSat(std::string value, bool sat);
-    bool FindTag(std::string tag);  // 先頭からの部分一致であるので注意. 完全一致は m_Tokenizer.Compare()を使用する.
-    bool ContainTag(std::string tag);
+    bool FindTag(std::string_view tag);  // 先頭からの部分一致であるので注意. 完全一致は m_Tokenizer.Compare()を使用する.
+    bool ContainTag(std::string_view tag);
     bool Parse();
+    void ParseHeader(a3d::Reflection& reflection);
+    bool ParseDxbc();
+    bool LoadReflection(const std::string& filename, a3d::Reflection& reflection);
     void GenerateCode(std::string& sourceCode);
     bool WriteCode(const std::string& sourceCode);
 
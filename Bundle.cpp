@@ -0,0 +1,162 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Bundle.cpp
+// Desc : Multi Shader Bundle Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "Bundle.h"
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------
+//      シェーダプロファイル行 (vs_5_0 など) かどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool IsProfileLine(const char* pHead, const char* pTail)
+{
+    // hs_decls 等のハルシェーダのフェーズ宣言と区別するため，数字が続くことも確認する.
+    if (pTail - pHead < 4)
+    { return false; }
+
+    return strchr("vpghdc", pHead[0]) != nullptr
+        && pHead[1] == 's'
+        && pHead[2] == '_'
+        && isdigit(static_cast<unsigned char>(pHead[3]));
+}
+
+} // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Bundle class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+Bundle::Bundle()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+Bundle::~Bundle()
+{ Close(); }
+
+//-------------------------------------------------------------------------------------------------
+//      ファイルを開いてシェーダ毎に分割します.
+//-------------------------------------------------------------------------------------------------
+bool Bundle::Open(const char* filename, bool disableMapping)
+{
+    Close();
+
+    // 分割したシェーダはファイルを参照するだけなので，巨大なファイルでもコピーしない.
+    if (!disableMapping && m_MappedFile.Open(filename))
+    {
+        Split(m_MappedFile.GetData(), m_MappedFile.GetSize());
+        return true;
+    }
+
+    FILE* pFile;
+    if (fopen_s(&pFile, filename, "rb") != 0)
+    { return false; }
+
+    fseek(pFile, 0, SEEK_END);
+    auto endpos = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+
+    if (endpos > 0)
+    {
+        m_Buffer.resize(static_cast<size_t>(endpos));
+        m_Buffer.resize(fread(m_Buffer.data(), sizeof(char), m_Buffer.size(), pFile));
+    }
+
+    fclose(pFile);
+
+    Split(m_Buffer.data(), m_Buffer.size());
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ファイルを閉じます.
+//-------------------------------------------------------------------------------------------------
+void Bundle::Close()
+{
+    m_Segments.clear();
+    m_Buffer.clear();
+    m_MappedFile.Close();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      分割したシェーダを取得します.
+//-------------------------------------------------------------------------------------------------
+const std::vector<Bundle::Segment>& Bundle::GetSegments() const
+{ return m_Segments; }
+
+//-------------------------------------------------------------------------------------------------
+//      シェーダの境界を求めて分割します.
+//-------------------------------------------------------------------------------------------------
+void Bundle::Split(const char* pData, size_t size)
+{
+    m_Segments.clear();
+    if (size == 0)
+    { return; }
+
+    // 各シェーダは "リフレクションのコメント → プロファイル行 → 命令列" の順に並ぶので，
+    // 2つ目以降のプロファイル行の直前にあるコメントの先頭を境界とする.
+    auto pSegment = pData;
+    auto pEnd     = pData + size;
+    auto pCur     = pData;
+
+    const char* pComment = nullptr;
+    bool hasProfile = false;
+
+    while (pCur < pEnd)
+    {
+        // 行の範囲を求める.
+        auto pHead = pCur;
+        auto pTail = static_cast<const char*>(memchr(pCur, '\n', pEnd - pCur));
+        if (pTail == nullptr)
+        { pTail = pEnd; }
+        pCur = (pTail < pEnd) ? pTail + 1 : pEnd;
+
+        // 行頭の空白は飛ばす.
+        auto pText = pHead;
+        while (pText < pTail && (*pText == ' ' || *pText == '\t' || *pText == '\r'))
+        { pText++; }
+
+        // 空行はコメントの連続を途切れさせない.
+        if (pText == pTail)
+        { continue; }
+
+        if (pTail - pText >= 2 && pText[0] == '/' && pText[1] == '/')
+        {
+            if (pComment == nullptr)
+            { pComment = pHead; }
+            continue;
+        }
+
+        if (IsProfileLine(pText, pTail))
+        {
+            if (hasProfile)
+            {
+                // ヘッダの無いシェーダはプロファイル行を境界とする.
+                auto pBoundary = (pComment != nullptr) ? pComment : pHead;
+                m_Segments.push_back({ pSegment, static_cast<size_t>(pBoundary - pSegment) });
+                pSegment = pBoundary;
+            }
+
+            hasProfile = true;
+        }
+
+        pComment = nullptr;
+    }
+
+    m_Segments.push_back({ pSegment, static_cast<size_t>(pEnd - pSegment) });
+}
@@ -0,0 +1,77 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Bundle.h
+// Desc : Multi Shader Bundle Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "MappedFile.h"
+#include <cstddef>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Bundle class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Bundle
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    struct Segment
+    {
+        const char*     pData;  //!< シェーダ1つ分の先頭 (null終端されていません).
+        size_t          Size;   //!< シェーダ1つ分のサイズ.
+    };
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+    Bundle();
+    ~Bundle();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      複数のシェーダを連結したアセンブリファイルを開き，シェーダ毎に分割します.
+    //!
+    //! @param[in]      filename        ファイル名.
+    //! @param[in]      disableMapping  メモリマッピングを使わずに読み込む場合は true.
+    //! @retval true    読み込みに成功.
+    //! @retval false   読み込みに失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Open(const char* filename, bool disableMapping);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ファイルを閉じます.
+    //---------------------------------------------------------------------------------------------
+    void Close();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      分割したシェーダを取得します.
+    //---------------------------------------------------------------------------------------------
+    const std::vector<Segment>& GetSegments() const;
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    MappedFile              m_MappedFile;   //!< マッピングしたファイル.
+    std::vector<char>       m_Buffer;       //!< マッピングしない場合の読み込み先.
+    std::vector<Segment>    m_Segments;     //!< 分割したシェーダ.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    void Split(const char* pData, size_t size);
+
+    Bundle          (const Bundle&) = delete;
+    void operator = (const Bundle&) = delete;
+};
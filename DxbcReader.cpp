@@ -0,0 +1,2175 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : DxbcReader.cpp
+// Desc : DXBC Container Reader Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "DxbcReader.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+const size_t    kHeaderSize     = 32;       // "DXBC" + チェックサム(16) + バージョン + 全体サイズ + チャンク数.
+const size_t    kChunkHeader    = 8;        // 識別子 + サイズ.
+
+// リソース定義 (RDEF).
+const size_t    kRdefHeaderSize         = 28;       // 定数バッファ数/位置 + バインド数/位置 + バージョン + フラグ + 作成者.
+const size_t    kRdefBufferStride       = 24;       // 名前, 変数数, 変数位置, サイズ, フラグ, 種別.
+const size_t    kRdefBindStride         = 32;       // 名前, 種別, 戻り値型, 次元, サンプル数, レジスタ, 数, フラグ.
+const size_t    kRdefMemberStride       = 12;       // 名前, 型位置, オフセット.
+const uint32_t  kMaxBufferSize          = 4096 * 16;
+const uint32_t  kMaxBindSlot            = 128;
+
+const uint32_t  CBUFFER_TYPE_INTERFACE_POINTERS = 2;
+const uint32_t  CBUFFER_TYPE_RESOURCE_BIND_INFO = 3;
+
+const uint32_t  VARIABLE_CLASS_VECTOR           = 1;
+const uint32_t  VARIABLE_CLASS_MATRIX_ROWS      = 2;
+const uint32_t  VARIABLE_CLASS_MATRIX_COLUMNS   = 3;
+const uint32_t  VARIABLE_CLASS_STRUCT           = 5;
+
+const uint32_t  VARIABLE_TYPE_DOUBLE            = 39;
+
+const uint32_t  INPUT_CBUFFER                   = 0;
+const uint32_t  INPUT_TBUFFER                   = 1;
+const uint32_t  INPUT_SAMPLER                   = 3;
+const uint32_t  INPUT_STRUCTURED                = 5;
+const uint32_t  INPUT_BYTEADDRESS               = 7;
+const uint32_t  INPUT_UAV_RWBYTEADDRESS         = 8;
+
+const uint32_t  INPUT_FLAG_COMPARISON_SAMPLER   = 0x2;
+
+// オペコード.
+const uint32_t  OPCODE_BREAKC           = 3;
+const uint32_t  OPCODE_CALLC            = 5;
+const uint32_t  OPCODE_CONTINUEC        = 8;
+const uint32_t  OPCODE_DISCARD          = 13;
+const uint32_t  OPCODE_IF               = 31;
+const uint32_t  OPCODE_CUSTOMDATA       = 53;
+const uint32_t  OPCODE_RESINFO          = 61;
+const uint32_t  OPCODE_RETC             = 63;
+const uint32_t  OPCODE_SAMPLE_INFO      = 111;
+const uint32_t  OPCODE_INTERFACE_CALL   = 120;
+const uint32_t  OPCODE_SYNC             = 190;
+
+// オペランドの種別.
+const uint32_t  OPERAND_INPUT                   = 1;
+const uint32_t  OPERAND_IMMEDIATE32             = 4;
+const uint32_t  OPERAND_IMMEDIATE64             = 5;
+const uint32_t  OPERAND_IMMEDIATE_CONSTANT_BUFFER = 9;
+const uint32_t  OPERAND_INPUT_CONTROL_POINT     = 25;
+const uint32_t  OPERAND_OUTPUT_CONTROL_POINT    = 26;
+
+// インデックスの表現形式.
+const uint32_t  INDEX_IMMEDIATE32               = 0;
+const uint32_t  INDEX_IMMEDIATE64               = 1;
+const uint32_t  INDEX_RELATIVE                  = 2;
+const uint32_t  INDEX_IMMEDIATE32_PLUS_RELATIVE = 3;
+const uint32_t  INDEX_IMMEDIATE64_PLUS_RELATIVE = 4;
+
+// 拡張オペコードの種別.
+const uint32_t  EXTENDED_SAMPLE_CONTROLS        = 1;
+const uint32_t  EXTENDED_RESOURCE_DIM           = 2;
+const uint32_t  EXTENDED_RESOURCE_RETURN_TYPE   = 3;
+
+// カスタムデータの種別.
+const uint32_t  CUSTOMDATA_IMMEDIATE_CONSTANT_BUFFER = 3;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// VALUE_HINT enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum VALUE_HINT
+{
+    HINT_NONE = 0,      // オペランドを持たない.
+    HINT_FLOAT,         // 浮動小数点として表示.
+    HINT_INT,           // 符号付き整数として表示.
+    HINT_UINT,          // 符号無し整数として表示.
+    HINT_BITS,          // ビット列として表示.
+    HINT_ANY,           // 値から推測して表示.
+    HINT_DOUBLE,        // 倍精度浮動小数点として表示.
+    HINT_DECL,          // 宣言 (個別に解釈する).
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpcodeInfo structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct OpcodeInfo
+{
+    const char*     Name;   // ニーモニック.
+    VALUE_HINT      Hint;   // 即値の表示方法.
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      オペコードテーブルです (D3D10_SB_OPCODE_TYPE / D3D11_SB_OPCODE_TYPE 順).
+//-------------------------------------------------------------------------------------------------
+const OpcodeInfo kOpcodeTable[] = {
+    { "add"                     , HINT_FLOAT  },    // 0
+    { "and"                     , HINT_BITS   },
+    { "break"                   , HINT_NONE   },
+    { "breakc"                  , HINT_INT    },
+    { "call"                    , HINT_INT    },
+    { "callc"                   , HINT_INT    },
+    { "case"                    , HINT_INT    },
+    { "continue"                , HINT_NONE   },
+    { "continuec"               , HINT_INT    },
+    { "cut"                     , HINT_NONE   },
+    { "default"                 , HINT_NONE   },    // 10
+    { "deriv_rtx"               , HINT_FLOAT  },
+    { "deriv_rty"               , HINT_FLOAT  },
+    { "discard"                 , HINT_INT    },
+    { "div"                     , HINT_FLOAT  },
+    { "dp2"                     , HINT_FLOAT  },
+    { "dp3"                     , HINT_FLOAT  },
+    { "dp4"                     , HINT_FLOAT  },
+    { "else"                    , HINT_NONE   },
+    { "emit"                    , HINT_NONE   },
+    { "emitThenCut"             , HINT_NONE   },    // 20
+    { "endif"                   , HINT_NONE   },
+    { "endloop"                 , HINT_NONE   },
+    { "endswitch"               , HINT_NONE   },
+    { "eq"                      , HINT_FLOAT  },
+    { "exp"                     , HINT_FLOAT  },
+    { "frc"                     , HINT_FLOAT  },
+    { "ftoi"                    , HINT_FLOAT  },
+    { "ftou"                    , HINT_FLOAT  },
+    { "ge"                      , HINT_FLOAT  },
+    { "iadd"                    , HINT_INT    },    // 30
+    { "if"                      , HINT_INT    },
+    { "ieq"                     , HINT_INT    },
+    { "ige"                     , HINT_INT    },
+    { "ilt"                     , HINT_INT    },
+    { "imad"                    , HINT_INT    },
+    { "imax"                    , HINT_INT    },
+    { "imin"                    , HINT_INT    },
+    { "imul"                    , HINT_INT    },
+    { "ine"                     , HINT_INT    },
+    { "ineg"                    , HINT_INT    },    // 40
+    { "ishl"                    , HINT_INT    },
+    { "ishr"                    , HINT_INT    },
+    { "itof"                    , HINT_INT    },
+    { "label"                   , HINT_INT    },
+    { "ld"                      , HINT_INT    },
+    { "ld_ms"                   , HINT_INT    },
+    { "log"                     , HINT_FLOAT  },
+    { "loop"                    , HINT_NONE   },
+    { "lt"                      , HINT_FLOAT  },
+    { "mad"                     , HINT_FLOAT  },    // 50
+    { "min"                     , HINT_FLOAT  },
+    { "max"                     , HINT_FLOAT  },
+    { nullptr                   , HINT_NONE   },    // customdata.
+    { "mov"                     , HINT_ANY    },
+    { "movc"                    , HINT_ANY    },
+    { "mul"                     , HINT_FLOAT  },
+    { "ne"                      , HINT_FLOAT  },
+    { "nop"                     , HINT_NONE   },
+    { "not"                     , HINT_BITS   },
+    { "or"                      , HINT_BITS   },    // 60
+    { "resinfo"                 , HINT_UINT   },
+    { "ret"                     , HINT_NONE   },
+    { "retc"                    , HINT_INT    },
+    { "round_ne"                , HINT_FLOAT  },
+    { "round_ni"                , HINT_FLOAT  },
+    { "round_pi"                , HINT_FLOAT  },
+    { "round_z"                 , HINT_FLOAT  },
+    { "rsq"                     , HINT_FLOAT  },
+    { "sample"                  , HINT_FLOAT  },
+    { "sample_c"                , HINT_FLOAT  },    // 70
+    { "sample_c_lz"             , HINT_FLOAT  },
+    { "sample_l"                , HINT_FLOAT  },
+    { "sample_d"                , HINT_FLOAT  },
+    { "sample_b"                , HINT_FLOAT  },
+    { "sqrt"                    , HINT_FLOAT  },
+    { "switch"                  , HINT_INT    },
+    { "sincos"                  , HINT_FLOAT  },
+    { "udiv"                    , HINT_UINT   },
+    { "ult"                     , HINT_UINT   },
+    { "uge"                     , HINT_UINT   },    // 80
+    { "umul"                    , HINT_UINT   },
+    { "umad"                    , HINT_UINT   },
+    { "umax"                    , HINT_UINT   },
+    { "umin"                    , HINT_UINT   },
+    { "ushr"                    , HINT_UINT   },
+    { "utof"                    , HINT_UINT   },
+    { "xor"                     , HINT_BITS   },
+    { "dcl_resource"            , HINT_DECL   },
+    { "dcl_constantbuffer"      , HINT_DECL   },
+    { "dcl_sampler"             , HINT_DECL   },    // 90
+    { "dcl_indexRange"          , HINT_DECL   },
+    { "dcl_outputTopology"      , HINT_DECL   },
+    { "dcl_inputPrimitive"      , HINT_DECL   },
+    { "dcl_maxOutputVertexCount", HINT_DECL   },
+    { "dcl_input"               , HINT_DECL   },
+    { "dcl_input_sgv"           , HINT_DECL   },
+    { "dcl_input_siv"           , HINT_DECL   },
+    { "dcl_input_ps"            , HINT_DECL   },
+    { "dcl_input_ps_sgv"        , HINT_DECL   },
+    { "dcl_input_ps_siv"        , HINT_DECL   },    // 100
+    { "dcl_output"              , HINT_DECL   },
+    { "dcl_output_sgv"          , HINT_DECL   },
+    { "dcl_output_siv"          , HINT_DECL   },
+    { "dcl_temps"               , HINT_DECL   },
+    { "dcl_indexableTemp"       , HINT_DECL   },
+    { "dcl_globalFlags"         , HINT_DECL   },
+    { nullptr                   , HINT_NONE   },    // reserved.
+    { "lod"                     , HINT_FLOAT  },
+    { "gather4"                 , HINT_FLOAT  },
+    { "samplepos"               , HINT_INT    },    // 110
+    { "sampleinfo"              , HINT_UINT   },
+    { nullptr                   , HINT_NONE   },    // reserved.
+    { "hs_decls"                , HINT_NONE   },
+    { "hs_control_point_phase"  , HINT_NONE   },
+    { "hs_fork_phase"           , HINT_NONE   },
+    { "hs_join_phase"           , HINT_NONE   },
+    { "emit_stream"             , HINT_NONE   },
+    { "cut_stream"              , HINT_NONE   },
+    { "emitThenCut_stream"      , HINT_NONE   },
+    { "fcall"                   , HINT_INT    },    // 120
+    { "bufinfo"                 , HINT_UINT   },
+    { "deriv_rtx_coarse"        , HINT_FLOAT  },
+    { "deriv_rtx_fine"          , HINT_FLOAT  },
+    { "deriv_rty_coarse"        , HINT_FLOAT  },
+    { "deriv_rty_fine"          , HINT_FLOAT  },
+    { "gather4_c"               , HINT_FLOAT  },
+    { "gather4_po"              , HINT_FLOAT  },
+    { "gather4_po_c"            , HINT_FLOAT  },
+    { "rcp"                     , HINT_FLOAT  },
+    { "f32tof16"                , HINT_FLOAT  },    // 130
+    { "f16tof32"                , HINT_UINT   },
+    { "uaddc"                   , HINT_UINT   },
+    { "usubb"                   , HINT_UINT   },
+    { "countbits"               , HINT_UINT   },
+    { "firstbit_hi"             , HINT_UINT   },
+    { "firstbit_lo"             , HINT_UINT   },
+    { "firstbit_shi"            , HINT_INT    },
+    { "ubfe"                    , HINT_UINT   },
+    { "ibfe"                    , HINT_INT    },
+    { "bfi"                     , HINT_UINT   },    // 140
+    { "bfrev"                   , HINT_UINT   },
+    { "swapc"                   , HINT_ANY    },
+    { "dcl_stream"              , HINT_DECL   },
+    { "dcl_function_body"       , HINT_DECL   },
+    { "dcl_function_table"      , HINT_DECL   },
+    { "dcl_interface"           , HINT_DECL   },
+    { "dcl_input_control_point_count"       , HINT_DECL },
+    { "dcl_output_control_point_count"      , HINT_DECL },
+    { "dcl_tessellator_domain"              , HINT_DECL },
+    { "dcl_tessellator_partitioning"        , HINT_DECL },  // 150
+    { "dcl_tessellator_output_primitive"    , HINT_DECL },
+    { "dcl_hs_max_tessfactor"               , HINT_DECL },
+    { "dcl_hs_fork_phase_instance_count"    , HINT_DECL },
+    { "dcl_hs_join_phase_instance_count"    , HINT_DECL },
+    { "dcl_thread_group"        , HINT_DECL   },
+    { "dcl_uav_typed"           , HINT_DECL   },
+    { "dcl_uav_raw"             , HINT_DECL   },
+    { "dcl_uav_structured"      , HINT_DECL   },
+    { "dcl_tgsm_raw"            , HINT_DECL   },
+    { "dcl_tgsm_structured"     , HINT_DECL   },    // 160
+    { "dcl_resource_raw"        , HINT_DECL   },
+    { "dcl_resource_structured" , HINT_DECL   },
+    { "ld_uav_typed"            , HINT_UINT   },
+    { "store_uav_typed"         , HINT_ANY    },
+    { "ld_raw"                  , HINT_UINT   },
+    { "store_raw"               , HINT_ANY    },
+    { "ld_structured"           , HINT_UINT   },
+    { "store_structured"        , HINT_ANY    },
+    { "atomic_and"              , HINT_BITS   },
+    { "atomic_or"               , HINT_BITS   },    // 170
+    { "atomic_xor"              , HINT_BITS   },
+    { "atomic_cmp_store"        , HINT_UINT   },
+    { "atomic_iadd"             , HINT_INT    },
+    { "atomic_imax"             , HINT_INT    },
+    { "atomic_imin"             , HINT_INT    },
+    { "atomic_umax"             , HINT_UINT   },
+    { "atomic_umin"             , HINT_UINT   },
+    { "imm_atomic_alloc"        , HINT_UINT   },
+    { "imm_atomic_consume"      , HINT_UINT   },
+    { "imm_atomic_iadd"         , HINT_INT    },    // 180
+    { "imm_atomic_and"          , HINT_BITS   },
+    { "imm_atomic_or"           , HINT_BITS   },
+    { "imm_atomic_xor"          , HINT_BITS   },
+    { "imm_atomic_exch"         , HINT_UINT   },
+    { "imm_atomic_cmp_exch"     , HINT_UINT   },
+    { "imm_atomic_imax"         , HINT_INT    },
+    { "imm_atomic_imin"         , HINT_INT    },
+    { "imm_atomic_umax"         , HINT_UINT   },
+    { "imm_atomic_umin"         , HINT_UINT   },
+    { "sync"                    , HINT_NONE   },    // 190
+    { "dadd"                    , HINT_DOUBLE },
+    { "dmax"                    , HINT_DOUBLE },
+    { "dmin"                    , HINT_DOUBLE },
+    { "dmul"                    , HINT_DOUBLE },
+    { "deq"                     , HINT_DOUBLE },
+    { "dge"                     , HINT_DOUBLE },
+    { "dlt"                     , HINT_DOUBLE },
+    { "dne"                     , HINT_DOUBLE },
+    { "dmov"                    , HINT_DOUBLE },
+    { "dmovc"                   , HINT_DOUBLE },    // 200
+    { "dtof"                    , HINT_DOUBLE },
+    { "ftod"                    , HINT_FLOAT  },
+    { "eval_snapped"            , HINT_INT    },
+    { "eval_sample_index"       , HINT_INT    },
+    { "eval_centroid"           , HINT_FLOAT  },
+    { "dcl_gsinstances"         , HINT_DECL   },
+    { "abort"                   , HINT_NONE   },
+    { "debug_break"             , HINT_NONE   },
+    { nullptr                   , HINT_NONE   },    // reserved.
+    { "ddiv"                    , HINT_DOUBLE },    // 210
+    { "dfma"                    , HINT_DOUBLE },
+    { "drcp"                    , HINT_DOUBLE },
+    { "msad"                    , HINT_UINT   },
+    { "dtoi"                    , HINT_DOUBLE },
+    { "dtou"                    , HINT_DOUBLE },
+    { "itod"                    , HINT_INT    },
+    { "utod"                    , HINT_UINT   },
+};
+
+const size_t kOpcodeCount = sizeof(kOpcodeTable) / sizeof(kOpcodeTable[0]);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      オペランドの接頭辞テーブルです (D3D10_SB_OPERAND_TYPE 順).
+//-------------------------------------------------------------------------------------------------
+const char* kOperandPrefix[] = {
+    "r",                            // 0
+    "v",
+    "o",
+    "x",
+    "l",
+    "d",
+    "s",
+    "t",
+    "cb",
+    "icb",
+    "l",                            // 10
+    "vPrim",
+    "oDepth",
+    "null",
+    "rasterizer",
+    "oMask",
+    "m",
+    "fb",
+    "ft",
+    "fp",
+    "fi",                           // 20
+    "fo",
+    "vOutputControlPointID",
+    "vForkInstanceID",
+    "vJoinInstanceID",
+    "vicp",
+    "vocp",
+    "vpc",
+    "vDomain",
+    "this",
+    "u",                            // 30
+    "g",
+    "vThreadID",
+    "vThreadGroupID",
+    "vThreadIDInGroup",
+    "vCoverage",
+    "vThreadIDInGroupFlattened",
+    "vGSInstanceID",
+    "oDepthGE",
+    "oDepthLE",
+    "vCycleCounter",                // 40
+    "oStencilRef",
+    "vInnerCoverage",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      リソースの次元名テーブルです.
+//-------------------------------------------------------------------------------------------------
+const char* kResourceDimension[] = {
+    "unknown",
+    "buffer",
+    "texture1d",
+    "texture2d",
+    "texture2dms",
+    "texture3d",
+    "texturecube",
+    "texture1darray",
+    "texture2darray",
+    "texture2dmsarray",
+    "texturecubearray",
+    "raw_buffer",
+    "structured_buffer",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      リソースの戻り値型テーブルです.
+//-------------------------------------------------------------------------------------------------
+const char* kReturnType[] = {
+    "unknown",
+    "unorm",
+    "snorm",
+    "sint",
+    "uint",
+    "float",
+    "mixed",
+    "double",
+    "continued",
+    "unused",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      宣言で使われるシステム値名テーブルです (D3D10_SB_NAME 順).
+//-------------------------------------------------------------------------------------------------
+const char* kSystemName[] = {
+    "undefined",
+    "position",
+    "clip_distance",
+    "cull_distance",
+    "rendertarget_array_index",
+    "viewport_array_index",
+    "vertex_id",
+    "primitive_id",
+    "instance_id",
+    "is_front_face",
+    "sampleIndex",
+    "finalQuadUeq0EdgeTessFactor",
+    "finalQuadVeq0EdgeTessFactor",
+    "finalQuadUeq1EdgeTessFactor",
+    "finalQuadVeq1EdgeTessFactor",
+    "finalQuadUInsideTessFactor",
+    "finalQuadVInsideTessFactor",
+    "finalTriUeq0EdgeTessFactor",
+    "finalTriVeq0EdgeTessFactor",
+    "finalTriWeq0EdgeTessFactor",
+    "finalTriInsideTessFactor",
+    "finalLineDetailTessFactor",
+    "finalLineDensityTessFactor",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      ピクセルシェーダ入力の補間方法テーブルです.
+//-------------------------------------------------------------------------------------------------
+const char* kInterpolation[] = {
+    "",
+    "constant",
+    "linear",
+    "linear centroid",
+    "linear noperspective",
+    "linear noperspective centroid",
+    "linear sample",
+    "linear noperspective sample",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      プリミティブトポロジー名テーブルです.
+//-------------------------------------------------------------------------------------------------
+const char* kTopology[] = {
+    "undefined",
+    "pointlist",
+    "linelist",
+    "linestrip",
+    "trianglelist",
+    "trianglestrip",
+    "undefined",
+    "undefined",
+    "undefined",
+    "undefined",
+    "linelistadj",
+    "linestripadj",
+    "trianglelistadj",
+    "trianglestripadj",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      グローバルフラグ名テーブルです (ビット11から順).
+//-------------------------------------------------------------------------------------------------
+const char* kGlobalFlags[] = {
+    "refactoringAllowed",
+    "enableDoublePrecisionFloatOps",
+    "forceEarlyDepthStencil",
+    "enableRawAndStructuredBuffers",
+    "skipOptimization",
+    "enableMinimumPrecision",
+    "enable11_1DoubleExtensions",
+    "enable11_1ShaderExtensions",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      リソースバインディングの種別名テーブルです (D3D_SHADER_INPUT_TYPE 順).
+//-------------------------------------------------------------------------------------------------
+const char* kBindType[] = {
+    "cbuffer",
+    "tbuffer",
+    "texture",
+    "sampler",
+    "UAV",
+    "texture",
+    "UAV",
+    "texture",
+    "UAV",
+    "UAV",
+    "UAV",
+    "UAV",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      リソースバインディングの次元名テーブルです (D3D_SRV_DIMENSION 順).
+//-------------------------------------------------------------------------------------------------
+const char* kBindDimension[] = {
+    "NA",
+    "buf",
+    "1d",
+    "1darray",
+    "2d",
+    "2darray",
+    "2dMS",
+    "2dMSarray",
+    "3d",
+    "cube",
+    "cubearray",
+    "bufex",
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      シェーダ変数のスカラー型名テーブルです (D3D_SHADER_VARIABLE_TYPE 順).
+//-------------------------------------------------------------------------------------------------
+const char* kVariableType[] = {
+    "void",
+    "bool",
+    "int",
+    "float",
+    "string",
+    "texture",
+    "texture1D",
+    "texture2D",
+    "texture3D",
+    "textureCUBE",
+    "sampler",
+    "sampler1D",
+    "sampler2D",
+    "sampler3D",
+    "samplerCUBE",
+    "pixelshader",
+    "vertexshader",
+    "pixelfragment",
+    "vertexfragment",
+    "uint",
+    "uint8",
+    "geometryshader",
+    "rasterizer",
+    "depthstencil",
+    "blend",
+    "buffer",
+    "cbuffer",
+    "tbuffer",
+    "texture1DArray",
+    "texture2DArray",
+    "rendertargetview",
+    "depthstencilview",
+    "texture2DMS",
+    "texture2DMSArray",
+    "textureCUBEArray",
+    "hullshader",
+    "domainshader",
+    "interface",
+    "computeshader",
+    "double",
+    "RWTexture1D",
+    "RWTexture1DArray",
+    "RWTexture2D",
+    "RWTexture2DArray",
+    "RWTexture3D",
+    "RWBuffer",
+    "ByteAddressBuffer",
+    "RWByteAddressBuffer",
+    "StructuredBuffer",
+    "RWStructuredBuffer",
+    "AppendStructuredBuffer",
+    "ConsumeStructuredBuffer",
+    "min8float",
+    "min10float",
+    "min16float",
+    "min12int",
+    "min16int",
+    "min16uint",
+};
+
+//-------------------------------------------------------------------------------------------------
+//      テーブルから名前を取得します.
+//-------------------------------------------------------------------------------------------------
+template<size_t N>
+const char* GetName(const char* (&table)[N], uint32_t index)
+{ return (index < N) ? table[index] : "unknown"; }
+
+//-------------------------------------------------------------------------------------------------
+//      32bit値を読み取ります.
+//-------------------------------------------------------------------------------------------------
+uint32_t ReadU32(const uint8_t* ptr)
+{
+    uint32_t result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      16bit値を読み取ります.
+//-------------------------------------------------------------------------------------------------
+uint16_t ReadU16(const uint8_t* ptr)
+{
+    uint16_t result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      書き込みマスクを文字列に変換します.
+//-------------------------------------------------------------------------------------------------
+std::string ToMaskString(uint32_t mask)
+{
+    std::string result;
+    if (mask & 0x1) { result += 'x'; }
+    if (mask & 0x2) { result += 'y'; }
+    if (mask & 0x4) { result += 'z'; }
+    if (mask & 0x8) { result += 'w'; }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      成分の指定を取り除きます (リソース宣言では成分を表示しない).
+//-------------------------------------------------------------------------------------------------
+std::string StripComponent(const std::string& operand)
+{ return operand.substr(0, operand.find('.')); }
+
+//-------------------------------------------------------------------------------------------------
+//      シグニチャのシステム値名を取得します (fxc のシグニチャ表示と同じ表記).
+//-------------------------------------------------------------------------------------------------
+const char* ToSignatureSystemValue(uint32_t value)
+{
+    switch(value)
+    {
+    case 0:  return "NONE";
+    case 1:  return "POS";
+    case 2:  return "CLIPDST";
+    case 3:  return "CULLDST";
+    case 4:  return "RTINDEX";
+    case 5:  return "VPINDEX";
+    case 6:  return "VERTID";
+    case 7:  return "PRIMID";
+    case 8:  return "INSTID";
+    case 9:  return "FFACE";
+    case 10: return "SAMPLE";
+    case 11: return "QUADEDGE";
+    case 12: return "QUADINT";
+    case 13: return "TRIEDGE";
+    case 14: return "TRIINT";
+    case 15: return "LINEDET";
+    case 16: return "LINEDEN";
+    case 64: return "TARGET";
+    case 65: return "DEPTH";
+    case 66: return "COVERAGE";
+    case 67: return "DEPTHGE";
+    case 68: return "DEPTHLE";
+    case 69: return "STENCILREF";
+    case 70: return "INNERCOV";
+    default: return "NONE";
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      シグニチャの成分型名を取得します.
+//-------------------------------------------------------------------------------------------------
+const char* ToSignatureFormat(uint32_t value)
+{
+    switch(value)
+    {
+    case 1:  return "uint";
+    case 2:  return "int";
+    case 3:  return "float";
+    default: return "unknown";
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      即値を文字列に変換します.
+//-------------------------------------------------------------------------------------------------
+bool AppendValue(std::string& result, uint32_t value, VALUE_HINT hint)
+{
+    char buf[64];
+
+    // 型の無い命令は値の見た目から判断する. 指数部が常識的な範囲であれば浮動小数点とみなす.
+    if (hint == HINT_ANY)
+    {
+        auto exponent = (value >> 23) & 0xff;
+        hint = (exponent >= 0x66 && exponent <= 0x97) ? HINT_FLOAT : HINT_INT;
+    }
+
+    switch(hint)
+    {
+    case HINT_FLOAT:
+    case HINT_DOUBLE:
+        {
+            float f;
+            memcpy(&f, &value, sizeof(f));
+            sprintf_s(buf, "%f", f);
+            result += buf;
+        }
+        return true;
+
+    case HINT_UINT:
+        sprintf_s(buf, "%u", value);
+        break;
+
+    case HINT_BITS:
+        if (value < 0x10000)
+        { sprintf_s(buf, "%u", value); }
+        else
+        { sprintf_s(buf, "0x%08x", value); }
+        break;
+
+    default:
+        sprintf_s(buf, "%d", static_cast<int32_t>(value));
+        break;
+    }
+
+    result += buf;
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpcodeMapping structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct OpcodeMapping
+{
+    a3d::OPCODE_TYPE    Opcode;     // 変換先の命令番号 (OPCODE_UNKNOWN は変換しない命令).
+    uint16_t            Flags;      // ニーモニックに含まれる修飾子 (firstbit_hi の "_hi" など).
+};
+
+//-------------------------------------------------------------------------------------------------
+//      オペコードから変換先の命令を取得します.
+//-------------------------------------------------------------------------------------------------
+const OpcodeMapping& GetMapping(uint32_t opcode)
+{
+    // ニーモニックでの引き当ては最初の1回だけ行い，以降はオペコードで直接引く.
+    static const auto kMapping = []()
+    {
+        std::vector<OpcodeMapping> result(kOpcodeCount, OpcodeMapping{ a3d::OPCODE_UNKNOWN, a3d::MODIFIER_NONE });
+        for(size_t i=0; i<kOpcodeCount; ++i)
+        {
+            if (kOpcodeTable[i].Name == nullptr)
+            { continue; }
+
+            a3d::Modifier modifier = {};
+            auto pInfo = a3d::FindOpcode(kOpcodeTable[i].Name, modifier);
+            if (pInfo != nullptr)
+            { result[i] = OpcodeMapping{ pInfo->Opcode, modifier.Flags }; }
+        }
+        return result;
+    }();
+
+    return kMapping[opcode];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Decoder class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Decoder
+{
+public:
+    Decoder(const uint32_t* pTokens, size_t count, std::string& text, std::vector<a3d::Instruction>& program)
+    : m_pCur    (pTokens)
+    , m_pEnd    (pTokens + count)
+    , m_pLimit  (pTokens)
+    , m_Text    (text)
+    , m_Program (program)
+    { /* DO_NOTHING */ }
+
+    bool Run(std::string& profile);
+
+private:
+    const uint32_t*                 m_pCur;             // 読み取り位置.
+    const uint32_t*                 m_pEnd;             // 読み取り終端.
+    const uint32_t*                 m_pLimit;           // 命令の終端.
+    std::string&                    m_Text;             // オペランドの文字列の格納先.
+    std::vector<a3d::Instruction>&  m_Program;          // 命令の格納先.
+    a3d::Instruction                m_Instruction = {}; // デコード中の命令.
+
+    bool Read(uint32_t& value);
+    bool ReadOperand(VALUE_HINT hint, std::string& result);
+    bool ReadIndex(uint32_t representation, std::string& result, bool& immediate);
+    void AddOperand(const std::string& value);
+    bool ReadInstruction();
+    bool DecodeInstruction(uint32_t token);
+    bool ReadDeclaration(uint32_t opcode, uint32_t token);
+    void ReadImmediateConstantBuffer();
+};
+
+//-------------------------------------------------------------------------------------------------
+//      トークンを1つ読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool Decoder::Read(uint32_t& value)
+{
+    if (m_pCur >= m_pLimit)
+    { return false; }
+
+    value = *m_pCur;
+    m_pCur++;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オペランドインデックスを読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool Decoder::ReadIndex(uint32_t representation, std::string& result, bool& immediate)
+{
+    uint32_t value = 0;
+    uint32_t dummy = 0;
+    std::string relative;
+
+    immediate = false;
+
+    switch(representation)
+    {
+    case INDEX_IMMEDIATE32:
+        if (!Read(value))
+        { return false; }
+        result = std::to_string(value);
+        immediate = true;
+        return true;
+
+    case INDEX_IMMEDIATE64:
+        if (!Read(value) || !Read(dummy))
+        { return false; }
+        result = std::to_string(value);
+        immediate = true;
+        return true;
+
+    case INDEX_RELATIVE:
+        if (!ReadOperand(HINT_INT, relative))
+        { return false; }
+        result = relative + " + 0";
+        return true;
+
+    case INDEX_IMMEDIATE32_PLUS_RELATIVE:
+        if (!Read(value) || !ReadOperand(HINT_INT, relative))
+        { return false; }
+        result = relative + " + " + std::to_string(value);
+        return true;
+
+    case INDEX_IMMEDIATE64_PLUS_RELATIVE:
+        if (!Read(value) || !Read(dummy) || !ReadOperand(HINT_INT, relative))
+        { return false; }
+        result = relative + " + " + std::to_string(value);
+        return true;
+    }
+
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オペランドを読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool Decoder::ReadOperand(VALUE_HINT hint, std::string& result)
+{
+    uint32_t token;
+    if (!Read(token))
+    { return false; }
+
+    auto components = token & 0x3;
+    auto selection  = (token >> 2) & 0x3;
+    auto type       = (token >> 12) & 0xff;
+    auto dimension  = (token >> 20) & 0x3;
+
+    // 修飾子.
+    uint32_t modifier = 0;
+    if (token & 0x80000000)
+    {
+        uint32_t extended;
+        if (!Read(extended))
+        { return false; }
+
+        if ((extended & 0x3f) == 1)
+        { modifier = (extended >> 6) & 0xff; }
+    }
+
+    result.clear();
+
+    // 即値.
+    if (type == OPERAND_IMMEDIATE32 || type == OPERAND_IMMEDIATE64)
+    {
+        auto count  = (components == 1) ? 1 : 4;
+        auto isReal = false;
+        std::string values;
+        for(auto i=0; i<count; ++i)
+        {
+            uint32_t value;
+            if (!Read(value))
+            { return false; }
+
+            if (type == OPERAND_IMMEDIATE64)
+            {
+                // 倍精度は2トークンで1要素.
+                uint32_t high;
+                if (!Read(high))
+                { return false; }
+
+                uint64_t bits = (uint64_t(high) << 32) | value;
+                double d;
+                memcpy(&d, &bits, sizeof(d));
+
+                char buf[64];
+                sprintf_s(buf, "%f", d);
+                values += (i == 0) ? "" : ", ";
+                values += buf;
+                continue;
+            }
+
+            std::string text;
+            isReal |= AppendValue(text, value, hint);
+            values += (i == 0) ? "" : ",";
+            values += text;
+        }
+
+        // fxc は浮動小数点を含む場合だけ区切りに空白を入れる.
+        if (isReal)
+        {
+            std::string spaced;
+            for(auto c : values)
+            {
+                spaced += c;
+                if (c == ',')
+                { spaced += ' '; }
+            }
+            values.swap(spaced);
+        }
+
+        result = (type == OPERAND_IMMEDIATE32) ? "l(" : "d(";
+        result += values;
+        result += ")";
+    }
+    else
+    {
+        result = GetName(kOperandPrefix, type);
+
+        // 2次元の入力と即値定数バッファは最初のインデックスも括弧で囲む.
+        auto bracket = (type == OPERAND_IMMEDIATE_CONSTANT_BUFFER)
+                    || (dimension >= 2 && (type == OPERAND_INPUT
+                                        || type == OPERAND_INPUT_CONTROL_POINT
+                                        || type == OPERAND_OUTPUT_CONTROL_POINT));
+
+        for(uint32_t i=0; i<dimension; ++i)
+        {
+            auto representation = (token >> (22 + i * 3)) & 0x7;
+
+            std::string index;
+            bool immediate;
+            if (!ReadIndex(representation, index, immediate))
+            { return false; }
+
+            if (i == 0 && !bracket && immediate)
+            { result += index; }
+            else
+            { result += "[" + index + "]"; }
+        }
+    }
+
+    // 成分の選択.
+    if (components == 2)
+    {
+        const char kComponent[] = "xyzw";
+        if (selection == 0)
+        {
+            auto mask = (token >> 4) & 0xf;
+            if (mask != 0)
+            { result += "." + ToMaskString(mask); }
+        }
+        else if (selection == 1)
+        {
+            result += ".";
+            for(auto i=0; i<4; ++i)
+            { result += kComponent[(token >> (4 + i * 2)) & 0x3]; }
+        }
+        else if (selection == 2)
+        {
+            result += ".";
+            result += kComponent[(token >> 4) & 0x3];
+        }
+    }
+
+    if (modifier == 1)
+    { result = "-" + result; }
+    else if (modifier == 2)
+    { result = "|" + result + "|"; }
+    else if (modifier == 3)
+    { result = "-|" + result + "|"; }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      デコード中の命令にオペランドを追加します.
+//-------------------------------------------------------------------------------------------------
+void Decoder::AddOperand(const std::string& value)
+{
+    // 命令が持てる数を超えたオペランドは捨てる (テキストの命令と同じ).
+    if (value.empty() || m_Instruction.OperandCount >= a3d::Instruction::MaxOperand)
+    { return; }
+
+    auto& span = m_Instruction.Operand[m_Instruction.OperandCount++];
+    span.Offset = static_cast<uint32_t>(m_Text.size());
+    span.Length = static_cast<uint32_t>(value.size());
+
+    m_Text += value;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      即値定数バッファを読み取ります.
+//-------------------------------------------------------------------------------------------------
+void Decoder::ReadImmediateConstantBuffer()
+{
+    std::string result = "{";
+
+    auto count = static_cast<size_t>(m_pLimit - m_pCur) / 4;
+    for(size_t i=0; i<count; ++i)
+    {
+        result += (i == 0) ? " { " : ", { ";
+        for(auto j=0; j<4; ++j)
+        {
+            result += (j == 0) ? "" : ", ";
+            AppendValue(result, m_pCur[i * 4 + j], HINT_ANY);
+        }
+        result += "}";
+    }
+
+    result += " }";
+    AddOperand(result);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      宣言を読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool Decoder::ReadDeclaration(uint32_t opcode, uint32_t token)
+{
+    std::string operand;
+    uint32_t value[3] = {};
+    char buf[256];
+
+    switch(opcode)
+    {
+    // dcl_resource, dcl_uav_typed
+    case 88:
+    case 156:
+        {
+            if (!ReadOperand(HINT_UINT, operand) || !Read(value[0]))
+            { return false; }
+
+            sprintf_s(buf, "(%s,%s,%s,%s) ",
+                GetName(kReturnType, (value[0] >>  0) & 0xf),
+                GetName(kReturnType, (value[0] >>  4) & 0xf),
+                GetName(kReturnType, (value[0] >>  8) & 0xf),
+                GetName(kReturnType, (value[0] >> 12) & 0xf));
+            AddOperand(buf + StripComponent(operand));
+        }
+        return true;
+
+    // dcl_constantbuffer
+    case 89:
+        {
+            if (!ReadOperand(HINT_UINT, operand))
+            { return false; }
+
+            // 宣言では大文字で表示される.
+            if (operand.compare(0, 2, "cb") == 0)
+            { operand.replace(0, 2, "CB"); }
+
+            AddOperand(StripComponent(operand));
+            AddOperand((token & (1 << 11)) ? "dynamicIndexed" : "immediateIndexed");
+        }
+        return true;
+
+    // dcl_sampler
+    case 90:
+        {
+            const char* kMode[] = { "mode_default", "mode_comparison", "mode_mono" };
+            if (!ReadOperand(HINT_UINT, operand))
+            { return false; }
+
+            AddOperand(StripComponent(operand));
+            AddOperand(GetName(kMode, (token >> 11) & 0xf));
+        }
+        return true;
+
+    // dcl_indexRange
+    case 91:
+        {
+            if (!ReadOperand(HINT_UINT, operand) || !Read(value[0]))
+            { return false; }
+
+            AddOperand(operand);
+            AddOperand(std::to_string(value[0]));
+        }
+        return true;
+
+    // dcl_outputTopology
+    case 92:
+        AddOperand(GetName(kTopology, (token >> 11) & 0x7f));
+        return true;
+
+    // dcl_inputPrimitive
+    case 93:
+        {
+            const char* kPrimitive[] = {
+                "undefined", "point", "line", "triangle", "undefined", "undefined", "lineadj", "triangleadj"
+            };
+            auto primitive = (token >> 11) & 0x3f;
+            if (primitive >= 8)
+            { AddOperand(std::to_string(primitive - 7) + "_control_point_patch"); }
+            else
+            { AddOperand(GetName(kPrimitive, primitive)); }
+        }
+        return true;
+
+    // dcl_input, dcl_output, dcl_stream.
+    case 95:
+    case 101:
+    case 143:
+        {
+            if (!ReadOperand(HINT_UINT, operand))
+            { return false; }
+
+            AddOperand(operand);
+        }
+        return true;
+
+    // dcl_input_sgv, dcl_input_siv, dcl_output_sgv, dcl_output_siv.
+    case 96:
+    case 97:
+    case 102:
+    case 103:
+        {
+            if (!ReadOperand(HINT_UINT, operand) || !Read(value[0]))
+            { return false; }
+
+            AddOperand(operand);
+            AddOperand(GetName(kSystemName, value[0]));
+        }
+        return true;
+
+    // dcl_input_ps
+    case 98:
+        {
+            if (!ReadOperand(HINT_UINT, operand))
+            { return false; }
+
+            AddOperand(GetName(kInterpolation, (token >> 11) & 0xf) + (" " + operand));
+        }
+        return true;
+
+    // dcl_input_ps_sgv, dcl_input_ps_siv
+    case 99:
+    case 100:
+        {
+            if (!ReadOperand(HINT_UINT, operand) || !Read(value[0]))
+            { return false; }
+
+            AddOperand(GetName(kInterpolation, (token >> 11) & 0xf) + (" " + operand));
+            AddOperand(GetName(kSystemName, value[0]));
+        }
+        return true;
+
+    // dcl_maxOutputVertexCount, dcl_temps, dcl_gsinstances, dcl_hs_fork/join_phase_instance_count.
+    case 94:
+    case 104:
+    case 153:
+    case 154:
+    case 206:
+        {
+            if (!Read(value[0]))
+            { return false; }
+
+            AddOperand(std::to_string(value[0]));
+        }
+        return true;
+
+    // dcl_indexableTemp
+    case 105:
+        {
+            if (!Read(value[0]) || !Read(value[1]) || !Read(value[2]))
+            { return false; }
+
+            sprintf_s(buf, "x%u[%u]", value[0], value[1]);
+            AddOperand(buf);
+            AddOperand(std::to_string(value[2]));
+        }
+        return true;
+
+    // dcl_globalFlags
+    case 106:
+        {
+            for(auto i=0; i<8; ++i)
+            {
+                if ((token & (1 << (11 + i))) == 0)
+                { continue; }
+
+                operand += operand.empty() ? "" : " | ";
+                operand += kGlobalFlags[i];
+            }
+
+            AddOperand(operand);
+        }
+        return true;
+
+    // dcl_function_body
+    case 144:
+        {
+            if (!Read(value[0]))
+            { return false; }
+
+            AddOperand("fb" + std::to_string(value[0]));
+        }
+        return true;
+
+    // dcl_function_table
+    case 145:
+        {
+            if (!Read(value[0]) || !Read(value[1]))
+            { return false; }
+
+            operand = "ft" + std::to_string(value[0]) + " = {";
+            for(uint32_t i=0; i<value[1]; ++i)
+            {
+                uint32_t body;
+                if (!Read(body))
+                { return false; }
+
+                operand += (i == 0) ? "fb" : ", fb";
+                operand += std::to_string(body);
+            }
+            operand += "}";
+
+            AddOperand(operand);
+        }
+        return true;
+
+    // dcl_interface
+    case 146:
+        {
+            if (!Read(value[0]))
+            { return false; }
+
+            AddOperand("fp" + std::to_string(value[0]));
+        }
+        return true;
+
+    // dcl_input_control_point_count, dcl_output_control_point_count
+    case 147:
+    case 148:
+        AddOperand(std::to_string((token >> 11) & 0x3f));
+        return true;
+
+    // dcl_tessellator_domain
+    case 149:
+        {
+            const char* kDomain[] = { "domain_undefined", "domain_isoline", "domain_tri", "domain_quad" };
+            AddOperand(GetName(kDomain, (token >> 11) & 0x3));
+        }
+        return true;
+
+    // dcl_tessellator_partitioning
+    case 150:
+        {
+            const char* kPartitioning[] = {
+                "partitioning_undefined",
+                "partitioning_integer",
+                "partitioning_pow2",
+                "partitioning_fractional_odd",
+                "partitioning_fractional_even"
+            };
+            AddOperand(GetName(kPartitioning, (token >> 11) & 0x7));
+        }
+        return true;
+
+    // dcl_tessellator_output_primitive
+    case 151:
+        {
+            const char* kPrimitive[] = {
+                "output_undefined",
+                "output_point",
+                "output_line",
+                "output_triangle_cw",
+                "output_triangle_ccw"
+            };
+            AddOperand(GetName(kPrimitive, (token >> 11) & 0x7));
+        }
+        return true;
+
+    // dcl_hs_max_tessfactor
+    case 152:
+        {
+            if (!Read(value[0]))
+            { return false; }
+
+            operand = "l(";
+            AppendValue(operand, value[0], HINT_FLOAT);
+            operand += ")";
+
+            AddOperand(operand);
+        }
+        return true;
+
+    // dcl_thread_group
+    case 155:
+        {
+            if (!Read(value[0]) || !Read(value[1]) || !Read(value[2]))
+            { return false; }
+
+            for(auto i=0; i<3; ++i)
+            { AddOperand(std::to_string(value[i])); }
+        }
+        return true;
+
+    // dcl_uav_raw, dcl_resource_raw
+    case 157:
+    case 161:
+        {
+            if (!ReadOperand(HINT_UINT, operand))
+            { return false; }
+
+            AddOperand(StripComponent(operand));
+        }
+        return true;
+
+    // dcl_uav_structured, dcl_tgsm_raw, dcl_resource_structured
+    case 158:
+    case 159:
+    case 162:
+        {
+            if (!ReadOperand(HINT_UINT, operand) || !Read(value[0]))
+            { return false; }
+
+            AddOperand(StripComponent(operand));
+            AddOperand(std::to_string(value[0]));
+        }
+        return true;
+
+    // dcl_tgsm_structured
+    case 160:
+        {
+            if (!ReadOperand(HINT_UINT, operand) || !Read(value[0]) || !Read(value[1]))
+            { return false; }
+
+            AddOperand(StripComponent(operand));
+            AddOperand(std::to_string(value[0]));
+            AddOperand(std::to_string(value[1]));
+        }
+        return true;
+    }
+
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      命令を1つ読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool Decoder::ReadInstruction()
+{
+    auto pHead  = m_pCur;
+    auto token  = *pHead;
+    auto opcode = token & 0x7ff;
+
+    // カスタムデータは2トークン目が長さ.
+    size_t length = 0;
+    if (opcode == OPCODE_CUSTOMDATA)
+    {
+        if (m_pEnd - pHead < 2)
+        { return false; }
+
+        length = pHead[1];
+    }
+    else
+    {
+        length = (token >> 24) & 0x7f;
+    }
+
+    if (length == 0 || length > static_cast<size_t>(m_pEnd - pHead))
+    { return false; }
+
+    m_pLimit = pHead + length;
+    m_pCur   = pHead + 1;
+
+    m_Instruction = {};
+    m_Instruction.Line = static_cast<uint32_t>(m_Program.size() + 1);
+
+    auto ret = DecodeInstruction(token);
+
+    // 次の命令の位置は長さから決まるので，解釈に失敗しても読み進められる.
+    m_pCur = m_pLimit;
+
+    return ret;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      命令を解釈します.
+//-------------------------------------------------------------------------------------------------
+bool Decoder::DecodeInstruction(uint32_t token)
+{
+    auto opcode = token & 0x7ff;
+
+    if (opcode == OPCODE_CUSTOMDATA)
+    {
+        // 即値定数バッファ以外のカスタムデータ (コメント等) は変換しない.
+        m_pCur++;
+        if ((token >> 11) != CUSTOMDATA_IMMEDIATE_CONSTANT_BUFFER)
+        { return true; }
+
+        m_Instruction.Opcode = a3d::OPCODE_DCL_IMMEDIATE_CONSTANT_BUFFER;
+        ReadImmediateConstantBuffer();
+        m_Program.push_back(m_Instruction);
+        return true;
+    }
+
+    // 変換先の無い命令は読み飛ばす.
+    if (opcode >= kOpcodeCount || GetMapping(opcode).Opcode == a3d::OPCODE_UNKNOWN)
+    { return true; }
+
+    const auto& info    = kOpcodeTable[opcode];
+    const auto& mapping = GetMapping(opcode);
+
+    auto& modifier = m_Instruction.Modifiers;
+    m_Instruction.Opcode = mapping.Opcode;
+    modifier.Flags       = mapping.Flags;
+
+    // 拡張オペコード.
+    auto extended = (token & 0x80000000) != 0;
+    while (extended)
+    {
+        uint32_t ext;
+        if (!Read(ext))
+        { return false; }
+
+        switch(ext & 0x3f)
+        {
+        case EXTENDED_SAMPLE_CONTROLS:
+            {
+                modifier.Flags |= a3d::MODIFIER_AOFFIMMI;
+                for(auto i=0; i<3; ++i)
+                {
+                    // 4bit 符号付き整数.
+                    auto v = static_cast<int>((ext >> (9 + i * 4)) & 0xf);
+                    modifier.Offset[i] = static_cast<int8_t>((v >= 8) ? v - 16 : v);
+                }
+            }
+            break;
+
+        case EXTENDED_RESOURCE_DIM:
+            modifier.Flags     |= a3d::MODIFIER_INDEXABLE;
+            modifier.Dimension  = GetName(kResourceDimension, (ext >> 6) & 0x1f);
+            break;
+
+        case EXTENDED_RESOURCE_RETURN_TYPE:
+            modifier.ReturnType = GetName(kReturnType, (ext >> 6) & 0xf);
+            break;
+        }
+
+        extended = (ext & 0x80000000) != 0;
+    }
+
+    if (info.Hint == HINT_DECL)
+    {
+        if (!ReadDeclaration(opcode, token))
+        { return false; }
+
+        m_Program.push_back(m_Instruction);
+        return true;
+    }
+
+    if (opcode == OPCODE_BREAKC
+     || opcode == OPCODE_CALLC
+     || opcode == OPCODE_CONTINUEC
+     || opcode == OPCODE_DISCARD
+     || opcode == OPCODE_IF
+     || opcode == OPCODE_RETC)
+    { modifier.Flags |= (token & (1 << 18)) ? a3d::MODIFIER_TEST_NZ : a3d::MODIFIER_TEST_Z; }
+
+    if (opcode == OPCODE_RESINFO)
+    {
+        auto type = (token >> 11) & 0x3;
+        if (type == 1)
+        { modifier.Flags |= a3d::MODIFIER_RCP_FLOAT; }
+        else if (type == 2)
+        { modifier.Flags |= a3d::MODIFIER_UINT; }
+    }
+
+    if (opcode == OPCODE_SAMPLE_INFO && (token & (1 << 11)))
+    { modifier.Flags |= a3d::MODIFIER_UINT; }
+
+    // sync はビット13がスレッドグループの同期を表すので飽和とは見なさない.
+    if ((token & (1 << 13)) && opcode != OPCODE_SYNC)
+    { modifier.Flags |= a3d::MODIFIER_SATURATE; }
+
+    // インターフェース呼び出しは関数番号が先に来る.
+    uint32_t callIndex = 0;
+    if (opcode == OPCODE_INTERFACE_CALL && !Read(callIndex))
+    { return false; }
+
+    // オペランド.
+    std::string operand;
+    while (m_pCur < m_pLimit)
+    {
+        if (!ReadOperand(info.Hint, operand))
+        { return false; }
+
+        AddOperand(operand);
+    }
+
+    if (opcode == OPCODE_INTERFACE_CALL)
+    { AddOperand(std::to_string(callIndex)); }
+
+    m_Program.push_back(m_Instruction);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      命令列をデコードします.
+//-------------------------------------------------------------------------------------------------
+bool Decoder::Run(std::string& profile)
+{
+    if (m_pEnd - m_pCur < 2)
+    { return false; }
+
+    // バージョントークン.
+    auto version = m_pCur[0];
+    auto length  = static_cast<size_t>(m_pCur[1]);
+    if (length < 2 || length > static_cast<size_t>(m_pEnd - m_pCur))
+    { return false; }
+
+    m_pEnd = m_pCur + length;
+
+    const char* kProgram[] = { "ps", "vs", "gs", "hs", "ds", "cs" };
+    auto program = version >> 16;
+    auto major   = (version >> 4) & 0xf;
+    auto minor   = version & 0xf;
+
+    char buf[32];
+    sprintf_s(buf, "%s_%u_%u", GetName(kProgram, program), major, minor);
+    profile = buf;
+
+    // 1命令はおおよそ4トークン, 1トークンのオペランドはおおよそ4文字.
+    m_Text.clear();
+    m_Text.reserve(length * 4);
+    m_Program.clear();
+    m_Program.reserve(length / 4);
+
+    m_pCur += 2;
+
+    while (m_pCur < m_pEnd)
+    {
+        if (!ReadInstruction())
+        { return false; }
+    }
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ResourceDefinitionReader class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class ResourceDefinitionReader
+{
+public:
+    ResourceDefinitionReader(const uint8_t* pChunk, uint32_t size)
+    : m_pChunk      (pChunk)
+    , m_Size        (size)
+    , m_BindStride  (kRdefBindStride)
+    , m_ShaderModel5(false)
+    { /* DO_NOTHING */ }
+
+    bool Run(a3d::Reflection& reflection);
+
+private:
+    struct TypeInfo
+    {
+        uint32_t        Class;          // 型の分類 (スカラー, ベクトル, 行列, 構造体).
+        uint32_t        Type;           // スカラー型.
+        uint32_t        Rows;           // 行数.
+        uint32_t        Columns;        // 列数.
+        uint32_t        Elements;       // 配列要素数 (配列でない場合は 0).
+        uint32_t        Members;        // 構造体のメンバー数.
+        uint32_t        MemberOffset;   // 構造体のメンバー情報の位置.
+        std::string     Name;           // 型名.
+    };
+
+    const uint8_t*  m_pChunk;       // チャンクデータ.
+    uint32_t        m_Size;         // チャンクサイズ.
+    size_t          m_BindStride;   // リソースバインディング1件のサイズ.
+    bool            m_ShaderModel5; // 型名と拡張フィールドを持つ形式かどうか.
+
+    bool IsValidArray(uint32_t offset, uint32_t count, size_t stride) const;
+    bool ReadString(uint32_t offset, std::string& result) const;
+    bool ReadType(uint32_t offset, TypeInfo& result) const;
+    bool ReadVariable(uint32_t nameOffset, const TypeInfo& type, a3d::Variable& result) const;
+    bool ReadConstantBuffer(uint32_t offset, a3d::Reflection& reflection) const;
+    bool ReadResource(uint32_t offset, a3d::Resource& result) const;
+};
+
+//-------------------------------------------------------------------------------------------------
+//      配列がチャンク内に収まっているかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool ResourceDefinitionReader::IsValidArray(uint32_t offset, uint32_t count, size_t stride) const
+{
+    if (offset > m_Size)
+    { return false; }
+
+    return count <= (m_Size - offset) / stride;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      null終端文字列を読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool ResourceDefinitionReader::ReadString(uint32_t offset, std::string& result) const
+{
+    if (offset >= m_Size)
+    { return false; }
+
+    auto pHead = reinterpret_cast<const char*>(m_pChunk + offset);
+    auto pTail = static_cast<const char*>(memchr(pHead, '\0', m_Size - offset));
+    if (pTail == nullptr)
+    { return false; }
+
+    result.assign(pHead, pTail);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      型情報を読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool ResourceDefinitionReader::ReadType(uint32_t offset, TypeInfo& result) const
+{
+    // SM5 形式では末尾に予約領域と型名の位置が付く.
+    auto stride = m_ShaderModel5 ? 36u : 16u;
+    if (!IsValidArray(offset, 1, stride))
+    { return false; }
+
+    auto ptr = m_pChunk + offset;
+    result.Class        = ReadU16(ptr + 0);
+    result.Type         = ReadU16(ptr + 2);
+    result.Rows         = ReadU16(ptr + 4);
+    result.Columns      = ReadU16(ptr + 6);
+    result.Elements     = ReadU16(ptr + 8);
+    result.Members      = ReadU16(ptr + 10);
+    result.MemberOffset = ReadU32(ptr + 12);
+
+    auto nameOffset = m_ShaderModel5 ? ReadU32(ptr + 32) : 0;
+    if (nameOffset != 0)
+    { return ReadString(nameOffset, result.Name); }
+
+    // 型名が格納されていない場合は fxc と同じ表記で組み立てる.
+    result.Name = GetName(kVariableType, result.Type);
+    if (result.Class == VARIABLE_CLASS_VECTOR)
+    {
+        result.Name += std::to_string(result.Columns);
+    }
+    else if (result.Class == VARIABLE_CLASS_MATRIX_ROWS
+          || result.Class == VARIABLE_CLASS_MATRIX_COLUMNS)
+    {
+        result.Name += std::to_string(result.Rows);
+        result.Name += "x";
+        result.Name += std::to_string(result.Columns);
+    }
+    else if (result.Class == VARIABLE_CLASS_STRUCT)
+    {
+        result.Name = "struct";
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      変数定義を組み立てます.
+//-------------------------------------------------------------------------------------------------
+bool ResourceDefinitionReader::ReadVariable(uint32_t nameOffset, const TypeInfo& type, a3d::Variable& result) const
+{
+    if (!ReadString(nameOffset, result.Name))
+    { return false; }
+
+    // テキストの宣言と同様に配列サイズは名前側に付ける.
+    if (type.Elements > 0)
+    {
+        result.Name += "[";
+        result.Name += std::to_string(type.Elements);
+        result.Name += "]";
+    }
+
+    result.Type   = type.Name;
+    result.Layout = (type.Class == VARIABLE_CLASS_MATRIX_ROWS) ? a3d::LAYOUT_ROW_MAJOR : a3d::LAYOUT_DEFAULT;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      定数バッファを読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool ResourceDefinitionReader::ReadConstantBuffer(uint32_t offset, a3d::Reflection& reflection) const
+{
+    auto ptr = m_pChunk + offset;
+    auto nameOffset     = ReadU32(ptr + 0);
+    auto variableCount  = ReadU32(ptr + 4);
+    auto variableOffset = ReadU32(ptr + 8);
+    auto bufferSize     = ReadU32(ptr + 12);
+    auto bufferType     = ReadU32(ptr + 20);
+
+    // インタフェースポインタは変換対象外.
+    if (bufferType == CBUFFER_TYPE_INTERFACE_POINTERS || bufferType > CBUFFER_TYPE_RESOURCE_BIND_INFO)
+    { return true; }
+
+    // 定数バッファは最大 4096 要素 (64KB).
+    if (bufferSize > kMaxBufferSize)
+    { return false; }
+
+    // SM5 形式の変数はテクスチャ・サンプラーの割り当て情報を持つ.
+    auto stride = m_ShaderModel5 ? 40u : 24u;
+    if (!IsValidArray(variableOffset, variableCount, stride))
+    { return false; }
+
+    std::string name;
+    if (!ReadString(nameOffset, name))
+    { return false; }
+
+    name.erase(std::remove(name.begin(), name.end(), '$'), name.end());
+
+    // 構造化バッファの要素型.
+    if (bufferType == CBUFFER_TYPE_RESOURCE_BIND_INFO)
+    {
+        if (variableCount == 0)
+        { return true; }
+
+        auto pVariable = m_pChunk + variableOffset;
+
+        TypeInfo type = {};
+        if (!ReadType(ReadU32(pVariable + 16), type))
+        { return false; }
+
+        if (type.Class != VARIABLE_CLASS_STRUCT)
+        {
+            reflection.AddUavStructPair(name, type.Name);
+            return true;
+        }
+
+        if (!IsValidArray(type.MemberOffset, type.Members, kRdefMemberStride))
+        { return false; }
+
+        a3d::Structure def = {};
+        def.Name = type.Name;
+        def.Size = static_cast<int>(bufferSize);
+        def.Members.reserve(type.Members);
+
+        for(uint32_t i=0; i<type.Members; ++i)
+        {
+            auto pMember = m_pChunk + type.MemberOffset + i * kRdefMemberStride;
+
+            TypeInfo memberType = {};
+            if (!ReadType(ReadU32(pMember + 4), memberType))
+            { return false; }
+
+            a3d::Variable member = {};
+            if (!ReadVariable(ReadU32(pMember + 0), memberType, member))
+            { return false; }
+
+            auto scalarSize = (memberType.Type == VARIABLE_TYPE_DOUBLE) ? 8u : 4u;
+            member.Offset = static_cast<int>(ReadU32(pMember + 8));
+            member.Size   = static_cast<int>(scalarSize * memberType.Rows * memberType.Columns * std::max(memberType.Elements, 1u));
+
+            def.Members.push_back(member);
+        }
+
+        reflection.AddUavStructPair(name, def.Name);
+        reflection.AddStructure(def);
+        return true;
+    }
+
+    a3d::ConstantBuffer def = {};
+    def.Name = name;
+    def.Size = static_cast<int>(bufferSize);
+    def.Variables.reserve(variableCount);
+
+    for(uint32_t i=0; i<variableCount; ++i)
+    {
+        auto pVariable = m_pChunk + variableOffset + i * stride;
+
+        TypeInfo type = {};
+        if (!ReadType(ReadU32(pVariable + 16), type))
+        { return false; }
+
+        a3d::Variable variable = {};
+        if (!ReadVariable(ReadU32(pVariable + 0), type, variable))
+        { return false; }
+
+        // 定数バッファの範囲外を指す変数は壊れているとみなす.
+        auto startOffset = ReadU32(pVariable + 4);
+        auto size        = ReadU32(pVariable + 8);
+        if (startOffset > bufferSize || size > bufferSize - startOffset)
+        { return false; }
+
+        // 配列の各要素は 16byte 境界に配置されるので，サイズと矛盾する要素数も壊れているとみなす.
+        if (type.Elements > 0 && (type.Elements - 1) * 16 >= size)
+        { return false; }
+
+        variable.Offset = static_cast<int>(startOffset);
+        variable.Size   = static_cast<int>(size);
+
+        def.Variables.push_back(variable);
+    }
+
+    reflection.AddConstantBuffer(def);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      リソースバインディングを読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool ResourceDefinitionReader::ReadResource(uint32_t offset, a3d::Resource& result) const
+{
+    auto ptr = m_pChunk + offset;
+    auto inputType  = ReadU32(ptr + 4);
+    auto returnType = ReadU32(ptr + 8);
+    auto dimension  = ReadU32(ptr + 12);
+    auto bindPoint  = ReadU32(ptr + 20);
+    auto bindCount  = ReadU32(ptr + 24);
+    auto flags      = ReadU32(ptr + 28);
+
+    // SM5.0 以前のスロット数 (D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT) を超えるものは壊れているとみなす.
+    if (m_BindStride == kRdefBindStride && (bindPoint >= kMaxBindSlot || bindCount > kMaxBindSlot - bindPoint))
+    { return false; }
+
+    if (!ReadString(ReadU32(ptr + 0), result.Name))
+    { return false; }
+
+    result.Name.erase(std::remove(result.Name.begin(), result.Name.end(), '$'), result.Name.end());
+
+    // fxc のリソースバインディング表と同じ表記にする.
+    result.Type = GetName(kBindType, inputType);
+    auto isUav  = (result.Type == "UAV");
+
+    const char* prefix = isUav ? "u" : "t";
+    if (inputType == INPUT_CBUFFER || inputType == INPUT_TBUFFER || inputType == INPUT_SAMPLER)
+    {
+        result.Format    = "NA";
+        result.Dimension = "NA";
+
+        if (inputType == INPUT_CBUFFER)
+        { prefix = "cb"; }
+        else if (inputType == INPUT_SAMPLER)
+        {
+            prefix = "s";
+            if (flags & INPUT_FLAG_COMPARISON_SAMPLER)
+            { result.Type = "sampler_c"; }
+        }
+    }
+    else if (inputType == INPUT_BYTEADDRESS || inputType == INPUT_UAV_RWBYTEADDRESS)
+    {
+        result.Format    = "byte";
+        result.Dimension = isUav ? "r/w" : "r/o";
+    }
+    else if (inputType >= INPUT_STRUCTURED)
+    {
+        result.Format    = "struct";
+        result.Dimension = isUav ? "r/w" : "r/o";
+    }
+    else
+    {
+        // 成分数はフラグの2-3ビット目に (成分数 - 1) で格納されている.
+        auto components = ((flags >> 2) & 0x3) + 1;
+
+        result.Format = GetName(kReturnType, returnType);
+        if (components > 1)
+        { result.Format += std::to_string(components); }
+
+        result.Dimension = GetName(kBindDimension, dimension);
+    }
+
+    result.HLSLBind = prefix + std::to_string(bindPoint);
+    result.Count    = static_cast<int>(bindCount);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      リソース定義を読み取ります.
+//-------------------------------------------------------------------------------------------------
+bool ResourceDefinitionReader::Run(a3d::Reflection& reflection)
+{
+    if (m_Size < kRdefHeaderSize)
+    { return false; }
+
+    auto bufferCount  = ReadU32(m_pChunk + 0);
+    auto bufferOffset = ReadU32(m_pChunk + 4);
+    auto bindCount    = ReadU32(m_pChunk + 8);
+    auto bindOffset   = ReadU32(m_pChunk + 12);
+    auto minor        = m_pChunk[16];
+    auto major        = m_pChunk[17];
+
+    // SM5.1 ではバインディングにレジスタ空間とIDが追加される.
+    m_ShaderModel5 = (major >= 5);
+    m_BindStride   = (major > 5 || (major == 5 && minor >= 1)) ? kRdefBindStride + 8 : kRdefBindStride;
+
+    if (!IsValidArray(bufferOffset, bufferCount, kRdefBufferStride)
+     || !IsValidArray(bindOffset,   bindCount,   m_BindStride))
+    { return false; }
+
+    // テキストのヘッダと同じく，定数バッファ定義 → リソースバインディングの順に登録する.
+    for(uint32_t i=0; i<bufferCount; ++i)
+    {
+        if (!ReadConstantBuffer(bufferOffset + i * uint32_t(kRdefBufferStride), reflection))
+        { return false; }
+    }
+
+    for(uint32_t i=0; i<bindCount; ++i)
+    {
+        a3d::Resource def = {};
+        if (!ReadResource(bindOffset + i * uint32_t(m_BindStride), def))
+        { return false; }
+
+        reflection.AddResource(def);
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// DxbcReader class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+DxbcReader::DxbcReader()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+DxbcReader::~DxbcReader()
+{ Close(); }
+
+//-------------------------------------------------------------------------------------------------
+//      DXBCコンテナかどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool DxbcReader::IsDxbc(const void* pData, size_t size)
+{
+    return (pData != nullptr)
+        && (size >= kHeaderSize)
+        && (memcmp(pData, "DXBC", 4) == 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      コンテナを開きます.
+//-------------------------------------------------------------------------------------------------
+bool DxbcReader::Open(const void* pData, size_t size)
+{
+    Close();
+
+    if (!IsDxbc(pData, size))
+    { return false; }
+
+    auto pBytes = static_cast<const uint8_t*>(pData);
+
+    // チェックサムは検証しない (コンパイラが生成したものをそのまま信用する).
+    auto totalSize  = ReadU32(pBytes + 24);
+    auto chunkCount = ReadU32(pBytes + 28);
+    if (totalSize > size || totalSize < kHeaderSize)
+    { return false; }
+
+    if (chunkCount > (totalSize - kHeaderSize) / sizeof(uint32_t))
+    { return false; }
+
+    m_Chunks.resize(chunkCount);
+    for(uint32_t i=0; i<chunkCount; ++i)
+    {
+        auto offset = ReadU32(pBytes + kHeaderSize + i * sizeof(uint32_t));
+        if (offset > totalSize - kChunkHeader)
+        {
+            m_Chunks.clear();
+            return false;
+        }
+
+        auto chunkSize = ReadU32(pBytes + offset + 4);
+        if (chunkSize > totalSize - offset - kChunkHeader)
+        {
+            m_Chunks.clear();
+            return false;
+        }
+
+        m_Chunks[i] = offset;
+    }
+
+    m_pData = pBytes;
+    m_Size  = totalSize;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      コンテナを閉じます.
+//-------------------------------------------------------------------------------------------------
+void DxbcReader::Close()
+{
+    m_pData = nullptr;
+    m_Size  = 0;
+    m_Chunks.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      チャンクを検索します.
+//-------------------------------------------------------------------------------------------------
+const uint8_t* DxbcReader::FindChunk(const char* fourCC, uint32_t* pSize) const
+{
+    for(auto& offset : m_Chunks)
+    {
+        if (memcmp(m_pData + offset, fourCC, 4) != 0)
+        { continue; }
+
+        if (pSize != nullptr)
+        { *pSize = ReadU32(m_pData + offset + 4); }
+
+        return m_pData + offset + kChunkHeader;
+    }
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      入力シグニチャを読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool DxbcReader::ReadInputSignature(std::vector<a3d::Signature>& result) const
+{
+    return ReadSignature("ISG1", result, false)
+        || ReadSignature("ISGN", result, false);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      出力シグニチャを読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool DxbcReader::ReadOutputSignature(std::vector<a3d::Signature>& result) const
+{
+    return ReadSignature("OSG5", result, true)
+        || ReadSignature("OSG1", result, true)
+        || ReadSignature("OSGN", result, true);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      パッチ定数シグニチャを読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool DxbcReader::ReadPatchConstantSignature(std::vector<a3d::Signature>& result) const
+{
+    return ReadSignature("PSG1", result, true)
+        || ReadSignature("PCSG", result, true);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      シグニチャを読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool DxbcReader::ReadSignature(const char* fourCC, std::vector<a3d::Signature>& result, bool output) const
+{
+    uint32_t size = 0;
+    auto pChunk = FindChunk(fourCC, &size);
+    if (pChunk == nullptr || size < 8)
+    { return false; }
+
+    // 要素のレイアウトはチャンクの種類で異なる.
+    //  ISGN/OSGN/PCSG : name, index, sysValue, format, register, mask, rwMask (24byte).
+    //  OSG5           : stream + 上記 (28byte).
+    //  ISG1/OSG1/PSG1 : stream + 上記 + minPrecision (32byte).
+    size_t stride = 24;
+    size_t head   = 0;
+    if (memcmp(fourCC, "OSG5", 4) == 0)
+    {
+        stride = 28;
+        head   = 4;
+    }
+    else if (fourCC[3] == '1')
+    {
+        stride = 32;
+        head   = 4;
+    }
+
+    auto count  = ReadU32(pChunk + 0);
+    auto offset = ReadU32(pChunk + 4);
+    if (offset > size || count > (size - offset) / stride)
+    { return false; }
+
+    result.clear();
+    result.reserve(count);
+
+    for(uint32_t i=0; i<count; ++i)
+    {
+        auto pElement = pChunk + offset + i * stride + head;
+
+        auto nameOffset = ReadU32(pElement + 0);
+        if (nameOffset >= size)
+        { return false; }
+
+        auto pName = reinterpret_cast<const char*>(pChunk + nameOffset);
+        auto pTail = static_cast<const char*>(memchr(pName, '\0', size - nameOffset));
+        if (pTail == nullptr)
+        { return false; }
+
+        auto mask   = pElement[20];
+        auto rwMask = pElement[21];
+
+        a3d::Signature def = {};
+        def.Semantics   = std::string(pName, pTail);
+        def.Index       = static_cast<int>(ReadU32(pElement + 4));
+        def.SystemValue = ToSignatureSystemValue(ReadU32(pElement + 8));
+        def.Format      = ToSignatureFormat(ReadU32(pElement + 12));
+        def.Register    = static_cast<int>(ReadU32(pElement + 16));
+        def.Mask        = ToMaskString(mask);
+
+        // 出力の場合は "書き込まれない成分" のマスクなので反転する.
+        def.Used        = ToMaskString(output ? (mask & ~rwMask) : rwMask);
+
+        result.push_back(def);
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      リソース定義を読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool DxbcReader::ReadResourceDefinition(a3d::Reflection& reflection) const
+{
+    uint32_t size = 0;
+    auto pChunk = FindChunk("RDEF", &size);
+    if (pChunk == nullptr)
+    { return false; }
+
+    ResourceDefinitionReader reader(pChunk, size);
+    return reader.Run(reflection);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      シェーダコードを命令列にデコードします.
+//-------------------------------------------------------------------------------------------------
+bool DxbcReader::Decode(std::string& profile, std::string& text, std::vector<a3d::Instruction>& program) const
+{
+    uint32_t size = 0;
+    auto pChunk = FindChunk("SHEX", &size);
+    if (pChunk == nullptr)
+    { pChunk = FindChunk("SHDR", &size); }
+
+    if (pChunk == nullptr)
+    { return false; }
+
+    // チャンクは4byte境界に並んでいる保証が無いのでコピーしてから読む.
+    std::vector<uint32_t> tokens(size / sizeof(uint32_t));
+    if (!tokens.empty())
+    { memcpy(tokens.data(), pChunk, tokens.size() * sizeof(uint32_t)); }
+
+    Decoder decoder(tokens.data(), tokens.size(), text, program);
+    return decoder.Run(profile);
+}
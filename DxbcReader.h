@@ -0,0 +1,120 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : DxbcReader.h
+// Desc : DXBC Container Reader Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Reflection.h"
+#include "Opcode.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// DxbcReader class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class DxbcReader
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+    DxbcReader();
+    ~DxbcReader();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      DXBCコンテナかどうかチェックします.
+    //---------------------------------------------------------------------------------------------
+    static bool IsDxbc(const void* pData, size_t size);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンテナを開きます.
+    //!
+    //! @param[in]      pData           コンテナデータ. 読み込み中は呼び出し側で保持しておく必要があります.
+    //! @param[in]      size            データサイズ.
+    //! @retval true    ヘッダとチャンクテーブルが正しい.
+    //! @retval false   コンテナが壊れている.
+    //---------------------------------------------------------------------------------------------
+    bool Open(const void* pData, size_t size);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      コンテナを閉じます.
+    //---------------------------------------------------------------------------------------------
+    void Close();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      チャンクを検索します.
+    //!
+    //! @param[in]      fourCC          チャンク識別子 (例 : "SHEX").
+    //! @param[out]     pSize           チャンクサイズの格納先.
+    //! @return     チャンクデータの先頭ポインタを返却します. 見つからない場合は nullptr.
+    //---------------------------------------------------------------------------------------------
+    const uint8_t* FindChunk(const char* fourCC, uint32_t* pSize) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      入力シグニチャを読み込みます (ISG1/ISGN).
+    //---------------------------------------------------------------------------------------------
+    bool ReadInputSignature(std::vector<a3d::Signature>& result) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      出力シグニチャを読み込みます (OSG5/OSG1/OSGN).
+    //---------------------------------------------------------------------------------------------
+    bool ReadOutputSignature(std::vector<a3d::Signature>& result) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      パッチ定数シグニチャを読み込みます (PSG1/PCSG).
+    //---------------------------------------------------------------------------------------------
+    bool ReadPatchConstantSignature(std::vector<a3d::Signature>& result) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      リソース定義 (RDEF) を読み込み，リフレクションに登録します.
+    //!
+    //! @param[out]     reflection      定数バッファ, 構造体, リソースバインディングの登録先.
+    //! @retval true    読み込みに成功.
+    //! @retval false   リソース定義が無い，または壊れている.
+    //---------------------------------------------------------------------------------------------
+    bool ReadResourceDefinition(a3d::Reflection& reflection) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      シェーダコード (SHEX/SHDR) をテキストを経由せずに命令列にデコードします.
+    //!
+    //! @param[out]     profile         シェーダプロファイル (例 : "cs_5_0").
+    //! @param[out]     text            オペランドの文字列の格納先. 命令のオペランド位置はこの先頭からの位置です.
+    //! @param[out]     program         デコードした命令の格納先. 変換先の無い命令は含みません.
+    //! @retval true    デコードに成功.
+    //! @retval false   シェーダコードが無い，または壊れている.
+    //---------------------------------------------------------------------------------------------
+    bool Decode(std::string& profile, std::string& text, std::vector<a3d::Instruction>& program) const;
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    const uint8_t*              m_pData = nullptr;  //!< コンテナデータ.
+    size_t                      m_Size  = 0;        //!< コンテナサイズ.
+    std::vector<uint32_t>       m_Chunks;           //!< チャンクのオフセット.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    bool ReadSignature(const char* fourCC, std::vector<a3d::Signature>& result, bool output) const;
+
+    DxbcReader      (const DxbcReader&) = delete;
+    void operator = (const DxbcReader&) = delete;
+};
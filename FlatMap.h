@@ -0,0 +1,200 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : FlatMap.h
+// Desc : Flat Hash Map Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "Hash.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace a3d {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FlatMap class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief      文字列をキーとするオープンアドレス法のハッシュ表です.
+//!
+//! @note       要素は挿入順に配列へ格納します. 挿入すると Find() などで得たポインタは無効になります.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class FlatMap
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      全ての要素を破棄します. 確保済みのメモリは次の挿入で再利用します.
+    //---------------------------------------------------------------------------------------------
+    void Clear()
+    {
+        m_Entries.clear();
+        m_Slots.clear();
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      要素が無いかどうかチェックします.
+    //---------------------------------------------------------------------------------------------
+    bool IsEmpty() const
+    { return m_Entries.empty(); }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      要素数を取得します.
+    //---------------------------------------------------------------------------------------------
+    size_t GetCount() const
+    { return m_Entries.size(); }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーに一致する要素を検索します. キー文字列は生成しません.
+    //!
+    //! @param[in]      key         検索するキー.
+    //! @return     見つかった要素を返却します. 見つからない場合は nullptr を返却します.
+    //---------------------------------------------------------------------------------------------
+    const T* Find(std::string_view key) const
+    {
+        if (m_Slots.empty())
+        { return nullptr; }
+
+        auto slot = FindSlot(key, ToHash(key));
+        if (m_Slots[slot] == 0)
+        { return nullptr; }
+
+        return &m_Entries[m_Slots[slot] - 1].Value;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーに一致する要素を検索します. キー文字列は生成しません.
+    //---------------------------------------------------------------------------------------------
+    T* Find(std::string_view key)
+    { return const_cast<T*>(static_cast<const FlatMap*>(this)->Find(key)); }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーが無い場合に限り要素を追加します.
+    //!
+    //! @param[in]      key         追加するキー.
+    //! @param[in]      value       追加する値.
+    //! @retval true    追加しました.
+    //! @retval false   既に同じキーがあるため追加しませんでした.
+    //---------------------------------------------------------------------------------------------
+    bool Insert(std::string_view key, const T& value)
+    {
+        auto count = m_Entries.size();
+        auto& item = Acquire(key);
+        if (m_Entries.size() == count)
+        { return false; }
+
+        item = value;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーに対応する要素を取得します. キーが無い場合は既定値の要素を追加します.
+    //---------------------------------------------------------------------------------------------
+    T& operator[] (std::string_view key)
+    { return Acquire(key); }
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Entry structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        std::string     Key;        //!< キー.
+        uint32_t        Hash;       //!< キーのハッシュ値.
+        T               Value;      //!< 値.
+    };
+
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    std::vector<Entry>      m_Entries;      //!< 挿入順の要素.
+    std::vector<uint32_t>   m_Slots;        //!< m_Entries の番号 + 1 (0 は空き). 大きさは 2 の累乗です.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      スロットの決定に使うハッシュ値を求めます.
+    //---------------------------------------------------------------------------------------------
+    static uint32_t ToHash(std::string_view value)
+    { return static_cast<uint32_t>(ComputeHash(value)); }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーに一致するスロットか, 見つからなければ最初の空きスロットを返却します.
+    //---------------------------------------------------------------------------------------------
+    size_t FindSlot(std::string_view key, uint32_t hash) const
+    {
+        auto mask = m_Slots.size() - 1;
+        auto slot = hash & mask;
+        while (m_Slots[slot] != 0)
+        {
+            auto& entry = m_Entries[m_Slots[slot] - 1];
+            if (entry.Hash == hash && entry.Key == key)
+            { break; }
+
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      スロット数を変更して再配置します.
+    //---------------------------------------------------------------------------------------------
+    void Rehash(size_t size)
+    {
+        m_Slots.assign(size, 0);
+
+        auto mask = size - 1;
+        for(size_t i=0; i<m_Entries.size(); ++i)
+        {
+            auto slot = m_Entries[i].Hash & mask;
+            while (m_Slots[slot] != 0)
+            { slot = (slot + 1) & mask; }
+
+            m_Slots[slot] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キーに対応する要素を取得します. 無ければ追加します.
+    //---------------------------------------------------------------------------------------------
+    T& Acquire(std::string_view key)
+    {
+        // 使用率が半分を超えないように拡張する.
+        if ((m_Entries.size() + 1) * 2 > m_Slots.size())
+        { Rehash(m_Slots.empty() ? 16 : m_Slots.size() * 2); }
+
+        auto hash = ToHash(key);
+        auto slot = FindSlot(key, hash);
+        if (m_Slots[slot] == 0)
+        {
+            m_Entries.push_back(Entry{ std::string(key), hash, T{} });
+            m_Slots[slot] = static_cast<uint32_t>(m_Entries.size());
+        }
+
+        return m_Entries[m_Slots[slot] - 1].Value;
+    }
+};
+
+} // namespace a3d
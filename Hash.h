@@ -0,0 +1,43 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Hash.h
+// Desc : FNV-1a Hash Function.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <string_view>
+
+
+namespace a3d {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+constexpr uint64_t kHashSeed    = 14695981039346656037ull;  //!< FNV-1a (64bit) のオフセット基底.
+constexpr uint64_t kHashPrime   = 1099511628211ull;         //!< FNV-1a (64bit) の素数.
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      ハッシュ値を求めます (FNV-1a, 64bit).
+//!
+//! @details    ハッシュ表の番号に使う場合は下位ビットを切り出してください.
+//!             seed に前回の結果を渡すと，複数のデータを続けて混ぜることができます.
+//! @param[in]      value       ハッシュ値を求めるバイト列.
+//! @param[in]      seed        初期値.
+//! @return     ハッシュ値を返却します.
+//-------------------------------------------------------------------------------------------------
+constexpr uint64_t ComputeHash(std::string_view value, uint64_t seed = kHashSeed)
+{
+    auto hash = seed;
+    for(size_t i=0; i<value.size(); ++i)
+    {
+        hash ^= static_cast<uint8_t>(value[i]);
+        hash *= kHashPrime;
+    }
+    return hash;
+}
+
+} // namespace a3d
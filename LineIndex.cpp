@@ -0,0 +1,139 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : LineIndex.cpp
+// Desc : Line Index Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "LineIndex.h"
+#include "TextScanner.h"
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------
+//      行の種別を判定します.
+//-------------------------------------------------------------------------------------------------
+LINE_TYPE ClassifyLine(const char* pHead, const char* pTail)
+{
+    // ヘッダ解析と同じく，行頭 (インデント無し) の "//" のみコメントとみなす.
+    if (pTail - pHead >= 2 && pHead[0] == '/' && pHead[1] == '/')
+    { return LINE_TYPE_COMMENT; }
+
+    for(auto p = pHead; p < pTail; ++p)
+    {
+        if (*p != ' ' && *p != '\t')
+        { return LINE_TYPE_INSTRUCTION; }
+    }
+
+    return LINE_TYPE_BLANK;
+}
+
+} // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LineIndex class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+LineIndex::LineIndex()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+LineIndex::~LineIndex()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      行の索引を作成します.
+//-------------------------------------------------------------------------------------------------
+void LineIndex::Build(const char* pBuffer, size_t size)
+{
+    Clear();
+    m_pBuffer = pBuffer;
+
+    auto pCur = pBuffer;
+    auto pEnd = pBuffer + size;
+
+    auto first = true;
+    while (pCur < pEnd)
+    {
+        auto pHead = pCur;
+        auto pTail = TextScanner::FindLineEnd(pCur, pEnd);
+        pCur = (pTail < pEnd) ? pTail + 1 : pEnd;
+
+        // テキストモード読み込みと同様に復帰コードは取り除く.
+        if (pTail > pHead && pTail[-1] == '\r')
+        { pTail--; }
+
+        Line line = {};
+        line.Offset = static_cast<size_t>(pHead - pBuffer);
+        line.Size   = static_cast<uint32_t>(pTail - pHead);
+        line.Type   = ClassifyLine(pHead, pTail);
+
+        if (line.Type == LINE_TYPE_INSTRUCTION)
+        {
+            if (first)
+            {
+                m_FirstInstruction = m_Lines.size();
+                first = false;
+            }
+            m_InstructionCount++;
+        }
+
+        m_Lines.push_back(line);
+    }
+
+    if (first)
+    { m_FirstInstruction = m_Lines.size(); }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      索引を破棄します.
+//-------------------------------------------------------------------------------------------------
+void LineIndex::Clear()
+{
+    m_pBuffer           = nullptr;
+    m_InstructionCount  = 0;
+    m_FirstInstruction  = 0;
+    m_Lines.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      行数を取得します.
+//-------------------------------------------------------------------------------------------------
+size_t LineIndex::GetCount() const
+{ return m_Lines.size(); }
+
+//-------------------------------------------------------------------------------------------------
+//      行情報を取得します.
+//-------------------------------------------------------------------------------------------------
+const LineIndex::Line& LineIndex::GetLine(size_t index) const
+{ return m_Lines[index]; }
+
+//-------------------------------------------------------------------------------------------------
+//      行の文字列を取得します.
+//-------------------------------------------------------------------------------------------------
+std::string_view LineIndex::GetText(size_t index) const
+{
+    auto& line = m_Lines[index];
+    return std::string_view(m_pBuffer + line.Offset, line.Size);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      命令行の数を取得します.
+//-------------------------------------------------------------------------------------------------
+size_t LineIndex::GetInstructionCount() const
+{ return m_InstructionCount; }
+
+//-------------------------------------------------------------------------------------------------
+//      最初の命令行の番号を取得します.
+//-------------------------------------------------------------------------------------------------
+size_t LineIndex::GetFirstInstruction() const
+{ return m_FirstInstruction; }
@@ -0,0 +1,111 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : LineIndex.h
+// Desc : Line Index Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LINE_TYPE enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum LINE_TYPE : uint8_t
+{
+    LINE_TYPE_BLANK         = 0x0,      //!< 空行 (空白のみ).
+    LINE_TYPE_COMMENT       = 0x1,      //!< 行頭が "//" のコメント行 (リフレクションのヘッダを含む).
+    LINE_TYPE_INSTRUCTION   = 0x2,      //!< 命令行.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LineIndex class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class LineIndex
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Line structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct Line
+    {
+        size_t      Offset;     //!< バッファ先頭からの行頭の位置.
+        uint32_t    Size;       //!< 改行コードを除いた行の長さ.
+        LINE_TYPE   Type;       //!< 行の種別.
+    };
+
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+    LineIndex();
+    ~LineIndex();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      バッファを1回走査して行の索引を作成します.
+    //!
+    //! @param[in]      pBuffer         テキストバッファ. 索引を使う間は呼び出し側で保持しておく必要があります.
+    //! @param[in]      size            バッファサイズ.
+    //---------------------------------------------------------------------------------------------
+    void Build(const char* pBuffer, size_t size);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      索引を破棄します. 確保済みのメモリは次の作成で再利用します.
+    //---------------------------------------------------------------------------------------------
+    void Clear();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      行数を取得します.
+    //---------------------------------------------------------------------------------------------
+    size_t GetCount() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      行情報を取得します.
+    //---------------------------------------------------------------------------------------------
+    const Line& GetLine(size_t index) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      改行コードを除いた行の文字列を取得します.
+    //---------------------------------------------------------------------------------------------
+    std::string_view GetText(size_t index) const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      命令行の数を取得します.
+    //---------------------------------------------------------------------------------------------
+    size_t GetInstructionCount() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      最初の命令行の番号を取得します. 命令行が無い場合は GetCount() を返却します.
+    //---------------------------------------------------------------------------------------------
+    size_t GetFirstInstruction() const;
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    const char*         m_pBuffer           = nullptr;  //!< テキストバッファ.
+    std::vector<Line>   m_Lines;                        //!< 行情報.
+    size_t              m_InstructionCount  = 0;        //!< 命令行の数.
+    size_t              m_FirstInstruction  = 0;        //!< 最初の命令行の番号.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    LineIndex       (const LineIndex&) = delete;
+    void operator = (const LineIndex&) = delete;
+};
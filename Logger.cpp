@@ -0,0 +1,99 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Logger.cpp
+// Desc : Thread Safe Logger Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "Logger.h"
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <utility>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------
+// Global Variables.
+//-------------------------------------------------------------------------------------------------
+std::mutex                              g_Mutex;            // ストリーム書き込み用ミューテックス.
+thread_local bool                       g_Capturing = false;// キャプチャ中かどうか.
+thread_local std::vector<LogRecord>     g_Records;          // キャプチャしたメッセージ.
+
+} // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Logger class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      メッセージを出力します.
+//-------------------------------------------------------------------------------------------------
+void Logger::Print(FILE* pStream, const char* format, ...)
+{
+    char buf[4096];
+    std::string text;
+
+    va_list arg;
+    va_list copy;
+
+    va_start( arg, format );
+    va_copy( copy, arg );
+
+    // 長いパスや区切りの無い行で処理全体が落ちないように，収まらない場合は必要な長さで整形し直す.
+    auto length = vsnprintf( buf, sizeof(buf), format, arg );
+    if (length >= int(sizeof(buf)))
+    {
+        text.resize(size_t(length));
+        vsnprintf( &text[0], text.size() + 1, format, copy );
+    }
+    else if (length > 0)
+    { text = buf; }
+
+    va_end( copy );
+    va_end( arg );
+
+    if (g_Capturing)
+    {
+        g_Records.push_back({ pStream, std::move(text) });
+        return;
+    }
+
+    std::lock_guard<std::mutex> locker(g_Mutex);
+    fputs(text.c_str(), pStream);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      呼び出しスレッドの出力のキャプチャを開始します.
+//-------------------------------------------------------------------------------------------------
+void Logger::BeginCapture()
+{
+    g_Records.clear();
+    g_Capturing = true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      呼び出しスレッドの出力のキャプチャを終了します.
+//-------------------------------------------------------------------------------------------------
+std::vector<LogRecord> Logger::EndCapture()
+{
+    g_Capturing = false;
+
+    std::vector<LogRecord> result;
+    result.swap(g_Records);
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      蓄積されたメッセージをまとめて書き出します.
+//-------------------------------------------------------------------------------------------------
+void Logger::Flush(const std::vector<LogRecord>& records)
+{
+    std::lock_guard<std::mutex> locker(g_Mutex);
+    for(auto& itr : records)
+    { fputs(itr.Text.c_str(), itr.pStream); }
+}
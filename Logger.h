@@ -0,0 +1,70 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Logger.h
+// Desc : Thread Safe Logger Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// LogRecord structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct LogRecord
+{
+    FILE*           pStream;    //!< 出力先ストリーム.
+    std::string     Text;       //!< 整形済みメッセージ.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Logger class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class Logger
+{
+    //============================================================================================
+    // list of friend classes and methods.
+    //============================================================================================
+    /* NOTHING */
+
+public:
+    //============================================================================================
+    // public varaibles.
+    //============================================================================================
+    /* NOTHING */
+
+    //============================================================================================
+    // public methods.
+    //============================================================================================
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      メッセージを出力します.
+    //!
+    //! @note       呼び出しスレッドがキャプチャ中の場合はバッファに蓄積し，
+    //!             そうでなければロックを取ってストリームに書き出します.
+    //!             最大4096文字まで.
+    //--------------------------------------------------------------------------------------------
+    static void Print(FILE* pStream, const char* format, ...);
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      呼び出しスレッドの出力のキャプチャを開始します.
+    //--------------------------------------------------------------------------------------------
+    static void BeginCapture();
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      呼び出しスレッドの出力のキャプチャを終了します.
+    //!
+    //! @return     キャプチャ中に蓄積されたメッセージを返却します.
+    //--------------------------------------------------------------------------------------------
+    static std::vector<LogRecord> EndCapture();
+
+    //--------------------------------------------------------------------------------------------
+    //! @brief      蓄積されたメッセージをまとめて書き出します.
+    //--------------------------------------------------------------------------------------------
+    static void Flush(const std::vector<LogRecord>& records);
+};
@@ -0,0 +1,135 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : MappedFile.cpp
+// Desc : Memory Mapped File Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "MappedFile.h"
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif//WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif//NOMINMAX
+#include <Windows.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MappedFile class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+MappedFile::MappedFile()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{ Close(); }
+
+//-------------------------------------------------------------------------------------------------
+//      ファイルを読み取り専用でマッピングします.
+//-------------------------------------------------------------------------------------------------
+bool MappedFile::Open(const char* filename)
+{
+    Close();
+
+    auto hFile = CreateFileA(
+        filename,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    { return false; }
+
+    m_hFile = hFile;
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(hFile, &size) || size.QuadPart <= 0)
+    {
+        // 空ファイルはマッピングできない.
+        Close();
+        return false;
+    }
+
+    auto hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (hMapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_hMapping = hMapping;
+
+    auto pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (pView == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_pData = static_cast<const char*>(pView);
+    m_Size  = static_cast<size_t>(size.QuadPart);
+
+    // ページ末尾まではゼロで埋められるので，端数があればnull終端が保証される.
+    SYSTEM_INFO info = {};
+    GetSystemInfo(&info);
+    m_Terminated = (m_Size % info.dwPageSize) != 0;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      マッピングを解除します.
+//-------------------------------------------------------------------------------------------------
+void MappedFile::Close()
+{
+    if (m_pData != nullptr)
+    {
+        UnmapViewOfFile(m_pData);
+        m_pData = nullptr;
+    }
+
+    if (m_hMapping != nullptr)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+
+    if (m_hFile != nullptr)
+    {
+        CloseHandle(m_hFile);
+        m_hFile = nullptr;
+    }
+
+    m_Size       = 0;
+    m_Terminated = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      マッピングされたデータの先頭ポインタを取得します.
+//-------------------------------------------------------------------------------------------------
+const char* MappedFile::GetData() const
+{ return m_pData; }
+
+//-------------------------------------------------------------------------------------------------
+//      ファイルサイズを取得します.
+//-------------------------------------------------------------------------------------------------
+size_t MappedFile::GetSize() const
+{ return m_Size; }
+
+//-------------------------------------------------------------------------------------------------
+//      null終端が保証されているかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool MappedFile::IsTerminated() const
+{ return m_Terminated; }
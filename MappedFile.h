@@ -0,0 +1,84 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : MappedFile.h
+// Desc : Memory Mapped File Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MappedFile class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class MappedFile
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+    MappedFile();
+    ~MappedFile();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ファイルを読み取り専用でマッピングします.
+    //!
+    //! @param[in]      filename        ファイル名.
+    //! @retval true    マッピングに成功.
+    //! @retval false   マッピングに失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Open(const char* filename);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      マッピングを解除します.
+    //---------------------------------------------------------------------------------------------
+    void Close();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      マッピングされたデータの先頭ポインタを取得します.
+    //---------------------------------------------------------------------------------------------
+    const char* GetData() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ファイルサイズを取得します.
+    //---------------------------------------------------------------------------------------------
+    size_t GetSize() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      データの直後にnull終端文字が存在することが保証されているかチェックします.
+    //!
+    //! @note       ビューはページ単位で確保され，ファイル末尾以降はゼロで埋められるため，
+    //!             ファイルサイズがページサイズの倍数でなければ終端が保証されます.
+    //---------------------------------------------------------------------------------------------
+    bool IsTerminated() const;
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    void*           m_hFile         = nullptr;  //!< ファイルハンドル.
+    void*           m_hMapping      = nullptr;  //!< マッピングハンドル.
+    const char*     m_pData         = nullptr;  //!< ビューの先頭ポインタ.
+    size_t          m_Size          = 0;        //!< ファイルサイズ.
+    bool            m_Terminated    = false;    //!< null終端が保証されるかどうか.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    MappedFile      (const MappedFile&) = delete;
+    void operator = (const MappedFile&) = delete;
+};
@@ -0,0 +1,453 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Opcode.cpp
+// Desc : Assembly Opcode Table.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "Opcode.h"
+#include "Hash.h"
+#include <algorithm>
+
+
+namespace {
+
+using namespace a3d;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+constexpr OpcodeInfo kOpcodeTable[] = {
+    // Shader Model 4.0
+    { "add"                             , OPCODE_ADD                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_BINARY            , "+"                 , ""  },
+    { "and"                             , OPCODE_AND                             , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_LOGIC             , "&"                 , ""  },
+    { "break"                           , OPCODE_BREAK                           , 4, OPCODE_FLAG_NONE                                                        , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "breakc"                          , OPCODE_BREAKC                          , 4, OPCODE_FLAG_NONE                                                        , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "call"                            , OPCODE_CALL                            , 4, OPCODE_FLAG_NONE                                                        , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "callc"                           , OPCODE_CALLC                           , 4, OPCODE_FLAG_NONE                                                        , 0, 2, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "case"                            , OPCODE_CASE                            , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "cut"                             , OPCODE_CUT                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "continue"                        , OPCODE_CONTINUE                        , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "continuec"                       , OPCODE_CONTINUEC                       , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_constantBuffer"              , OPCODE_DCL_CONSTANT_BUFFER             , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_globalFlags"                 , OPCODE_DCL_GLOBAL_FLAGS                , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_immediateConstantBuffer"     , OPCODE_DCL_IMMEDIATE_CONSTANT_BUFFER   , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_indexableTemp"               , OPCODE_DCL_INDEXABLE_TEMP              , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_indexRange"                  , OPCODE_DCL_INDEX_RANGE                 , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_input"                       , OPCODE_DCL_INPUT                       , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_inputPrimitive"              , OPCODE_DCL_INPUT_PRIMITIVE             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_input_sv"                    , OPCODE_DCL_INPUT_SV                    , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_maxOutputVertexCount"        , OPCODE_DCL_MAX_OUTPUT_VERTEX_COUNT     , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_output"                      , OPCODE_DCL_OUTPUT                      , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_output_sgv"                  , OPCODE_DCL_OUTPUT_SGV                  , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_output_siv"                  , OPCODE_DCL_OUTPUT_SIV                  , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_outputTopology"              , OPCODE_DCL_OUTPUT_TOPOLOGY             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_resource"                    , OPCODE_DCL_RESOURCE                    , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_resource_raw"                , OPCODE_DCL_RESOURCE_RAW                , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_resource_structured"         , OPCODE_DCL_RESOURCE_STRUCTURED         , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_sampler"                     , OPCODE_DCL_SAMPLER                     , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_temps"                       , OPCODE_DCL_TEMPS                       , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_tgsm_raw"                    , OPCODE_DCL_TGSM_RAW                    , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE                                , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_tgsm_structured"             , OPCODE_DCL_TGSM_STRUCTURED             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE                                , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_thread_group"                , OPCODE_DCL_THREAD_GROUP                , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE                                , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_uav_raw"                     , OPCODE_DCL_UAV_RAW                     , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_uav_structured"              , OPCODE_DCL_UAV_STRUCTURED              , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "default"                         , OPCODE_DEFAULT                         , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "deriv_rtx"                       , OPCODE_DERIV_RTX                       , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE | OPCODE_FLAG_PIXEL           , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "ddx"               , ""  },
+    { "deriv_rty"                       , OPCODE_DERIV_RTY                       , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE | OPCODE_FLAG_PIXEL           , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "ddy"               , ""  },
+    { "discard"                         , OPCODE_DISCARD                         , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_PIXEL                                  , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "div"                             , OPCODE_DIV                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_BINARY            , "/"                 , ""  },
+    { "dp2"                             , OPCODE_DP2                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 2, DATA_TYPE_FLOAT , EMIT_DOT               , "dot"               , ""  },
+    { "dp3"                             , OPCODE_DP3                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 3, DATA_TYPE_FLOAT , EMIT_DOT               , "dot"               , ""  },
+    { "dp4"                             , OPCODE_DP4                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 4, DATA_TYPE_FLOAT , EMIT_DOT               , "dot"               , ""  },
+    { "else"                            , OPCODE_ELSE                            , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "emit"                            , OPCODE_EMIT                            , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "emitThenCut"                     , OPCODE_EMIT_THEN_CUT                   , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "endif"                           , OPCODE_ENDIF                           , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "endloop"                         , OPCODE_ENDLOOP                         , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "endswitch"                       , OPCODE_ENDSWITCH                       , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "eq"                              , OPCODE_EQ                              , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_COMPARE           , "=="                , ""  },
+    { "exp"                             , OPCODE_EXP                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "exp"               , ""  },
+    { "frc"                             , OPCODE_FRC                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "frac"              , ""  },
+    { "ftoi"                            , OPCODE_FTOI                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_CONVERT_FROM_FLOAT, "asint"             , ""  },
+    { "ftou"                            , OPCODE_FTOU                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_CONVERT_FROM_FLOAT, "asuint"            , ""  },
+    { "gather4"                         , OPCODE_GATHER4                         , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 3, 0, DATA_TYPE_NONE  , EMIT_SAMPLE            , "Gather"            , ""  },
+    { "ge"                              , OPCODE_GE                              , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_COMPARE           , ">="                , ""  },
+    { "iadd"                            , OPCODE_IADD                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_BINARY            , "+"                 , ""  },
+    { "ieq"                             , OPCODE_IEQ                             , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_COMPARE           , "=="                , ""  },
+    { "if"                              , OPCODE_IF                              , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ige"                             , OPCODE_IGE                             , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_COMPARE           , ">="                , ""  },
+    { "ilt"                             , OPCODE_ILT                             , 4, OPCODE_FLAG_NONE                                                        , 1, 2, 0, DATA_TYPE_INT   , EMIT_COMPARE           , "<"                 , ""  },
+    { "imad"                            , OPCODE_IMAD                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 3, 0, DATA_TYPE_INT   , EMIT_MULTIPLY_ADD      , "*"                 , "+" },
+    { "imax"                            , OPCODE_IMAX                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_FUNCTION          , "max"               , ""  },
+    { "imin"                            , OPCODE_IMIN                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_FUNCTION          , "min"               , ""  },
+    { "imul"                            , OPCODE_IMUL                            , 4, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "ine"                             , OPCODE_INE                             , 4, OPCODE_FLAG_NONE                                                        , 1, 2, 0, DATA_TYPE_INT   , EMIT_COMPARE           , "!="                , ""  },
+    { "ineg"                            , OPCODE_INEG                            , 4, OPCODE_FLAG_NONE                                                        , 1, 1, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "ishl"                            , OPCODE_ISHL                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_BINARY            , "<<"                , ""  },
+    { "ishr"                            , OPCODE_ISHR                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_BINARY            , ">>"                , ""  },
+    { "itof"                            , OPCODE_ITOF                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_INT   , EMIT_CONVERT_TO_FLOAT  , "asfloat"           , ""  },
+    { "label"                           , OPCODE_LABEL                           , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ld"                              , OPCODE_LD                              , 4, OPCODE_FLAG_NONE                                                        , 1, 2, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ld_raw"                          , OPCODE_LD_RAW                          , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 1, 2, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ld_structured"                   , OPCODE_LD_STRUCTURED                   , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 1, 3, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "log"                             , OPCODE_LOG                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "log"               , ""  },
+    { "loop"                            , OPCODE_LOOP                            , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "lt"                              , OPCODE_LT                              , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_COMPARE           , "<"                 , ""  },
+    { "mad"                             , OPCODE_MAD                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 3, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "mad"               , ""  },
+    { "max"                             , OPCODE_MAX                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "max"               , ""  },
+    { "min"                             , OPCODE_MIN                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "min"               , ""  },
+    { "mov"                             , OPCODE_MOV                             , 4, OPCODE_FLAG_SATURATE                                                    , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_MOVE              , ""                  , ""  },
+    { "movc"                            , OPCODE_MOVC                            , 4, OPCODE_FLAG_SATURATE                                                    , 1, 3, 0, DATA_TYPE_FLOAT , EMIT_SELECT            , ""                  , ""  },
+    { "mul"                             , OPCODE_MUL                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_BINARY            , "*"                 , ""  },
+    { "ne"                              , OPCODE_NE                              , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_FLOAT , EMIT_COMPARE           , "!="                , ""  },
+    { "nop"                             , OPCODE_NOP                             , 4, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "not"                             , OPCODE_NOT                             , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_UINT  , EMIT_FUNCTION          , "not"               , ""  },
+    { "or"                              , OPCODE_OR                              , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_LOGIC             , "|"                 , ""  },
+    { "resinfo"                         , OPCODE_RESINFO                         , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "retc"                            , OPCODE_RETC                            , 4, OPCODE_FLAG_NONE                                                        , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ret"                             , OPCODE_RET                             , 4, OPCODE_FLAG_NONE                                                        , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "round_ne"                        , OPCODE_ROUND_NE                        , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "round"             , ""  },
+    { "round_ni"                        , OPCODE_ROUND_NI                        , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "floor"             , ""  },
+    { "round_pi"                        , OPCODE_ROUND_PI                        , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "ceil"              , ""  },
+    { "round_z"                         , OPCODE_ROUND_Z                         , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "frac"              , ""  },
+    { "rsq"                             , OPCODE_RSQ                             , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "rsqrt"             , ""  },
+    { "sample"                          , OPCODE_SAMPLE                          , 4, OPCODE_FLAG_SATURATE                                                    , 1, 3, 0, DATA_TYPE_NONE  , EMIT_SAMPLE            , "Sample"            , ""  },
+    { "sample_b"                        , OPCODE_SAMPLE_B                        , 4, OPCODE_FLAG_SATURATE                                                    , 1, 4, 0, DATA_TYPE_NONE  , EMIT_SAMPLE            , "SampleBias"        , ""  },
+    { "sample_c"                        , OPCODE_SAMPLE_C                        , 4, OPCODE_FLAG_SATURATE                                                    , 1, 4, 0, DATA_TYPE_NONE  , EMIT_SAMPLE            , "SampleCmp"         , ""  },
+    { "sample_c_lz"                     , OPCODE_SAMPLE_C_LZ                     , 4, OPCODE_FLAG_SATURATE                                                    , 1, 4, 0, DATA_TYPE_NONE  , EMIT_SAMPLE            , "SampleCmpLevelZero", ""  },
+    { "sample_d"                        , OPCODE_SAMPLE_D                        , 4, OPCODE_FLAG_SATURATE                                                    , 1, 5, 0, DATA_TYPE_NONE  , EMIT_SAMPLE            , "SampleGrad"        , ""  },
+    { "sample_l"                        , OPCODE_SAMPLE_L                        , 4, OPCODE_FLAG_SATURATE                                                    , 1, 4, 0, DATA_TYPE_NONE  , EMIT_SAMPLE            , "SampleLevel"       , ""  },
+    { "sincos"                          , OPCODE_SINCOS                          , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 2, 1, 0, DATA_TYPE_FLOAT , EMIT_CUSTOM            , ""                  , ""  },
+    { "sqrt"                            , OPCODE_SQRT                            , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "sqrt"              , ""  },
+    { "store_raw"                       , OPCODE_STORE_RAW                       , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 1, 2, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "store_structured"                , OPCODE_STORE_STRUCTURED                , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 1, 3, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "switch"                          , OPCODE_SWITCH                          , 4, OPCODE_FLAG_NONE                                                        , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "sync"                            , OPCODE_SYNC                            , 4, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_COMPUTE | OPCODE_FLAG_SM5_ALL_STAGES   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "udiv"                            , OPCODE_UDIV                            , 4, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "uge"                             , OPCODE_UGE                             , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_COMPARE           , ">="                , ""  },
+    { "ult"                             , OPCODE_ULT                             , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_COMPARE           , "<"                 , ""  },
+    { "umad"                            , OPCODE_UMAD                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 3, 0, DATA_TYPE_UINT  , EMIT_MULTIPLY_ADD      , "*"                 , "+" },
+    { "umax"                            , OPCODE_UMAX                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_FUNCTION          , "max"               , ""  },
+    { "umin"                            , OPCODE_UMIN                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_FUNCTION          , "min"               , ""  },
+    { "umul"                            , OPCODE_UMUL                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_BINARY            , "*"                 , ""  },
+    { "ushr"                            , OPCODE_USHR                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_BINARY            , ">>"                , ""  },
+    { "utof"                            , OPCODE_UTOF                            , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_UINT  , EMIT_CONVERT_TO_FLOAT  , "asfloat"           , ""  },
+    { "xor"                             , OPCODE_XOR                             , 4, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_LOGIC             , "^"                 , ""  },
+
+    // Shader Model 5.0
+    { "atomic_and"                      , OPCODE_ATOMIC_AND                      , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "atomic_cmp_store"                , OPCODE_ATOMIC_CMP_STORE                , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 3, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "atomic_iadd"                     , OPCODE_ATOMIC_IADD                     , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "atomic_imax"                     , OPCODE_ATOMIC_IMAX                     , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "atomic_imin"                     , OPCODE_ATOMIC_IMIN                     , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "atomic_or"                       , OPCODE_ATOMIC_OR                       , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "atomic_umax"                     , OPCODE_ATOMIC_UMAX                     , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "atomic_umin"                     , OPCODE_ATOMIC_UMIN                     , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "atomic_xor"                      , OPCODE_ATOMIC_XOR                      , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "bfi"                             , OPCODE_BFI                             , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 4, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "bfrev"                           , OPCODE_BFREV                           , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_UINT  , EMIT_FUNCTION          , "reversebits"       , ""  },
+    { "bufinfo"                         , OPCODE_BUFINFO                         , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "countbits"                       , OPCODE_COUNTBITS                       , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_UINT  , EMIT_FUNCTION          , "countbits"         , ""  },
+    { "cut_stream"                      , OPCODE_CUT_STREAM                      , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dadd"                            , OPCODE_DADD                            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_BINARY            , "+"                 , ""  },
+    { "dcl_function_body"               , OPCODE_DCL_FUNCTION_BODY               , 5, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_function_table"              , OPCODE_DCL_FUNCTION_TABLE              , 5, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_hs_fork_phase_instance_count", OPCODE_DCL_HS_FORK_PHASE_INSTANCE_COUNT, 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_hs_join_phase_instance_count", OPCODE_DCL_HS_JOIN_PHASE_INSTANCE_COUNT, 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_hs_max_tessfactor"           , OPCODE_DCL_HS_MAX_TESSFACTOR           , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_input_control_point_count"   , OPCODE_DCL_INPUT_CONTROL_POINT_COUNT   , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL | OPCODE_FLAG_DOMAIN              , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_interface"                   , OPCODE_DCL_INTERFACE                   , 5, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_interface_dynamicindexed"    , OPCODE_DCL_INTERFACE_DYNAMICINDEXED    , 5, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_output_control_point_count"  , OPCODE_DCL_OUTPUT_CONTROL_POINT_COUNT  , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_stream"                      , OPCODE_DCL_STREAM                      , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_tessellator_domain"          , OPCODE_DCL_TESSELLATOR_DOMAIN          , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL | OPCODE_FLAG_DOMAIN              , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_tessellator_output_primitive", OPCODE_DCL_TESSELLATOR_OUTPUT_PRIMITIVE, 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_tessellator_partitioning"    , OPCODE_DCL_TESSELLATOR_PARTITIONING    , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "dcl_uav_typed"                   , OPCODE_DCL_UAV_TYPED                   , 5, OPCODE_FLAG_SUFFIX                                                      , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ddiv"                            , OPCODE_DDIV                            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_BINARY            , "/"                 , ""  },
+    { "deq"                             , OPCODE_DEQ                             , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_BINARY            , "=="                , ""  },
+    { "deriv_rtx_coarse"                , OPCODE_DERIV_RTX_COARSE                , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE | OPCODE_FLAG_PIXEL           , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "ddx_coarse"        , ""  },
+    { "deriv_rtx_fine"                  , OPCODE_DERIV_RTX_FINE                  , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE | OPCODE_FLAG_PIXEL           , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "ddx_fine"          , ""  },
+    { "deriv_rty_coarse"                , OPCODE_DERIV_RTY_COARSE                , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE | OPCODE_FLAG_PIXEL           , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "ddy_coarse"        , ""  },
+    { "deriv_rty_fine"                  , OPCODE_DERIV_RTY_FINE                  , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE | OPCODE_FLAG_PIXEL           , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "ddy_fine"          , ""  },
+    { "dfma"                            , OPCODE_DFMA                            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 3, 0, DATA_TYPE_DOUBLE, EMIT_FUNCTION          , "fma"               , ""  },
+    { "dge"                             , OPCODE_DGE                             , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_BINARY            , ">="                , ""  },
+    { "dlt"                             , OPCODE_DLT                             , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_BINARY            , "<"                 , ""  },
+    { "dmax"                            , OPCODE_DMAX                            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_FUNCTION          , "max"               , ""  },
+    { "dmin"                            , OPCODE_DMIN                            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_FUNCTION          , "min"               , ""  },
+    { "dmov"                            , OPCODE_DMOV                            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_DOUBLE, EMIT_MOVE              , ""                  , ""  },
+    { "dmovc"                           , OPCODE_DMOVC                           , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 3, 0, DATA_TYPE_DOUBLE, EMIT_SELECT            , ""                  , ""  },
+    { "dmul"                            , OPCODE_DMUL                            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_BINARY            , "*"                 , ""  },
+    { "dne"                             , OPCODE_DNE                             , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_DOUBLE, EMIT_BINARY            , "!="                , ""  },
+    { "drcp"                            , OPCODE_DRCP                            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_DOUBLE, EMIT_FUNCTION          , "rcp"               , ""  },
+    { "dtof"                            , OPCODE_DTOF                            , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_DOUBLE, EMIT_FUNCTION          , "asfloat"           , ""  },
+    { "dtoi"                            , OPCODE_DTOI                            , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_DOUBLE, EMIT_FUNCTION          , "int"               , ""  },
+    { "dtou"                            , OPCODE_DTOU                            , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_DOUBLE, EMIT_FUNCTION          , "uint"              , ""  },
+    { "emit_stream"                     , OPCODE_EMIT_STREAM                     , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "emitThenCut_stream"              , OPCODE_EMIT_THEN_CUT_STREAM            , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_GEOMETRY                               , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "f16tof32"                        , OPCODE_F16TOF32                        , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_UINT  , EMIT_FUNCTION          , "f16tof32"          , ""  },
+    { "f32tof16"                        , OPCODE_F32TOF16                        , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "f32tof16"          , ""  },
+    { "fcall"                           , OPCODE_FCALL                           , 5, OPCODE_FLAG_SUFFIX                                                      , 0, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "firstbit"                        , OPCODE_FIRSTBIT                        , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ftod"                            , OPCODE_FTOD                            , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "asdouble"          , ""  },
+    { "gather4_c"                       , OPCODE_GATHER4_C                       , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 4, 0, DATA_TYPE_NONE  , EMIT_SAMPLE            , "GatherCmp"         , ""  },
+    { "gather4_po"                      , OPCODE_GATHER4_PO                      , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 4, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "gather4_po_c"                    , OPCODE_GATHER4_PO_C                    , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 5, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "hs_control_point_phase"          , OPCODE_HS_CONTROL_POINT_PHASE          , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "hs_decls"                        , OPCODE_HS_DECLS                        , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "hs_fork_phase"                   , OPCODE_HS_FORK_PHASE                   , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "hs_join_phase"                   , OPCODE_HS_JOIN_PHASE                   , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_HULL                                   , 0, 0, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ibfe"                            , OPCODE_IBFE                            , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 3, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_alloc"                , OPCODE_IMM_ATOMIC_ALLOC                , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_and"                  , OPCODE_IMM_ATOMIC_AND                  , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_cmp_exch"             , OPCODE_IMM_ATOMIC_CMP_EXCH             , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 3, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_consume"              , OPCODE_IMM_ATOMIC_CONSUME              , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_exch"                 , OPCODE_IMM_ATOMIC_EXCH                 , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_iadd"                 , OPCODE_IMM_ATOMIC_IADD                 , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_imax"                 , OPCODE_IMM_ATOMIC_IMAX                 , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_imin"                 , OPCODE_IMM_ATOMIC_IMIN                 , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_INT   , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_or"                   , OPCODE_IMM_ATOMIC_OR                   , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_umax"                 , OPCODE_IMM_ATOMIC_UMAX                 , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_umin"                 , OPCODE_IMM_ATOMIC_UMIN                 , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "imm_atomic_xor"                  , OPCODE_IMM_ATOMIC_XOR                  , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "itod"                            , OPCODE_ITOD                            , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_INT   , EMIT_FUNCTION          , "double"            , ""  },
+    { "ld_uav_typed"                    , OPCODE_LD_UAV_TYPED                    , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "rcp"                             , OPCODE_RCP                             , 5, OPCODE_FLAG_SUFFIX | OPCODE_FLAG_SATURATE                               , 1, 1, 0, DATA_TYPE_FLOAT , EMIT_FUNCTION          , "rcp"               , ""  },
+    { "store_uav_typed"                 , OPCODE_STORE_UAV_TYPED                 , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 2, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "swapc"                           , OPCODE_SWAPC                           , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 3, 0, DATA_TYPE_NONE  , EMIT_CUSTOM            , ""                  , ""  },
+    { "uaddc"                           , OPCODE_UADDC                           , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "ubfe"                            , OPCODE_UBFE                            , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 3, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "usubb"                           , OPCODE_USUBB                           , 5, OPCODE_FLAG_SUFFIX                                                      , 2, 2, 0, DATA_TYPE_UINT  , EMIT_CUSTOM            , ""                  , ""  },
+    { "utod"                            , OPCODE_UTOD                            , 5, OPCODE_FLAG_SUFFIX                                                      , 1, 1, 0, DATA_TYPE_UINT  , EMIT_FUNCTION          , "double"            , ""  },
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ModifierInfo structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct ModifierInfo
+{
+    std::string_view    Suffix;     // 修飾子.
+    uint16_t            Flag;       // MODIFIER_FLAG.
+};
+
+constexpr ModifierInfo kModifierTable[] = {
+    { "_sat"        , MODIFIER_SATURATE  },
+    { "_aoffimmi"   , MODIFIER_AOFFIMMI  },
+    { "_indexable"  , MODIFIER_INDEXABLE },
+    { "_z"          , MODIFIER_TEST_Z    },
+    { "_nz"         , MODIFIER_TEST_NZ   },
+    { "_uint"       , MODIFIER_UINT      },
+    { "_rcpFloat"   , MODIFIER_RCP_FLOAT },
+    { "_hi"         , MODIFIER_HI        },
+    { "_lo"         , MODIFIER_LO        },
+    { "_shi"        , MODIFIER_SHI       },
+};
+
+constexpr size_t kOpcodeCount = sizeof(kOpcodeTable) / sizeof(kOpcodeTable[0]);
+constexpr size_t kSlotCount   = OpcodeSet::SlotCount;
+
+static_assert(kOpcodeCount == OPCODE_COUNT - 1, "kOpcodeTable does not match OPCODE_TYPE.");
+static_assert(kOpcodeCount * 4 <= kSlotCount, "OpcodeSet::SlotCount is too small.");
+
+constexpr int     kMinShaderModel = 4;
+constexpr int     kMaxShaderModel = 5;
+constexpr uint8_t kStageFlags[]   = {
+    OPCODE_FLAG_VERTEX,
+    OPCODE_FLAG_PIXEL,
+    OPCODE_FLAG_GEOMETRY,
+    OPCODE_FLAG_HULL,
+    OPCODE_FLAG_DOMAIN,
+    OPCODE_FLAG_COMPUTE,
+};
+constexpr size_t  kStageCount = sizeof(kStageFlags) / sizeof(kStageFlags[0]);
+
+//-------------------------------------------------------------------------------------------------
+//      命令表が OPCODE_TYPE の順に並んでいるかチェックします.
+//-------------------------------------------------------------------------------------------------
+constexpr bool IsSortedByOpcode()
+{
+    for(size_t i=0; i<kOpcodeCount; ++i)
+    {
+        if (kOpcodeTable[i].Opcode != static_cast<OPCODE_TYPE>(i + 1))
+        { return false; }
+    }
+    return true;
+}
+
+static_assert(IsSortedByOpcode(), "kOpcodeTable must be sorted by OPCODE_TYPE.");
+
+//-------------------------------------------------------------------------------------------------
+//      シェーダモデルとステージで使用できる命令かどうか判定します.
+//-------------------------------------------------------------------------------------------------
+constexpr bool IsAvailable(const OpcodeInfo& info, int shaderModel, uint8_t stage)
+{
+    auto stages = info.Flags & OPCODE_FLAG_STAGE_MASK;
+    if (shaderModel >= 5 && (info.Flags & OPCODE_FLAG_SM5_ALL_STAGES) != 0)
+    { stages = 0; }
+
+    return (info.ShaderModel <= shaderModel) && (stages == 0 || (stages & stage) != 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      オープンアドレス法のハッシュテーブルをコンパイル時に構築します.
+//-------------------------------------------------------------------------------------------------
+constexpr OpcodeSet CreateOpcodeSet(int shaderModel, uint8_t stage)
+{
+    OpcodeSet result = {};
+    for(size_t i=0; i<kOpcodeCount; ++i)
+    {
+        if (!IsAvailable(kOpcodeTable[i], shaderModel, stage))
+        { continue; }
+
+        auto slot = ComputeHash(kOpcodeTable[i].Mnemonic) & (kSlotCount - 1);
+        while (result.Index[slot] != 0)
+        { slot = (slot + 1) & (kSlotCount - 1); }
+
+        result.Index[slot] = static_cast<uint16_t>(i + 1);
+    }
+    return result;
+}
+
+// プロファイルごとの検索表 [シェーダモデル][ステージ]. 使わない命令を含めないので探索が短くなる.
+constexpr OpcodeSet kOpcodeSets[kMaxShaderModel - kMinShaderModel + 1][kStageCount] = {
+    {
+        CreateOpcodeSet(4, OPCODE_FLAG_VERTEX),
+        CreateOpcodeSet(4, OPCODE_FLAG_PIXEL),
+        CreateOpcodeSet(4, OPCODE_FLAG_GEOMETRY),
+        CreateOpcodeSet(4, OPCODE_FLAG_HULL),
+        CreateOpcodeSet(4, OPCODE_FLAG_DOMAIN),
+        CreateOpcodeSet(4, OPCODE_FLAG_COMPUTE),
+    },
+    {
+        CreateOpcodeSet(5, OPCODE_FLAG_VERTEX),
+        CreateOpcodeSet(5, OPCODE_FLAG_PIXEL),
+        CreateOpcodeSet(5, OPCODE_FLAG_GEOMETRY),
+        CreateOpcodeSet(5, OPCODE_FLAG_HULL),
+        CreateOpcodeSet(5, OPCODE_FLAG_DOMAIN),
+        CreateOpcodeSet(5, OPCODE_FLAG_COMPUTE),
+    },
+};
+
+// プロファイルが分からない場合に使う全ての命令を含む検索表.
+constexpr OpcodeSet kAllOpcodes = CreateOpcodeSet(kMaxShaderModel, OPCODE_FLAG_STAGE_MASK);
+
+//-------------------------------------------------------------------------------------------------
+//      完全一致する命令を検索します.
+//-------------------------------------------------------------------------------------------------
+const OpcodeInfo* Find(const OpcodeSet& set, std::string_view mnemonic)
+{
+    auto slot = ComputeHash(mnemonic) & (kSlotCount - 1);
+    while (set.Index[slot] != 0)
+    {
+        auto& info = kOpcodeTable[set.Index[slot] - 1];
+        if (info.Mnemonic == mnemonic)
+        { return &info; }
+
+        slot = (slot + 1) & (kSlotCount - 1);
+    }
+
+    return nullptr;
+}
+
+} // namespace
+
+
+namespace a3d {
+
+//-------------------------------------------------------------------------------------------------
+//      シェーダモデルとステージで使用できる命令の検索表を取得します.
+//-------------------------------------------------------------------------------------------------
+const OpcodeSet& GetOpcodeSet(int shaderModel, uint8_t stage)
+{
+    shaderModel = std::max(kMinShaderModel, std::min(kMaxShaderModel, shaderModel));
+
+    for(size_t i=0; i<kStageCount; ++i)
+    {
+        if (kStageFlags[i] == stage)
+        { return kOpcodeSets[shaderModel - kMinShaderModel][i]; }
+    }
+
+    return kAllOpcodes;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ニーモニックから命令を検索します.
+//-------------------------------------------------------------------------------------------------
+const OpcodeInfo* FindOpcode(std::string_view mnemonic, Modifier& modifier)
+{ return FindOpcode(kAllOpcodes, mnemonic, modifier); }
+
+//-------------------------------------------------------------------------------------------------
+//      検索表に含まれる命令からニーモニックで検索します.
+//-------------------------------------------------------------------------------------------------
+const OpcodeInfo* FindOpcode(const OpcodeSet& set, std::string_view mnemonic, Modifier& modifier)
+{
+    modifier.Flags = MODIFIER_NONE;
+
+    // 修飾子は命令の種別に影響しないので，末尾から取り除きながら探す.
+    // "round_z" のように修飾子と同じ綴りを含む命令もあるので，取り除く前に毎回完全一致を確認する.
+    auto pInfo = Find(set, mnemonic);
+    auto pos   = mnemonic.rfind('_');
+    while (pInfo == nullptr && pos != std::string_view::npos && pos > 0)
+    {
+        auto flag = FindModifier(mnemonic.substr(pos));
+        if (flag == MODIFIER_NONE)
+        { break; }
+
+        modifier.Flags |= flag;
+        mnemonic = mnemonic.substr(0, pos);
+
+        pInfo = Find(set, mnemonic);
+        pos   = mnemonic.rfind('_');
+    }
+
+    if (pInfo != nullptr)
+    { return pInfo; }
+
+    // 派生形は末尾を '_' 単位で削りながら，派生を受け付ける命令を探す.
+    while (pos != std::string_view::npos && pos > 0)
+    {
+        mnemonic = mnemonic.substr(0, pos);
+
+        pInfo = Find(set, mnemonic);
+        if (pInfo != nullptr)
+        { return ((pInfo->Flags & OPCODE_FLAG_SUFFIX) != 0) ? pInfo : nullptr; }
+
+        pos = mnemonic.rfind('_');
+    }
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      命令番号から命令情報を取得します.
+//-------------------------------------------------------------------------------------------------
+const OpcodeInfo& GetOpcodeInfo(OPCODE_TYPE opcode)
+{ return kOpcodeTable[opcode - 1]; }
+
+//-------------------------------------------------------------------------------------------------
+//      命令がシェーダモデルとステージで使用できるかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool IsSupported(OPCODE_TYPE opcode, int shaderModel, uint8_t stage)
+{
+    shaderModel = std::max(kMinShaderModel, std::min(kMaxShaderModel, shaderModel));
+    return IsAvailable(GetOpcodeInfo(opcode), shaderModel, stage);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      修飾子を検索します.
+//-------------------------------------------------------------------------------------------------
+uint16_t FindModifier(std::string_view suffix)
+{
+    for(auto& item : kModifierTable)
+    {
+        if (item.Suffix == suffix)
+        { return item.Flag; }
+    }
+
+    return MODIFIER_NONE;
+}
+
+} // namespace a3d
@@ -0,0 +1,427 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Opcode.h
+// Desc : Assembly Opcode Table.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <string_view>
+
+
+namespace a3d {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OPCODE_TYPE enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum OPCODE_TYPE : uint16_t
+{
+    OPCODE_UNKNOWN = 0,
+
+    // Shader Model 4.0
+    OPCODE_ADD,
+    OPCODE_AND,
+    OPCODE_BREAK,
+    OPCODE_BREAKC,
+    OPCODE_CALL,
+    OPCODE_CALLC,
+    OPCODE_CASE,
+    OPCODE_CUT,
+    OPCODE_CONTINUE,
+    OPCODE_CONTINUEC,
+    OPCODE_DCL_CONSTANT_BUFFER,
+    OPCODE_DCL_GLOBAL_FLAGS,
+    OPCODE_DCL_IMMEDIATE_CONSTANT_BUFFER,
+    OPCODE_DCL_INDEXABLE_TEMP,
+    OPCODE_DCL_INDEX_RANGE,
+    OPCODE_DCL_INPUT,
+    OPCODE_DCL_INPUT_PRIMITIVE,
+    OPCODE_DCL_INPUT_SV,
+    OPCODE_DCL_MAX_OUTPUT_VERTEX_COUNT,
+    OPCODE_DCL_OUTPUT,
+    OPCODE_DCL_OUTPUT_SGV,
+    OPCODE_DCL_OUTPUT_SIV,
+    OPCODE_DCL_OUTPUT_TOPOLOGY,
+    OPCODE_DCL_RESOURCE,
+    OPCODE_DCL_RESOURCE_RAW,
+    OPCODE_DCL_RESOURCE_STRUCTURED,
+    OPCODE_DCL_SAMPLER,
+    OPCODE_DCL_TEMPS,
+    OPCODE_DCL_TGSM_RAW,
+    OPCODE_DCL_TGSM_STRUCTURED,
+    OPCODE_DCL_THREAD_GROUP,
+    OPCODE_DCL_UAV_RAW,
+    OPCODE_DCL_UAV_STRUCTURED,
+    OPCODE_DEFAULT,
+    OPCODE_DERIV_RTX,
+    OPCODE_DERIV_RTY,
+    OPCODE_DISCARD,
+    OPCODE_DIV,
+    OPCODE_DP2,
+    OPCODE_DP3,
+    OPCODE_DP4,
+    OPCODE_ELSE,
+    OPCODE_EMIT,
+    OPCODE_EMIT_THEN_CUT,
+    OPCODE_ENDIF,
+    OPCODE_ENDLOOP,
+    OPCODE_ENDSWITCH,
+    OPCODE_EQ,
+    OPCODE_EXP,
+    OPCODE_FRC,
+    OPCODE_FTOI,
+    OPCODE_FTOU,
+    OPCODE_GATHER4,
+    OPCODE_GE,
+    OPCODE_IADD,
+    OPCODE_IEQ,
+    OPCODE_IF,
+    OPCODE_IGE,
+    OPCODE_ILT,
+    OPCODE_IMAD,
+    OPCODE_IMAX,
+    OPCODE_IMIN,
+    OPCODE_IMUL,
+    OPCODE_INE,
+    OPCODE_INEG,
+    OPCODE_ISHL,
+    OPCODE_ISHR,
+    OPCODE_ITOF,
+    OPCODE_LABEL,
+    OPCODE_LD,
+    OPCODE_LD_RAW,
+    OPCODE_LD_STRUCTURED,
+    OPCODE_LOG,
+    OPCODE_LOOP,
+    OPCODE_LT,
+    OPCODE_MAD,
+    OPCODE_MAX,
+    OPCODE_MIN,
+    OPCODE_MOV,
+    OPCODE_MOVC,
+    OPCODE_MUL,
+    OPCODE_NE,
+    OPCODE_NOP,
+    OPCODE_NOT,
+    OPCODE_OR,
+    OPCODE_RESINFO,
+    OPCODE_RETC,
+    OPCODE_RET,
+    OPCODE_ROUND_NE,
+    OPCODE_ROUND_NI,
+    OPCODE_ROUND_PI,
+    OPCODE_ROUND_Z,
+    OPCODE_RSQ,
+    OPCODE_SAMPLE,
+    OPCODE_SAMPLE_B,
+    OPCODE_SAMPLE_C,
+    OPCODE_SAMPLE_C_LZ,
+    OPCODE_SAMPLE_D,
+    OPCODE_SAMPLE_L,
+    OPCODE_SINCOS,
+    OPCODE_SQRT,
+    OPCODE_STORE_RAW,
+    OPCODE_STORE_STRUCTURED,
+    OPCODE_SWITCH,
+    OPCODE_SYNC,
+    OPCODE_UDIV,
+    OPCODE_UGE,
+    OPCODE_ULT,
+    OPCODE_UMAD,
+    OPCODE_UMAX,
+    OPCODE_UMIN,
+    OPCODE_UMUL,
+    OPCODE_USHR,
+    OPCODE_UTOF,
+    OPCODE_XOR,
+
+    // Shader Model 5.0
+    OPCODE_ATOMIC_AND,
+    OPCODE_ATOMIC_CMP_STORE,
+    OPCODE_ATOMIC_IADD,
+    OPCODE_ATOMIC_IMAX,
+    OPCODE_ATOMIC_IMIN,
+    OPCODE_ATOMIC_OR,
+    OPCODE_ATOMIC_UMAX,
+    OPCODE_ATOMIC_UMIN,
+    OPCODE_ATOMIC_XOR,
+    OPCODE_BFI,
+    OPCODE_BFREV,
+    OPCODE_BUFINFO,
+    OPCODE_COUNTBITS,
+    OPCODE_CUT_STREAM,
+    OPCODE_DADD,
+    OPCODE_DCL_FUNCTION_BODY,
+    OPCODE_DCL_FUNCTION_TABLE,
+    OPCODE_DCL_HS_FORK_PHASE_INSTANCE_COUNT,
+    OPCODE_DCL_HS_JOIN_PHASE_INSTANCE_COUNT,
+    OPCODE_DCL_HS_MAX_TESSFACTOR,
+    OPCODE_DCL_INPUT_CONTROL_POINT_COUNT,
+    OPCODE_DCL_INTERFACE,
+    OPCODE_DCL_INTERFACE_DYNAMICINDEXED,
+    OPCODE_DCL_OUTPUT_CONTROL_POINT_COUNT,
+    OPCODE_DCL_STREAM,
+    OPCODE_DCL_TESSELLATOR_DOMAIN,
+    OPCODE_DCL_TESSELLATOR_OUTPUT_PRIMITIVE,
+    OPCODE_DCL_TESSELLATOR_PARTITIONING,
+    OPCODE_DCL_UAV_TYPED,
+    OPCODE_DDIV,
+    OPCODE_DEQ,
+    OPCODE_DERIV_RTX_COARSE,
+    OPCODE_DERIV_RTX_FINE,
+    OPCODE_DERIV_RTY_COARSE,
+    OPCODE_DERIV_RTY_FINE,
+    OPCODE_DFMA,
+    OPCODE_DGE,
+    OPCODE_DLT,
+    OPCODE_DMAX,
+    OPCODE_DMIN,
+    OPCODE_DMOV,
+    OPCODE_DMOVC,
+    OPCODE_DMUL,
+    OPCODE_DNE,
+    OPCODE_DRCP,
+    OPCODE_DTOF,
+    OPCODE_DTOI,
+    OPCODE_DTOU,
+    OPCODE_EMIT_STREAM,
+    OPCODE_EMIT_THEN_CUT_STREAM,
+    OPCODE_F16TOF32,
+    OPCODE_F32TOF16,
+    OPCODE_FCALL,
+    OPCODE_FIRSTBIT,
+    OPCODE_FTOD,
+    OPCODE_GATHER4_C,
+    OPCODE_GATHER4_PO,
+    OPCODE_GATHER4_PO_C,
+    OPCODE_HS_CONTROL_POINT_PHASE,
+    OPCODE_HS_DECLS,
+    OPCODE_HS_FORK_PHASE,
+    OPCODE_HS_JOIN_PHASE,
+    OPCODE_IBFE,
+    OPCODE_IMM_ATOMIC_ALLOC,
+    OPCODE_IMM_ATOMIC_AND,
+    OPCODE_IMM_ATOMIC_CMP_EXCH,
+    OPCODE_IMM_ATOMIC_CONSUME,
+    OPCODE_IMM_ATOMIC_EXCH,
+    OPCODE_IMM_ATOMIC_IADD,
+    OPCODE_IMM_ATOMIC_IMAX,
+    OPCODE_IMM_ATOMIC_IMIN,
+    OPCODE_IMM_ATOMIC_OR,
+    OPCODE_IMM_ATOMIC_UMAX,
+    OPCODE_IMM_ATOMIC_UMIN,
+    OPCODE_IMM_ATOMIC_XOR,
+    OPCODE_ITOD,
+    OPCODE_LD_UAV_TYPED,
+    OPCODE_RCP,
+    OPCODE_STORE_UAV_TYPED,
+    OPCODE_SWAPC,
+    OPCODE_UADDC,
+    OPCODE_UBFE,
+    OPCODE_USUBB,
+    OPCODE_UTOD,
+
+    OPCODE_COUNT
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OPCODE_FLAG enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum OPCODE_FLAG : uint16_t
+{
+    OPCODE_FLAG_NONE    = 0,        // ニーモニックの完全一致のみ.
+    OPCODE_FLAG_SUFFIX      = 0x1,  // "_indexable", "_texture2d" などの派生形も受け付ける.
+    OPCODE_FLAG_SATURATE    = 0x2,  // "_sat" 修飾子を受け付ける.
+    OPCODE_FLAG_VERTEX      = 0x4,  // 頂点シェーダで使用できる.
+    OPCODE_FLAG_PIXEL       = 0x8,  // ピクセルシェーダで使用できる.
+    OPCODE_FLAG_GEOMETRY    = 0x10, // ジオメトリシェーダで使用できる.
+    OPCODE_FLAG_HULL        = 0x20, // ハルシェーダで使用できる.
+    OPCODE_FLAG_DOMAIN      = 0x40, // ドメインシェーダで使用できる.
+    OPCODE_FLAG_COMPUTE     = 0x80, // コンピュートシェーダで使用できる.
+    OPCODE_FLAG_STAGE_MASK  = 0xFC, // ステージの指定が無い命令は全てのステージで使用できる.
+    OPCODE_FLAG_SM5_ALL_STAGES = 0x100, // シェーダモデル5以降はステージの指定によらず使用できる (cs_4_x ではステージの指定に従う).
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// DATA_TYPE enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum DATA_TYPE : uint8_t
+{
+    DATA_TYPE_NONE = 0,     // 型を持たない (宣言, 制御命令, リソースアクセスなど).
+    DATA_TYPE_FLOAT,        // 32bit 浮動小数.
+    DATA_TYPE_INT,          // 32bit 符号付き整数.
+    DATA_TYPE_UINT,         // 32bit 符号無し整数.
+    DATA_TYPE_DOUBLE,       // 64bit 浮動小数.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// EMIT_TYPE enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum EMIT_TYPE : uint8_t
+{
+    EMIT_CUSTOM = 0,            // 命令ごとに個別に解析する.
+    EMIT_FUNCTION,              // A = Symbol(B, ...);
+    EMIT_BINARY,                // A = B Symbol C;
+    EMIT_MULTIPLY_ADD,          // A = B Symbol C Symbol2 D;
+    EMIT_COMPARE,               // A = (B Symbol C) ? 真 : 偽; を成分ごとに展開.
+    EMIT_LOGIC,                 // A = B Symbol C; を成分ごとに展開.
+    EMIT_CONVERT_FROM_FLOAT,    // A = Symbol(B); (浮動小数から整数へ).
+    EMIT_CONVERT_TO_FLOAT,      // A = Symbol(B); (整数から浮動小数へ).
+    EMIT_DOT,                   // A = dot(B, C); (Width 成分).
+    EMIT_MOVE,                  // A = B;
+    EMIT_SELECT,                // A = (B) ? C : D;
+    EMIT_SAMPLE,                // A = texture.Symbol(sampler, B, ...);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MODIFIER_FLAG enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum MODIFIER_FLAG : uint16_t
+{
+    MODIFIER_NONE       = 0,
+    MODIFIER_SATURATE   = 0x1,      // "_sat".
+    MODIFIER_PRECISE    = 0x2,      // "[precise]".
+    MODIFIER_AOFFIMMI   = 0x4,      // "_aoffimmi(u,v,w)".
+    MODIFIER_INDEXABLE  = 0x8,      // "_indexable(dimension)(type,type,type,type)".
+    MODIFIER_TEST_Z     = 0x10,     // "_z".
+    MODIFIER_TEST_NZ    = 0x20,     // "_nz".
+    MODIFIER_UINT       = 0x40,     // "_uint".
+    MODIFIER_RCP_FLOAT  = 0x80,     // "_rcpFloat".
+    MODIFIER_HI         = 0x100,    // "_hi" (firstbit).
+    MODIFIER_LO         = 0x200,    // "_lo" (firstbit).
+    MODIFIER_SHI        = 0x400,    // "_shi" (firstbit).
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Modifier structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Modifier
+{
+    uint16_t            Flags;          // MODIFIER_FLAG の組み合わせ.
+    int8_t              Offset[3];      // テクセルオフセット (u, v, w).
+    std::string_view    Dimension;      // リソースの次元 (例 : "texture2d").
+    std::string_view    ReturnType;     // リソースの戻り値型 (例 : "float").
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OperandSpan structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct OperandSpan
+{
+    uint32_t            Offset;         // 命令列テキストの先頭からの位置.
+    uint32_t            Length;         // 文字数.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Instruction structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  デコード済みの命令. 文字列は命令列テキストへの位置で持つので，テキストより長く保持しないこと.
+//  例) "mul_sat r0.xy, r1.xyxx, cb0[2].zwzz" の場合.
+//      Opcode       = OPCODE_MUL
+//      Modifiers    = MODIFIER_SATURATE
+//      OperandCount = 3
+//      Operand[0]   = "r0.xy"
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Instruction
+{
+    static constexpr int MaxOperand = 6;        // オペランドの最大数.
+
+    OPCODE_TYPE         Opcode;                 // 命令番号.
+    Modifier            Modifiers;              // 修飾子.
+    uint32_t            Line;                   // 行番号 (1始まり, バイナリでは命令の通し番号).
+    uint32_t            OperandCount;           // オペランド数.
+    OperandSpan         Operand[MaxOperand];    // 各オペランドの位置.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpcodeInfo structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct OpcodeInfo
+{
+    std::string_view    Mnemonic;       // ニーモニック.
+    OPCODE_TYPE         Opcode;         // 命令番号.
+    uint8_t             ShaderModel;    // 対応するシェーダモデル.
+    uint16_t            Flags;          // OPCODE_FLAG の組み合わせ.
+    uint8_t             DstCount;       // 出力オペランド数.
+    uint8_t             SrcCount;       // 入力オペランド数.
+    uint8_t             Width;          // 入力の成分数 (0 は出力先のマスクに従う).
+    DATA_TYPE           DataType;       // 演算の型.
+    EMIT_TYPE           Emit;           // HLSLの出力パターン.
+    std::string_view    Symbol;         // 出力パターンで使う関数名または演算子.
+    std::string_view    Symbol2;        // 出力パターンで使う2つ目の演算子.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpcodeSet structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  シェーダモデルとステージごとにコンパイル時に作成する命令の検索表 (オープンアドレス法).
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct OpcodeSet
+{
+    static constexpr size_t SlotCount = 1024;   // 2の累乗. 探索が短く済むように命令数の4倍以上を確保.
+
+    uint16_t            Index[SlotCount];       // 命令表の番号 + 1 (0 は空き).
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      シェーダモデルとステージで使用できる命令の検索表を取得します.
+//!
+//! @param[in]      shaderModel     シェーダモデルのメジャーバージョン (4 未満は 4, 5 より大きい場合は 5 として扱います).
+//! @param[in]      stage           OPCODE_FLAG_VERTEX ～ OPCODE_FLAG_COMPUTE のいずれか.
+//! @return     検索表を返却します. stage が不正な場合は全ての命令を含む検索表を返却します.
+//-------------------------------------------------------------------------------------------------
+const OpcodeSet& GetOpcodeSet(int shaderModel, uint8_t stage);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      ニーモニックから命令を検索します.
+//!
+//! @details    末尾の修飾子 ("_sat", "_indexable" など) を取り除きながら完全一致を探し，
+//!             見つからない場合は '_' 区切りで末尾を短くしながら OPCODE_FLAG_SUFFIX を持つ命令を探します.
+//!             括弧で続くオフセットやリソース型は呼び出し側で modifier に設定してください.
+//! @param[in]      mnemonic        ニーモニック (例 : "mul_sat", "sample_l_aoffimmi_indexable").
+//! @param[out]     modifier        取り除いた修飾子の格納先.
+//! @return     命令情報を返却します. 見つからない場合は nullptr.
+//-------------------------------------------------------------------------------------------------
+const OpcodeInfo* FindOpcode(std::string_view mnemonic, Modifier& modifier);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      検索表に含まれる命令からニーモニックで検索します.
+//!
+//! @param[in]      set             GetOpcodeSet() で取得した検索表.
+//! @param[in]      mnemonic        ニーモニック.
+//! @param[out]     modifier        取り除いた修飾子の格納先.
+//! @return     命令情報を返却します. 見つからない場合や検索表に含まれない場合は nullptr.
+//-------------------------------------------------------------------------------------------------
+const OpcodeInfo* FindOpcode(const OpcodeSet& set, std::string_view mnemonic, Modifier& modifier);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      命令番号から命令情報を取得します.
+//!
+//! @param[in]      opcode          命令番号 (OPCODE_UNKNOWN と OPCODE_COUNT は不可).
+//! @return     命令情報を返却します.
+//-------------------------------------------------------------------------------------------------
+const OpcodeInfo& GetOpcodeInfo(OPCODE_TYPE opcode);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      命令がシェーダモデルとステージで使用できるかチェックします.
+//!
+//! @param[in]      opcode          命令番号 (OPCODE_UNKNOWN と OPCODE_COUNT は不可).
+//! @param[in]      shaderModel     シェーダモデルのメジャーバージョン (GetOpcodeSet() と同じく丸めます).
+//! @param[in]      stage           OPCODE_FLAG_VERTEX ～ OPCODE_FLAG_COMPUTE のいずれか.
+//! @retval true    使用できる.
+//! @retval false   使用できない.
+//-------------------------------------------------------------------------------------------------
+bool IsSupported(OPCODE_TYPE opcode, int shaderModel, uint8_t stage);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      修飾子を検索します.
+//!
+//! @param[in]      suffix          '_' で始まる修飾子 (例 : "_uint").
+//! @return     MODIFIER_FLAG を返却します. 修飾子でない場合は MODIFIER_NONE.
+//-------------------------------------------------------------------------------------------------
+uint16_t FindModifier(std::string_view suffix);
+
+} // namespace a3d
@@ -0,0 +1,242 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Operand.cpp
+// Desc : Assembly Operand Lexer.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "Operand.h"
+
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// RegisterPrefix structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct RegisterPrefix
+{
+    std::string_view    Prefix;
+    a3d::OPERAND_TYPE   Type;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+const RegisterPrefix kRegisterPrefix[] = {
+    { "r",      a3d::OPERAND_TYPE_TEMP                      },
+    { "x",      a3d::OPERAND_TYPE_INDEXABLE_TEMP            },
+    { "v",      a3d::OPERAND_TYPE_INPUT                     },
+    { "o",      a3d::OPERAND_TYPE_OUTPUT                    },
+    { "cb",     a3d::OPERAND_TYPE_CONSTANT_BUFFER           },
+    { "icb",    a3d::OPERAND_TYPE_IMMEDIATE_CONSTANT_BUFFER },
+    { "t",      a3d::OPERAND_TYPE_TEXTURE                   },
+    { "s",      a3d::OPERAND_TYPE_SAMPLER                   },
+    { "u",      a3d::OPERAND_TYPE_UAV                       },
+    { "g",      a3d::OPERAND_TYPE_THREAD_GROUP_SHARED       },
+    { "l",      a3d::OPERAND_TYPE_LITERAL                   },
+    { "null",   a3d::OPERAND_TYPE_NULL                      },
+};
+
+//-------------------------------------------------------------------------------------------------
+//      英字かどうか判定します.
+//-------------------------------------------------------------------------------------------------
+inline bool IsAlpha(char c)
+{ return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'); }
+
+//-------------------------------------------------------------------------------------------------
+//      数字かどうか判定します.
+//-------------------------------------------------------------------------------------------------
+inline bool IsDigit(char c)
+{ return '0' <= c && c <= '9'; }
+
+//-------------------------------------------------------------------------------------------------
+//      空白かどうか判定します.
+//-------------------------------------------------------------------------------------------------
+inline bool IsBlank(char c)
+{ return c == ' ' || c == '\t' || c == '\r'; }
+
+//-------------------------------------------------------------------------------------------------
+//      スウィズル文字かどうか判定します.
+//-------------------------------------------------------------------------------------------------
+inline bool IsSwizzle(char c)
+{ return c == 'x' || c == 'y' || c == 'z' || c == 'w'; }
+
+//-------------------------------------------------------------------------------------------------
+//      即値やリテラル, キャスト済みの式を含むかどうか判定します.
+//-------------------------------------------------------------------------------------------------
+bool IsImmediate(std::string_view value)
+{
+    // StringHelper::GetSwizzle() と同じ判定 ("uint" は "int" に含まれる).
+    return value.find("float") != std::string_view::npos
+        || value.find("int")   != std::string_view::npos
+        || value.find("l(")    != std::string_view::npos;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      レジスタ名からレジスタの種別を判定します.
+//-------------------------------------------------------------------------------------------------
+a3d::OPERAND_TYPE ToOperandType(std::string_view prefix, bool hasNumber, std::string_view body)
+{
+    for(auto& itr : kRegisterPrefix)
+    {
+        if (itr.Prefix != prefix)
+        { continue; }
+
+        // リテラルは l(...) の形式のみ.
+        if (itr.Type == a3d::OPERAND_TYPE_LITERAL && body.substr(prefix.size(), 1) != "(")
+        { break; }
+
+        return itr.Type;
+    }
+
+    // 番号の付かない v, o で始まる名前は特殊レジスタ.
+    if (!hasNumber && !prefix.empty())
+    {
+        if (prefix[0] == 'v')
+        { return a3d::OPERAND_TYPE_INPUT_SYSTEM; }
+
+        if (prefix[0] == 'o')
+        { return a3d::OPERAND_TYPE_OUTPUT_SYSTEM; }
+    }
+
+    // 数値や展開済みのリテラル (float4(...) など) はレジスタを参照しない.
+    if (prefix.empty() || IsImmediate(body))
+    { return a3d::OPERAND_TYPE_LITERAL; }
+
+    return a3d::OPERAND_TYPE_UNKNOWN;
+}
+
+} // namespace
+
+
+namespace a3d {
+
+//-------------------------------------------------------------------------------------------------
+//      オペランドを構造化します.
+//-------------------------------------------------------------------------------------------------
+Operand ParseOperand(std::string_view text)
+{
+    Operand result = {};
+    result.Text           = text;
+    result.RegisterNumber = -1;
+
+    // 符号を取り除く.
+    auto body = text;
+    if (!body.empty() && body[0] == '-')
+    {
+        result.Negate = true;
+        body.remove_prefix(1);
+    }
+
+    // 絶対値記号を取り除く.
+    auto abs1 = body.find('|');
+    auto abs2 = body.rfind('|');
+    if (abs1 != std::string_view::npos && abs1 != abs2)
+    {
+        result.Abs = true;
+        body = body.substr(abs1 + 1, abs2 - abs1 - 1);
+    }
+    result.Body = body;
+
+    // スウィズルは最後の '.' 以降が xyzw の 1～4 文字の場合のみ.
+    // 添字の中の '.' (cb2[r0.x + 1] など) は対象外なので，最後の ']' より後ろだけを探す.
+    auto immediate = IsImmediate(body);
+    auto tail = body.rfind(']');
+    auto dot  = body.rfind('.');
+    if (tail != std::string_view::npos && dot != std::string_view::npos && dot < tail)
+    { dot = std::string_view::npos; }
+    result.Name = (immediate || dot == std::string_view::npos) ? body : body.substr(0, dot);
+    if (!immediate && dot != std::string_view::npos)
+    {
+        auto swizzle = body.substr(dot);
+        auto valid   = (2 <= swizzle.size() && swizzle.size() <= 5);
+        for(size_t i=1; i<swizzle.size() && valid; ++i)
+        { valid = IsSwizzle(swizzle[i]); }
+
+        if (valid)
+        { result.Swizzle = swizzle; }
+    }
+
+    // レジスタ名と添字.
+    auto bracketL = body.find('[');
+    auto bracketR = body.find(']');
+    result.Register = (bracketL != std::string_view::npos) ? body.substr(0, bracketL) : result.Name;
+    if (bracketL != std::string_view::npos && bracketR != std::string_view::npos)
+    { result.Element = body.substr(0, bracketR + 1); }
+
+    // 入れ子を考慮して最上位の添字を切り出す.
+    auto depth = 0;
+    size_t head = 0;
+    for(size_t i=bracketL; i<result.Name.size(); ++i)
+    {
+        if (result.Name[i] == '[')
+        {
+            if (depth++ == 0)
+            { head = i + 1; }
+        }
+        else if (result.Name[i] == ']' && depth > 0)
+        {
+            if (--depth == 0 && result.IndexCount < Operand::MaxIndex)
+            { result.Index[result.IndexCount++] = result.Name.substr(head, i - head); }
+        }
+    }
+
+    // 英字部分がレジスタの種別, 続く数字がレジスタ番号.
+    size_t alpha = 0;
+    while (alpha < result.Register.size() && IsAlpha(result.Register[alpha]))
+    { alpha++; }
+
+    size_t digit = alpha;
+    auto number = 0;
+    while (digit < result.Register.size() && IsDigit(result.Register[digit]))
+    {
+        number = number * 10 + (result.Register[digit] - '0');
+        digit++;
+    }
+
+    auto hasNumber = (digit > alpha);
+    if (hasNumber)
+    { result.RegisterNumber = number; }
+
+    result.Type = ToOperandType(result.Register.substr(0, alpha), hasNumber, body);
+
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      命令のオペランド列を分割します.
+//-------------------------------------------------------------------------------------------------
+int SplitOperands(std::string_view text, std::string_view* pResult, int maxCount)
+{
+    auto count = 0;
+    auto depth = 0;
+    size_t head = 0;
+
+    for(size_t i=0; i<=text.size() && count < maxCount; ++i)
+    {
+        auto c = (i < text.size()) ? text[i] : ',';
+        if (c == '(' || c == '[' || c == '{')
+        { depth++; }
+        else if ((c == ')' || c == ']' || c == '}') && depth > 0)
+        { depth--; }
+        else if (c == ',' && (depth == 0 || i == text.size()))
+        {
+            auto item = text.substr(head, i - head);
+            while (!item.empty() && IsBlank(item.front()))
+            { item.remove_prefix(1); }
+            while (!item.empty() && IsBlank(item.back()))
+            { item.remove_suffix(1); }
+
+            if (!item.empty())
+            { pResult[count++] = item; }
+
+            head = i + 1;
+        }
+    }
+
+    return count;
+}
+
+} // namespace a3d
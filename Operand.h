@@ -0,0 +1,89 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : Operand.h
+// Desc : Assembly Operand Lexer.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <string_view>
+
+
+namespace a3d {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OPERAND_TYPE enum
+///////////////////////////////////////////////////////////////////////////////////////////////////
+enum OPERAND_TYPE
+{
+    OPERAND_TYPE_UNKNOWN = 0,                   // 不明.
+    OPERAND_TYPE_TEMP,                          // r#
+    OPERAND_TYPE_INDEXABLE_TEMP,                // x#[]
+    OPERAND_TYPE_INPUT,                         // v#, v[]
+    OPERAND_TYPE_INPUT_SYSTEM,                  // vThreadID, vicp[][] などの特殊入力.
+    OPERAND_TYPE_OUTPUT,                        // o#, o[]
+    OPERAND_TYPE_OUTPUT_SYSTEM,                 // oDepth, oMask などの特殊出力.
+    OPERAND_TYPE_CONSTANT_BUFFER,               // cb#[]
+    OPERAND_TYPE_IMMEDIATE_CONSTANT_BUFFER,     // icb[]
+    OPERAND_TYPE_TEXTURE,                       // t#
+    OPERAND_TYPE_SAMPLER,                       // s#
+    OPERAND_TYPE_UAV,                           // u#
+    OPERAND_TYPE_THREAD_GROUP_SHARED,           // g#
+    OPERAND_TYPE_LITERAL,                       // l(...), 数値, float4(...) などの展開済みの即値.
+    OPERAND_TYPE_NULL,                          // null
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operand structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  各文字列は解析元のテキストを指すので，テキストより長く保持しないこと.
+//  例) "-|cb0[r1.x + 2].xyzw|" の場合.
+//      Text     = "-|cb0[r1.x + 2].xyzw|"
+//      Body     = "cb0[r1.x + 2].xyzw"
+//      Name     = "cb0[r1.x + 2]"
+//      Swizzle  = ".xyzw"
+//      Register = "cb0"
+//      Element  = "cb0[r1.x + 2]"
+//      Index[0] = "r1.x + 2"
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Operand
+{
+    static constexpr int MaxIndex = 3;          // 添字の最大数.
+
+    OPERAND_TYPE        Type;                   // レジスタの種別.
+    std::string_view    Text;                   // オペランド全体.
+    std::string_view    Body;                   // 符号と絶対値記号を除いたもの.
+    std::string_view    Name;                   // Body から最後の ']' より後ろの '.' 以降を除いたもの.
+    std::string_view    Swizzle;                // ".xyzw" 形式のスウィズル/マスク (無い場合は空).
+    std::string_view    Register;               // 最初の '[' より前の部分.
+    std::string_view    Element;                // 最初の ']' までの部分 (添字が無い場合は空).
+    std::string_view    Index[MaxIndex];        // 各添字の中身 (相対アドレスはそのままの文字列).
+    int                 IndexCount;             // 添字の数.
+    int                 RegisterNumber;         // レジスタ番号 (r3 なら 3, 無い場合は -1).
+    bool                Negate;                 // 符号反転されているかどうか.
+    bool                Abs;                    // 絶対値記号で囲まれているかどうか.
+};
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      オペランドを1回の走査で構造化します.
+//!
+//! @param[in]      text        オペランドの文字列.
+//! @return     解析結果を返却します.
+//-------------------------------------------------------------------------------------------------
+Operand ParseOperand(std::string_view text);
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      命令のオペランド列を ',' で分割します.
+//!
+//! @details    括弧の内側にある ',' では分割せず，各オペランドの前後の空白は取り除きます.
+//!             maxCount を超えるオペランドは格納しません.
+//! @param[in]      text        ニーモニックと修飾子を除いた命令の1行.
+//! @param[out]     pResult     オペランドの格納先.
+//! @param[in]      maxCount    格納先の要素数.
+//! @return     格納したオペランド数を返却します.
+//-------------------------------------------------------------------------------------------------
+int SplitOperands(std::string_view text, std::string_view* pResult, int maxCount);
+
+} // namespace a3d
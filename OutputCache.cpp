@@ -0,0 +1,314 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : OutputCache.cpp
+// Desc : Content Addressed Output Cache Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "OutputCache.h"
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+const char kEntryExt[] = ".hlsl";   // キャッシュエントリの拡張子.
+const char kTempExt[]  = ".tmp";    // 書き込み中の一時ファイルの拡張子.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Entry structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Entry
+{
+    std::filesystem::path               Path;       // ファイルパス.
+    std::filesystem::file_time_type     Time;       // 最終アクセス時刻.
+    uint64_t                            Size;       // ファイルサイズ.
+};
+
+} // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OutputCache class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+OutputCache::OutputCache()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+OutputCache::~OutputCache()
+{ Term(); }
+
+//-------------------------------------------------------------------------------------------------
+//      キャッシュディレクトリを設定します.
+//-------------------------------------------------------------------------------------------------
+bool OutputCache::Init(const std::string& directory, uint64_t capacity)
+{
+    if (capacity == 0)
+    { capacity = DefaultCapacity; }
+
+    // 同じ設定なら走査結果を引き継ぐ.
+    if (m_Directory == directory && m_Capacity == capacity)
+    { return true; }
+
+    Term();
+
+    std::error_code err;
+    std::filesystem::create_directories(directory, err);
+    if (!std::filesystem::is_directory(directory, err))
+    { return false; }
+
+    m_Directory = directory;
+    m_Capacity  = capacity;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      キャッシュを無効化します.
+//-------------------------------------------------------------------------------------------------
+void OutputCache::Term()
+{
+    m_Directory.clear();
+    m_Capacity  = 0;
+    m_UsedSize  = 0;
+    m_Scanned   = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      キャッシュが有効かどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool OutputCache::IsEnabled() const
+{ return !m_Directory.empty(); }
+
+//-------------------------------------------------------------------------------------------------
+//      キャッシュされた出力をファイルに書き出します.
+//-------------------------------------------------------------------------------------------------
+bool OutputCache::Restore(uint64_t key, const std::string& suffix, const std::string& filename)
+{
+    if (!IsEnabled())
+    { return false; }
+
+    std::error_code err;
+    auto path = GetPath(key, suffix);
+
+    // 他のプロセスに追い出された場合はコピーに失敗するのでキャッシュミス扱い.
+    if (!std::filesystem::copy_file(path, filename, std::filesystem::copy_options::overwrite_existing, err))
+    { return false; }
+
+    // LRU 判定用にアクセス時刻として更新日時を進めておく.
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), err);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      キャッシュされた出力をストリームに書き出します.
+//-------------------------------------------------------------------------------------------------
+bool OutputCache::Restore(uint64_t key, const std::string& suffix, FILE* pStream)
+{
+    if (!IsEnabled())
+    { return false; }
+
+    auto path = GetPath(key, suffix);
+
+    FILE* pFile;
+    auto ret = fopen_s(&pFile, path.c_str(), "rb");
+    if (ret != 0)
+    { return false; }
+
+    char buffer[64 * 1024];
+    auto success = true;
+    for(;;)
+    {
+        auto count = fread(buffer, 1, sizeof(buffer), pFile);
+        if (count == 0)
+        { break; }
+
+        if (fwrite(buffer, 1, count, pStream) != count)
+        {
+            success = false;
+            break;
+        }
+    }
+
+    success = success && !ferror(pFile);
+    fclose(pFile);
+
+    if (!success)
+    { return false; }
+
+    // LRU 判定用にアクセス時刻として更新日時を進めておく.
+    std::error_code err;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), err);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      キャッシュされた出力を読み込みます.
+//-------------------------------------------------------------------------------------------------
+bool OutputCache::Load(uint64_t key, const std::string& suffix, std::string& code)
+{
+    if (!IsEnabled())
+    { return false; }
+
+    auto path = GetPath(key, suffix);
+
+    FILE* pFile;
+    auto ret = fopen_s(&pFile, path.c_str(), "rb");
+    if (ret != 0)
+    { return false; }
+
+    code.clear();
+
+    char buffer[64 * 1024];
+    for(;;)
+    {
+        auto count = fread(buffer, 1, sizeof(buffer), pFile);
+        if (count == 0)
+        { break; }
+
+        code.append(buffer, count);
+    }
+
+    auto success = !ferror(pFile);
+    fclose(pFile);
+
+    if (!success)
+    { return false; }
+
+    // LRU 判定用にアクセス時刻として更新日時を進めておく.
+    std::error_code err;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), err);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      出力をキャッシュに登録します.
+//-------------------------------------------------------------------------------------------------
+bool OutputCache::Store(uint64_t key, const std::string& suffix, const std::string& code)
+{
+    if (!IsEnabled())
+    { return false; }
+
+    auto path = GetPath(key, suffix);
+
+    // 他のプロセスと衝突しないよう一時ファイル名は乱数で決める.
+    char temp[32];
+    sprintf_s(temp, ".%08x", std::random_device()());
+    auto tempPath = path + temp + kTempExt;
+
+    FILE* pFile;
+    auto ret = fopen_s(&pFile, tempPath.c_str(), "wb");
+    if (ret != 0)
+    { return false; }
+
+    auto written = fwrite(code.data(), 1, code.size(), pFile);
+    fclose(pFile);
+
+    std::error_code err;
+    if (written != code.size())
+    {
+        std::filesystem::remove(tempPath, err);
+        return false;
+    }
+
+    // 名前の変更はアトミックに行われるので，読み手には完成したファイルだけが見える.
+    std::filesystem::rename(tempPath, path, err);
+    if (err)
+    {
+        std::filesystem::remove(tempPath, err);
+        return false;
+    }
+
+    m_UsedSize += code.size();
+    if (!m_Scanned || m_UsedSize > m_Capacity)
+    { Evict(); }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ハッシュ値を計算します.
+//-------------------------------------------------------------------------------------------------
+uint64_t OutputCache::ComputeHash(const void* pData, size_t size, uint64_t seed)
+{ return a3d::ComputeHash(std::string_view(static_cast<const char*>(pData), size), seed); }
+
+//-------------------------------------------------------------------------------------------------
+//      キャッシュエントリのパスを取得します.
+//-------------------------------------------------------------------------------------------------
+std::string OutputCache::GetPath(uint64_t key, const std::string& suffix) const
+{
+    char name[32];
+    sprintf_s(name, "%016llx", static_cast<unsigned long long>(key));
+
+    auto path = std::filesystem::path(m_Directory) / (name + suffix);
+    return path.string();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      上限サイズを超えた分を古いものから削除します.
+//-------------------------------------------------------------------------------------------------
+void OutputCache::Evict()
+{
+    std::error_code err;
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+
+    // 他のプロセスも書き込むので，実際のディレクトリの内容から使用量を求める.
+    std::filesystem::directory_iterator itr(m_Directory, err);
+    for(; !err && itr != std::filesystem::directory_iterator(); itr.increment(err))
+    {
+        std::error_code fileErr;
+        if (!itr->is_regular_file(fileErr))
+        { continue; }
+
+        if (itr->path().extension() != kEntryExt)
+        { continue; }
+
+        Entry entry;
+        entry.Path = itr->path();
+        entry.Size = itr->file_size(fileErr);
+        entry.Time = itr->last_write_time(fileErr);
+        if (fileErr)
+        { continue; }
+
+        total += entry.Size;
+        entries.push_back(entry);
+    }
+
+    m_Scanned  = true;
+    m_UsedSize = total;
+
+    if (total <= m_Capacity)
+    { return; }
+
+    // 最後にアクセスされた時刻が古い順に並べる.
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs)
+    { return lhs.Time < rhs.Time; });
+
+    for(auto& entry : entries)
+    {
+        if (m_UsedSize <= m_Capacity)
+        { break; }
+
+        // 他のプロセスが先に削除していても構わない.
+        std::filesystem::remove(entry.Path, err);
+        m_UsedSize -= entry.Size;
+    }
+}
@@ -0,0 +1,127 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : OutputCache.h
+// Desc : Content Addressed Output Cache Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "Hash.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OutputCache class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class OutputCache
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    static constexpr uint64_t DefaultCapacity = 256ull * 1024 * 1024;    //!< 既定のキャッシュ上限サイズ.
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+    OutputCache();
+    ~OutputCache();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キャッシュディレクトリを設定します.
+    //!
+    //! @param[in]      directory       キャッシュディレクトリ.
+    //! @param[in]      capacity        キャッシュの上限サイズ(バイト). 0 の場合は既定値.
+    //! @retval true    初期化に成功.
+    //! @retval false   初期化に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Init(const std::string& directory, uint64_t capacity);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キャッシュを無効化します.
+    //---------------------------------------------------------------------------------------------
+    void Term();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キャッシュが有効かどうかチェックします.
+    //---------------------------------------------------------------------------------------------
+    bool IsEnabled() const;
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キャッシュされた出力をファイルに書き出します.
+    //!
+    //! @param[in]      key             キャッシュキー.
+    //! @param[in]      suffix          出力ファイルの接尾辞.
+    //! @param[in]      filename        書き出し先のファイル名.
+    //! @retval true    キャッシュヒットして書き出しに成功.
+    //! @retval false   キャッシュミス，または書き出しに失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Restore(uint64_t key, const std::string& suffix, const std::string& filename);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キャッシュされた出力をストリームに書き出します.
+    //!
+    //! @param[in]      key             キャッシュキー.
+    //! @param[in]      suffix          出力ファイルの接尾辞.
+    //! @param[in]      pStream         書き出し先のストリーム (標準出力など).
+    //! @retval true    キャッシュヒットして書き出しに成功.
+    //! @retval false   キャッシュミス，または書き出しに失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Restore(uint64_t key, const std::string& suffix, FILE* pStream);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      キャッシュされた出力を読み込みます.
+    //!
+    //! @param[in]      key             キャッシュキー.
+    //! @param[in]      suffix          出力ファイルの接尾辞.
+    //! @param[out]     code            読み込んだ出力の格納先.
+    //! @retval true    キャッシュヒットして読み込みに成功.
+    //! @retval false   キャッシュミス，または読み込みに失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Load(uint64_t key, const std::string& suffix, std::string& code);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      出力をキャッシュに登録します.
+    //!
+    //! @note       一時ファイルに書き込んでから名前を変更するので，
+    //!             同じキャッシュを共有する他のプロセスから書きかけのファイルは見えません.
+    //---------------------------------------------------------------------------------------------
+    bool Store(uint64_t key, const std::string& suffix, const std::string& code);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      ハッシュ値を計算します (FNV-1a, 64bit).
+    //!
+    //! @param[in]      pData           データ.
+    //! @param[in]      size            データサイズ.
+    //! @param[in]      seed            シード値 (直前のハッシュ値を渡すと連結したデータのハッシュになります).
+    //---------------------------------------------------------------------------------------------
+    static uint64_t ComputeHash(const void* pData, size_t size, uint64_t seed = a3d::kHashSeed);
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    std::string     m_Directory;                //!< キャッシュディレクトリ.
+    uint64_t        m_Capacity      = 0;        //!< キャッシュの上限サイズ.
+    uint64_t        m_UsedSize      = 0;        //!< 使用サイズの見積もり.
+    bool            m_Scanned       = false;    //!< 使用サイズを走査済みかどうか.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    std::string GetPath(uint64_t key, const std::string& suffix) const;
+    void Evict();
+
+    OutputCache     (const OutputCache&) = delete;
+    void operator = (const OutputCache&) = delete;
+};
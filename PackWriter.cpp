@@ -0,0 +1,277 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : PackWriter.cpp
+// Desc : Packed Output Archive Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "PackWriter.h"
+#include "OutputCache.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+
+namespace {
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+const char      kMagic[4]       = { 'H', 'P', 'A', 'K' };
+const size_t    kBufferSize     = 4 * 1024 * 1024;      // 書き込みバッファのサイズ.
+
+//-------------------------------------------------------------------------------------------------
+//      値をリトルエンディアンで追記します.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+void PushValue(std::vector<char>& buffer, T value)
+{
+    char bytes[sizeof(T)];
+    for(size_t i=0; i<sizeof(T); ++i)
+    { bytes[i] = static_cast<char>((value >> (i * 8)) & 0xff); }
+
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ヘッダを作成します.
+//-------------------------------------------------------------------------------------------------
+std::vector<char> MakeHeader(uint32_t entryCount, uint64_t indexOffset, uint64_t indexSize)
+{
+    std::vector<char> result(kMagic, kMagic + sizeof(kMagic));
+    result.reserve(PackWriter::HeaderSize);
+
+    PushValue(result, PackWriter::Version);
+    PushValue(result, entryCount);
+    PushValue(result, uint32_t(0));
+    PushValue(result, indexOffset);
+    PushValue(result, indexSize);
+
+    return result;
+}
+
+} // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PackWriter class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      コンストラクタです.
+//-------------------------------------------------------------------------------------------------
+PackWriter::PackWriter()
+{ /* DO_NOTHING */ }
+
+//-------------------------------------------------------------------------------------------------
+//      デストラクタです.
+//-------------------------------------------------------------------------------------------------
+PackWriter::~PackWriter()
+{ Close(); }
+
+//-------------------------------------------------------------------------------------------------
+//      パックファイルを作成します.
+//-------------------------------------------------------------------------------------------------
+bool PackWriter::Open(const char* filename)
+{
+    Close();
+
+    auto ret = fopen_s(&m_pFile, filename, "wb");
+    if (ret != 0)
+    {
+        m_pFile = nullptr;
+        return false;
+    }
+
+    m_Buffer.reserve(kBufferSize);
+    m_Entries.clear();
+    m_Pending.clear();
+    m_Sequence = 0;
+    m_Offset   = 0;
+    m_Failed = false;
+
+    // インデックスの位置は最後に確定するので，ヘッダは仮の値で書いておく.
+    auto header = MakeHeader(0, 0, 0);
+    Write(header.data(), header.size());
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      HLSLコードを追加します.
+//-------------------------------------------------------------------------------------------------
+bool PackWriter::Append(size_t sequence, const std::string& name, uint32_t shaderType, const std::string& code)
+{
+    // ハッシュはロック外で計算しておく.
+    Entry entry = {};
+    entry.Name       = name;
+    entry.ShaderType = shaderType;
+    entry.Size       = code.size();
+    entry.Hash       = OutputCache::ComputeHash(code.data(), code.size());
+
+    std::lock_guard<std::mutex> locker(m_Mutex);
+    if (m_pFile == nullptr)
+    { return false; }
+
+    // 書き出す番が来ていればそのまま書き込み，来ていなければ先行する変換を待つ.
+    if (sequence == m_Sequence)
+    {
+        WriteEntry(entry, code);
+    }
+    else
+    {
+        auto& pending = m_Pending[sequence];
+        pending.Entries.push_back(std::move(entry));
+        pending.Codes  .push_back(code);
+    }
+
+    return !m_Failed;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      順序番号の追加が終わったことを通知します.
+//-------------------------------------------------------------------------------------------------
+void PackWriter::Commit(size_t sequence)
+{
+    std::lock_guard<std::mutex> locker(m_Mutex);
+    if (m_pFile == nullptr)
+    { return; }
+
+    m_Pending[sequence].Committed = true;
+
+    // 先頭から途切れずに追加が終わっている分を書き出す.
+    for(auto itr = m_Pending.find(m_Sequence); itr != m_Pending.end() && itr->second.Committed; itr = m_Pending.find(m_Sequence))
+    {
+        WritePending(itr->second);
+        m_Pending.erase(itr);
+        m_Sequence++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      インデックスを書き出してファイルを閉じます.
+//-------------------------------------------------------------------------------------------------
+bool PackWriter::Close()
+{
+    std::lock_guard<std::mutex> locker(m_Mutex);
+    if (m_pFile == nullptr)
+    { return false; }
+
+    // Commit() されなかった分も順序番号の順に書き出しておく.
+    for(auto& itr : m_Pending)
+    { WritePending(itr.second); }
+    m_Pending.clear();
+
+    // 読み込み側で二分探索できるように，インデックスだけを名前順に並べる.
+    // データは順序番号の順に並んでいるので，同名の場合は位置で順序を決める.
+    std::sort(m_Entries.begin(), m_Entries.end(),
+        [](const Entry& lhs, const Entry& rhs)
+        {
+            if (lhs.Name != rhs.Name)
+            { return lhs.Name < rhs.Name; }
+            if (lhs.ShaderType != rhs.ShaderType)
+            { return lhs.ShaderType < rhs.ShaderType; }
+            return lhs.Offset < rhs.Offset;
+        });
+
+    std::vector<char> index;
+    std::vector<char> names;
+    index.reserve(m_Entries.size() * EntrySize);
+
+    for(auto& itr : m_Entries)
+    {
+        PushValue(index, itr.Offset);
+        PushValue(index, itr.Size);
+        PushValue(index, itr.Hash);
+        PushValue(index, static_cast<uint32_t>(names.size()));
+        PushValue(index, static_cast<uint32_t>(itr.Name.size()));
+        PushValue(index, itr.ShaderType);
+        PushValue(index, uint32_t(0));
+
+        names.insert(names.end(), itr.Name.begin(), itr.Name.end());
+    }
+
+    auto indexOffset = m_Offset;
+    Write(index.data(), index.size());
+    Write(names.data(), names.size());
+    Flush();
+
+    // 確定したインデックスの位置でヘッダを書き直す.
+    auto header = MakeHeader(
+        static_cast<uint32_t>(m_Entries.size()),
+        indexOffset,
+        index.size() + names.size());
+
+    if (fseek(m_pFile, 0, SEEK_SET) != 0
+     || fwrite(header.data(), 1, header.size(), m_pFile) != header.size())
+    { m_Failed = true; }
+
+    if (fclose(m_pFile) != 0)
+    { m_Failed = true; }
+
+    m_pFile = nullptr;
+    m_Entries.clear();
+    m_Buffer.clear();
+    m_Buffer.shrink_to_fit();
+
+    return !m_Failed;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      エントリのデータを書き込みます.
+//-------------------------------------------------------------------------------------------------
+void PackWriter::WriteEntry(Entry& entry, const std::string& code)
+{
+    entry.Offset = m_Offset;
+    Write(code.data(), code.size());
+
+    m_Entries.push_back(std::move(entry));
+}
+
+//-------------------------------------------------------------------------------------------------
+//      書き出し待ちのエントリを追加順に書き込みます.
+//-------------------------------------------------------------------------------------------------
+void PackWriter::WritePending(Pending& pending)
+{
+    for(size_t i=0; i<pending.Entries.size(); ++i)
+    { WriteEntry(pending.Entries[i], pending.Codes[i]); }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      バッファを介して書き込みます.
+//-------------------------------------------------------------------------------------------------
+void PackWriter::Write(const void* pData, size_t size)
+{
+    auto pBytes = static_cast<const char*>(pData);
+    m_Offset += size;
+
+    // バッファに収まらない大きなデータは溜めずに直接書き込む.
+    if (m_Buffer.size() + size > kBufferSize)
+    {
+        Flush();
+        if (size >= kBufferSize)
+        {
+            if (!m_Failed && fwrite(pBytes, 1, size, m_pFile) != size)
+            { m_Failed = true; }
+            return;
+        }
+    }
+
+    m_Buffer.insert(m_Buffer.end(), pBytes, pBytes + size);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      書き込みバッファを吐き出します.
+//-------------------------------------------------------------------------------------------------
+void PackWriter::Flush()
+{
+    if (!m_Buffer.empty() && !m_Failed)
+    {
+        if (fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_pFile) != m_Buffer.size())
+        { m_Failed = true; }
+    }
+
+    m_Buffer.clear();
+}
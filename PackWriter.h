@@ -0,0 +1,134 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : PackWriter.h
+// Desc : Packed Output Archive Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PackWriter class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//  パックファイルの構成 (リトルエンディアン).
+//
+//      Header          : Magic "HPAK", Version, EntryCount, Reserved, IndexOffset(64bit), IndexSize(64bit).
+//      Data            : 各シェーダのHLSLコードを連結したもの (終端文字無し, 追加時の順序番号順).
+//      Index           : Entry x EntryCount (名前順に整列済み).
+//      Name Table      : Entry::NameOffset から参照される名前文字列 (終端文字無し).
+//
+//      Entry           : Offset(64bit), Size(64bit), Hash(64bit), NameOffset, NameSize, ShaderType, Reserved.
+//
+//  Offset はファイル先頭から, NameOffset は Name Table の先頭からのバイト数です.
+//  Hash は OutputCache::ComputeHash() によるHLSLコードのハッシュ値です.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class PackWriter
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    static constexpr uint32_t   Version         = 1;    //!< ファイルフォーマットのバージョン.
+    static constexpr size_t     HeaderSize      = 32;   //!< ヘッダサイズ.
+    static constexpr size_t     EntrySize       = 40;   //!< インデックス1件のサイズ.
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+    PackWriter();
+    ~PackWriter();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      パックファイルを作成します.
+    //!
+    //! @param[in]      filename        ファイル名.
+    //! @retval true    作成に成功.
+    //! @retval false   作成に失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Open(const char* filename);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      HLSLコードを追加します. 複数スレッドから呼び出せます.
+    //!
+    //! @note       スレッドの終了順に依らず同じファイルになるように，データは順序番号の順に書き出します.
+    //!             先行する順序番号が Commit() されるまでは，コードをメモリに保持します.
+    //!
+    //! @param[in]      sequence        順序番号 (0始まりで，変換単位ごとに1つ).
+    //! @param[in]      name            エントリ名.
+    //! @param[in]      shaderType      シェーダの種別 (SHADER_TYPE).
+    //! @param[in]      code            HLSLコード.
+    //! @retval true    追加に成功.
+    //! @retval false   書き込みに失敗.
+    //---------------------------------------------------------------------------------------------
+    bool Append(size_t sequence, const std::string& name, uint32_t shaderType, const std::string& code);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      順序番号の追加が終わったことを通知します. 複数スレッドから呼び出せます.
+    //!
+    //! @param[in]      sequence        追加を終えた順序番号 (エントリが無い場合も呼び出すこと).
+    //---------------------------------------------------------------------------------------------
+    void Commit(size_t sequence);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      インデックスを書き出してファイルを閉じます.
+    //!
+    //! @retval true    全ての書き込みに成功.
+    //! @retval false   途中で書き込みに失敗した.
+    //---------------------------------------------------------------------------------------------
+    bool Close();
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    struct Entry
+    {
+        std::string     Name;           //!< エントリ名.
+        uint32_t        ShaderType;     //!< シェーダの種別.
+        uint64_t        Offset;         //!< データの位置.
+        uint64_t        Size;           //!< データサイズ.
+        uint64_t        Hash;           //!< データのハッシュ値.
+    };
+
+    struct Pending
+    {
+        bool                        Committed = false;  //!< 追加が終わったかどうか.
+        std::vector<Entry>          Entries;            //!< 書き出し待ちのエントリ.
+        std::vector<std::string>    Codes;              //!< 書き出し待ちのHLSLコード.
+    };
+
+    FILE*                   m_pFile     = nullptr;  //!< 書き込み先.
+    std::vector<char>       m_Buffer;               //!< 書き込みバッファ.
+    std::vector<Entry>      m_Entries;              //!< 書き出し済みのエントリ.
+    std::map<size_t, Pending> m_Pending;            //!< 先行する順序番号を待っているエントリ.
+    size_t                  m_Sequence  = 0;        //!< 次に書き出す順序番号.
+    uint64_t                m_Offset    = 0;        //!< 次に書き込む位置.
+    bool                    m_Failed    = false;    //!< 書き込みに失敗したかどうか.
+    std::mutex              m_Mutex;                //!< 追加処理の排他制御.
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    void WriteEntry(Entry& entry, const std::string& code);
+    void WritePending(Pending& pending);
+    void Write(const void* pData, size_t size);
+    void Flush();
+
+    PackWriter      (const PackWriter&) = delete;
+    void operator = (const PackWriter&) = delete;
+};
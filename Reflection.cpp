@@ -10,10 +10,17 @@
 #include "Reflection.h"
 #include "StringHelper.h"
 #include <cassert>
+#include <algorithm>
 
 
 namespace {
 
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+constexpr int kMaxConstantBufferSlots   = 4096;     // 定数バッファ1つ当たりのスロット数の上限 (float4 単位).
+constexpr int kMaxConstantBufferCount   = 256;      // 検索表に登録する定数バッファのレジスタ番号の上限.
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // ArrayInfo structure
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -125,6 +132,93 @@ std::string ToArrayElementString(int value, const std::vector<int>& arraySize)
     return result;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      シグニチャのマスクと異なる場合のみスウィズルを付加します.
+//-------------------------------------------------------------------------------------------------
+void AppendSwizzle(std::string& result, std::string_view swizzle, const std::string& mask)
+{
+    if (!swizzle.empty() && swizzle.substr(1) != mask)
+    { result += swizzle; }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      スウィズル文字を要素番号に変換します.
+//-------------------------------------------------------------------------------------------------
+int ToSwizzleIndex(char value)
+{
+    switch(value)
+    {
+    case 'y': return 1;
+    case 'z': return 2;
+    case 'w': return 3;
+    default:  return 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      定数バッファ変数の要素数に収まるようにスウィズルを補正して付加します.
+//-------------------------------------------------------------------------------------------------
+void AppendBufferSwizzle(std::string& result, std::string_view swizzle, int typeUsedCount)
+{
+    // スウィズル数 (先頭の '.' は含まない).
+    auto count = swizzle.empty() ? 0 : static_cast<int>(swizzle.size() - 1);
+    if (count == 0)
+    { return; }
+
+    // 1スロット当たりの要素数を求める.
+    auto elementCount = typeUsedCount % 4;
+    elementCount = (elementCount == 0) ? 4 : elementCount;
+
+    // 要素数を超えるものがあれば補正が必要.
+    bool err = false;
+    for(auto i=1; i<count; ++i)
+    {
+        if (ToSwizzleIndex(swizzle[i]) >= elementCount)
+        {
+            err = true;
+            break;
+        }
+    }
+
+    if (!err)
+    {
+        // スウィズル補正が必要ない場合はそのままくっつける.
+        result += swizzle;
+        return;
+    }
+
+    // 1文字ずつ直す (要素数を超えないようにインデックスをループさせる).
+    const char swz[4] = { 'x', 'y', 'z', 'w' };
+    result += ".";
+    for(auto i=0; i<count; ++i)
+    {
+        auto idx = ToSwizzleIndex(swizzle[i]) % elementCount;
+        assert(0 <= idx && idx <= 3);
+        result += swz[idx];
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//      定数バッファの添字をスロット番号に変換します.
+//-------------------------------------------------------------------------------------------------
+bool ToSlotIndex(std::string_view value, int& result)
+{
+    // 検索表は "%d" で書式化した添字で登録していたので，先頭の 0 などは一致させない.
+    if (value.empty() || value.size() > 4 || (value.size() > 1 && value[0] == '0'))
+    { return false; }
+
+    result = 0;
+    for(auto c : value)
+    {
+        if (c < '0' || '9' < c)
+        { return false; }
+
+        result = result * 10 + (c - '0');
+    }
+
+    return result < kMaxConstantBufferSlots;
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // BuiltInType structure
@@ -216,14 +310,17 @@ Reflection::~Reflection()
 //-------------------------------------------------------------------------------------------------
 void Reflection::Clear()
 {
-    m_InputDictionary.clear();
-    m_OutputDictionary.clear();
-    m_TextureDictionary.clear();
-    m_SamplerDictionary.clear();
+    m_InputDictionary.Clear();
+    m_OutputDictionary.Clear();
+    m_PatchConstantDictionary.Clear();
+    m_TextureDictionary.Clear();
+    m_SamplerDictionary.Clear();
     m_InputDefinitions.clear();
     m_InputDefinitions.shrink_to_fit();
     m_OutputDefinitions.clear();
     m_OutputDefinitions.shrink_to_fit();
+    m_PatchConstantDefinitions.clear();
+    m_PatchConstantDefinitions.shrink_to_fit();
     m_ConstantBufferDefinitions.clear();
     m_ConstantBufferDefinitions.shrink_to_fit();
     m_TextureDefinitions.clear();
@@ -236,8 +333,25 @@ void Reflection::Clear()
     m_InputSignatures.shrink_to_fit();
     m_OutputSignatures.clear();
     m_OutputSignatures.shrink_to_fit();
+    m_PatchConstantSignatures.clear();
+    m_PatchConstantSignatures.shrink_to_fit();
     m_ConstantBuffers.clear();
     m_ConstantBuffers.shrink_to_fit();
+    m_Structures.clear();
+    m_Structures.shrink_to_fit();
+
+    // 同一インスタンスで次のシェーダを変換できるよう残りの定義と辞書も破棄する.
+    m_BuiltInInputDefinitions.clear();
+    m_BuiltInOutputDefinitions.clear();
+    m_InputArgs.clear();
+    m_StructureDefinitions.clear();
+    m_UavDefinitions.clear();
+    m_ConstantBufferDictionary.Clear();
+    m_ConstantBufferBindings.clear();
+    m_StructureDictionary.Clear();
+    m_UavDictionary.Clear();
+    m_UavStructureDictionary.Clear();
+    m_PatchConstantPhase = false;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -258,6 +372,12 @@ void Reflection::AddInputSignature(const Signature& value)
 void Reflection::AddOutputSignature(const Signature& value)
 { m_OutputSignatures.push_back(value); }
 
+//-------------------------------------------------------------------------------------------------
+//      パッチ定数シグニチャを追加します.
+//-------------------------------------------------------------------------------------------------
+void Reflection::AddPatchConstantSignature(const Signature& value)
+{ m_PatchConstantSignatures.push_back(value); }
+
 //-------------------------------------------------------------------------------------------------
 //      定数バッファを追加します.
 //-------------------------------------------------------------------------------------------------
@@ -287,10 +407,7 @@ void Reflection::AddInputArgs(const std::string& value)
 
 void Reflection::AddUavStructPair(const std::string& uav, const std::string& structure)
 {
-    if (m_UavStructureDictionary.find(uav) != m_UavStructureDictionary.end())
-    { return; }
-
-    m_UavStructureDictionary[uav] = structure;
+    m_UavStructureDictionary.Insert(uav, structure);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -300,6 +417,7 @@ void Reflection::Resolve()
 {
     ResolveInput();
     ResolveOutput();
+    ResolvePatchConstant();
     ResolveTexture();
     ResolveSampler();
     ResolveStructure();
@@ -310,29 +428,62 @@ void Reflection::Resolve()
 //-------------------------------------------------------------------------------------------------
 //      名前を問い合わせします.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::QueryName(std::string value, std::string& result)
+bool Reflection::QueryName(const Operand& value, std::string& result)
 {
-    if (FindInputName(value, result))
-    { return true; }
+    // 最も多い一時レジスタは名前を持たないので，何も検索せずに返す.
+    if (value.Type == OPERAND_TYPE_TEMP)
+    { return false; }
 
-    if (FindOutputName(value, result))
-    { return true; }
+    // レジスタの種別で検索先を絞り込む.
+    switch(value.Type)
+    {
+    case OPERAND_TYPE_INPUT:
+    case OPERAND_TYPE_INPUT_SYSTEM:
+        return FindInputName(value, result);
 
-    if (FindTextureName(value, result))
-    { return true; }
+    case OPERAND_TYPE_OUTPUT:
+    case OPERAND_TYPE_OUTPUT_SYSTEM:
+        return m_PatchConstantPhase
+            ? FindPatchConstantName(value, result)
+            : FindOutputName(value, result);
 
-    if (FindSamplerName(value, result))
-    { return true; }
+    case OPERAND_TYPE_TEXTURE:
+        return FindTextureName(value.Text, result);
 
-    if (FindUavName(value, result))
-    { return true; }
+    case OPERAND_TYPE_SAMPLER:
+        // gather4 ではサンプラーのスウィズルが取得する成分を表すので名前には含めない.
+        return FindSamplerName(value.Name, result);
 
-    if (FindConstantBufferName(value, result))
-    { return true; }
+    case OPERAND_TYPE_UAV:
+        return FindUavName(value.Text, result);
 
-    return false;
+    case OPERAND_TYPE_CONSTANT_BUFFER:
+        return FindConstantBufferName(value, result);
+
+    case OPERAND_TYPE_UNKNOWN:
+        break;
+
+    default:
+        // インデックス付き一時レジスタ, リテラル, icb, g#, null は名前を持たない.
+        return false;
+    }
+
+    // 種別が判定できない場合は全てを検索する.
+    return FindInputName(value, result)
+        || FindOutputName(value, result)
+        || FindPatchConstantName(value, result)
+        || FindTextureName(value.Text, result)
+        || FindSamplerName(value.Text, result)
+        || FindUavName(value.Text, result)
+        || FindConstantBufferName(value, result);
 }
 
+//-------------------------------------------------------------------------------------------------
+//      出力レジスタがパッチ定数を指すかどうかを設定します.
+//-------------------------------------------------------------------------------------------------
+void Reflection::SetPatchConstantPhase(bool value)
+{ m_PatchConstantPhase = value; }
+
 //-------------------------------------------------------------------------------------------------
 //      定数バッファの定義を取得します.
 //-------------------------------------------------------------------------------------------------
@@ -357,6 +508,12 @@ const std::vector<std::string>& Reflection::GetDefInputArgs() const
 const std::vector<std::string>& Reflection::GetDefOutputSignature() const
 { return m_OutputDefinitions; }
 
+//-------------------------------------------------------------------------------------------------
+//      パッチ定数シグニチャの定義を取得します.
+//-------------------------------------------------------------------------------------------------
+const std::vector<std::string>& Reflection::GetDefPatchConstantSignature() const
+{ return m_PatchConstantDefinitions; }
+
 //-------------------------------------------------------------------------------------------------
 //      サンプラーの定義を取得します.
 //-------------------------------------------------------------------------------------------------
@@ -421,12 +578,10 @@ void Reflection::ResolveInput()
             input.ArraySize = static_cast<int>(itr.Index.size());
             auto name = StringHelper::Format("v%d", input.Register);
 
-            if (m_InputDictionary.find(name) == m_InputDictionary.end())
-            { m_InputDictionary[name] = input; }
+            m_InputDictionary.Insert(name, input);
 
             name = StringHelper::Format("v[%d]", input.Register);
-            if (m_InputDictionary.find(name) == m_InputDictionary.end())
-            { m_InputDictionary[name] = input; }
+            m_InputDictionary.Insert(name, input);
         }
 
         // 定義コードの生成.
@@ -504,12 +659,10 @@ void Reflection::ResolveOutput()
             auto name = StringHelper::Format("o%d", output.Register);
             output.ArraySize = static_cast<int>(itr.Index.size());
 
-            if (m_OutputDictionary.find(name) == m_OutputDictionary.end())
-            { m_OutputDictionary[name] = output; }
+            m_OutputDictionary.Insert(name, output);
 
             name = StringHelper::Format("o[%d]", output.Register);
-            if (m_OutputDictionary.find(name) == m_OutputDictionary.end())
-            { m_OutputDictionary[name] = output; }
+            m_OutputDictionary.Insert(name, output);
         }
 
         // 定義コードの生成.
@@ -535,6 +688,69 @@ void Reflection::ResolveOutput()
     m_OutputDefinitions.shrink_to_fit();
 }
 
+//-------------------------------------------------------------------------------------------------
+//      パッチ定数シグニチャを解決します.
+//-------------------------------------------------------------------------------------------------
+void Reflection::ResolvePatchConstant()
+{
+    std::vector<ArrayInfo> info = {};
+
+    // SV_TessFactor などは配列データとして書き込めるようにまとめる.
+    for(size_t i=0; i<m_PatchConstantSignatures.size(); ++i)
+    {
+        auto index = Find(m_PatchConstantSignatures[i].Semantics, info);
+        if (index == -1)
+        {
+            ArrayInfo item = {};
+            item.Name  = m_PatchConstantSignatures[i].Semantics;
+            item.Index.push_back(static_cast<int>(i));
+
+            info.push_back(item);
+        }
+        else
+        {
+            info[index].Index.push_back(static_cast<int>(i));
+        }
+    }
+
+    for(auto& itr : info)
+    {
+        // 辞書を作成 (ドメインシェーダでは vpc#, ハルシェーダのフォーク/ジョインフェーズでは o# で参照される).
+        for(size_t i=0; i<itr.Index.size(); ++i)
+        {
+            auto& patch = m_PatchConstantSignatures[itr.Index[i]];
+            patch.ArraySize = static_cast<int>(itr.Index.size());
+
+            for(auto prefix : { "vpc", "o" })
+            {
+                m_PatchConstantDictionary.Insert(StringHelper::Format("%s%d", prefix, patch.Register), patch);
+                m_PatchConstantDictionary.Insert(StringHelper::Format("%s[%d]", prefix, patch.Register), patch);
+            }
+        }
+
+        // 定義コードの生成.
+        {
+            const auto& patch = m_PatchConstantSignatures[itr.Index[0]];
+            auto hlslType = patch.Format + std::to_string(patch.Mask.length());
+
+            auto code = StringHelper::Format("%s %s", hlslType.c_str(), patch.VarName.c_str());
+
+            if (itr.Index.size() > 1)
+            { code += "[" + std::to_string(itr.Index.size()) + "]"; }
+
+            code += " : ";
+            code += patch.Semantics;
+
+            code += ";\n";
+
+            m_PatchConstantDefinitions.push_back(code);
+        }
+    }
+
+    m_PatchConstantSignatures.shrink_to_fit();
+    m_PatchConstantDefinitions.shrink_to_fit();
+}
+
 //-------------------------------------------------------------------------------------------------
 //      テクスチャを解決します.
 //-------------------------------------------------------------------------------------------------
@@ -763,12 +979,16 @@ void Reflection::ResolveConstantBuffer()
         }
     }
 
+    // 辞書への追加で要素が移動するので，レジスタ番号の表は最後に作る.
+    std::vector<std::pair<int, const std::string*>> bindings;
+
     for(size_t b=0; b<m_ConstantBuffers.size(); ++b)
     {
         auto size = 0;
         auto& cb = m_ConstantBuffers[b];
 
-        std::map<std::string, VariableInfo> dic;
+        std::vector<VariableInfo> variables;
+        std::vector<int>          slotTable;
 
         // レジスタ番号を取得.
         int registerIdx = 0;
@@ -819,55 +1039,36 @@ void Reflection::ResolveConstantBuffer()
                 info.ArraySizeVal.push_back(usedCount);
             }
 
-            auto usedSize   = 0;
-            auto usedOffset = offset;
-            for(auto s=0; s<info.ArrayExpandSize; ++s)
+            // オフセットスウィズルを求める (配列の各要素で共通).
+            VarExpandName item = {};
+            item.Name = stripName;
+            if (offset > 0 && info.TypeUsedCount <= 3)
             {
-                // 変数名を展開する.
-                VarExpandName item = {};
-                item.Name           = stripName;
-                item.ArrayElement   = ToArrayElementString(s, info.ArraySizeVal);
-                info.ArrayIndex     = StringHelper::SplitArrayElement(item.ArrayElement);
-                info.ArrayIndexVal  = ToInt(info.ArrayIndex);
-
-                // オフセットスウィズルを求める.
-                if (usedOffset != 0)
-                {
-                    if (info.TypeUsedCount <= 3)
-                    {
-                        item.Swizzle = ".";
-                        for(auto i=0; i<info.TypeUsedCount; ++i)
-                        {
-                            item.Swizzle += swz[i + usedOffset];
-                        }
-                    }
-                }
-
-                //// 配列番号を修正.
-                //auto slotIndex = slot + (usedSize / 16);
-
-                // 配列番号を算出.
-                auto slotIndex = slot + s;
-
-                info.StartRegister = slotIndex;
-                info.RegisteOffset = (s == 0) ? usedOffset : 0;
-                info.ExpandNames   = item;
-
-                //if (usedCount % 2 != 0)
-                //{
-                //    usedSize += (usedCount + 1) * 4;
-                //}
-                //else
-                //{
-                //    usedSize += usedCount * 4;
-                //}
-                //usedOffset = (usedSize % 16) / 4;
+                item.Swizzle = ".";
+                for(auto i=0; i<info.TypeUsedCount && i + offset < 4; ++i)
+                { item.Swizzle += swz[i + offset]; }
+            }
+            info.ExpandNames = item;
+
+            // 配列は要素ごとに展開せず，1スロットに1要素ずつ並ぶものとして範囲で登録しておく.
+            // 要素番号は参照されたときにスロット番号から求める.
+            auto component = item.Swizzle.empty() ? 0 : offset;
+            auto first     = std::max(slot, 0);
+            auto last      = static_cast<int>(std::min<int64_t>(int64_t(slot) + info.ArrayExpandSize, kMaxConstantBufferSlots));
+            if (first < last && offset >= 0)
+            {
+                auto index = static_cast<int>(variables.size());
+                variables.push_back(std::move(info));
 
-                // 検索キーを作成.
-                auto key = StringHelper::Format("%s[%d]", cb.HLSLBind.c_str(), slotIndex) + item.Swizzle;
+                if (slotTable.size() < size_t(last) * 4)
+                { slotTable.resize(size_t(last) * 4, -1); }
 
-                if (dic.find(key) == dic.end())
-                { dic[key] = info; }
+                for(auto s=first; s<last; ++s)
+                {
+                    auto& entry = slotTable[size_t(s) * 4 + component];
+                    if (entry < 0)
+                    { entry = index; }
+                }
             }
 
             //// 行列の場合は，Direct3Dの演算結果と同じになるように行優先にしておく.
@@ -897,16 +1098,22 @@ void Reflection::ResolveConstantBuffer()
         cb.Size = size;
         
         // 検索マップを生成.
-        if (m_ConstantBufferDictionary.find(cb.HLSLBind) == m_ConstantBufferDictionary.end())
+        if (m_ConstantBufferDictionary.Find(cb.HLSLBind) == nullptr)
         {
             ConstantBufferInfo item = {};
             item.Tag            = cb.Name;
             item.Name           = StringHelper::ToLower(cb.Name);
             item.SlotCount      = size / 16;
             item.pBuffer        = &m_ConstantBuffers[b];
-            item.VariableMap    = dic;
+            item.Variables      = std::move(variables);
+            item.SlotTable      = std::move(slotTable);
 
-            m_ConstantBufferDictionary[cb.HLSLBind] = item;
+            m_ConstantBufferDictionary[cb.HLSLBind] = std::move(item);
+
+            // "cb%d" 形式のものはレジスタ番号で直接引けるようにする.
+            if (0 <= registerIdx && registerIdx < kMaxConstantBufferCount
+             && cb.HLSLBind == StringHelper::Format("cb%d", registerIdx))
+            { bindings.push_back(std::make_pair(registerIdx, &cb.HLSLBind)); }
         }
 
         // 定義を閉じる.
@@ -915,6 +1122,14 @@ void Reflection::ResolveConstantBuffer()
         // 定義コードを追加.
         m_ConstantBufferDefinitions.push_back(code);
     }
+
+    for(auto& itr : bindings)
+    {
+        if (m_ConstantBufferBindings.size() <= size_t(itr.first))
+        { m_ConstantBufferBindings.resize(size_t(itr.first) + 1, nullptr); }
+
+        m_ConstantBufferBindings[itr.first] = m_ConstantBufferDictionary.Find(*itr.second);
+    }
 }
 
 void Reflection::ResolveStructure()
@@ -1041,116 +1256,80 @@ void Reflection::ResolveUav()
 //-------------------------------------------------------------------------------------------------
 //      入力定義を問い合わせします.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::QueryInput(const std::string& value, Signature* pInfo)
-{
-    if (m_InputDictionary.find(value) == m_InputDictionary.end())
-    { return false; }
-
-    *pInfo = m_InputDictionary[value];
-    return true;
-}
+const Signature* Reflection::QueryInput(std::string_view value) const
+{ return m_InputDictionary.Find(value); }
 
 //-------------------------------------------------------------------------------------------------
 //      出力定義を問い合わせします.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::QueryOutput(const std::string& value, Signature* pInfo)
-{
-    if (m_OutputDictionary.find(value) == m_OutputDictionary.end())
-    { return false; }
-
-    *pInfo = m_OutputDictionary[value];
-    return true;
-}
+const Signature* Reflection::QueryOutput(std::string_view value) const
+{ return m_OutputDictionary.Find(value); }
 
 //-------------------------------------------------------------------------------------------------
 //      サンプラー定義を問い合わせします.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::QuerySampler(const std::string& value, ResourceInfo* pInfo)
-{
-    if (m_SamplerDictionary.find(value) == m_SamplerDictionary.end())
-    { return false; }
-
-    *pInfo = m_SamplerDictionary[value];
-    return true;
-}
+const Reflection::ResourceInfo* Reflection::QuerySampler(std::string_view value) const
+{ return m_SamplerDictionary.Find(value); }
 
 //-------------------------------------------------------------------------------------------------
 //      テクスチャ定義を問い合わせします.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::QueryTexture(const std::string& value, ResourceInfo* pInfo)
-{
-    if(m_TextureDictionary.find(value) == m_TextureDictionary.end())
-    { return false; }
-
-    *pInfo = m_TextureDictionary[value];
-    return true;
-}
+const Reflection::ResourceInfo* Reflection::QueryTexture(std::string_view value) const
+{ return m_TextureDictionary.Find(value); }
 
 //-------------------------------------------------------------------------------------------------
 //      定数バッファ定義を問い合わせします.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::QueryBuffer(const std::string& value, ConstantBufferInfo* pInfo)
-{
-    if (m_ConstantBufferDictionary.find(value) == m_ConstantBufferDictionary.end())
-    { return false; }
-
-    *pInfo = m_ConstantBufferDictionary[value];
-    return true;
-}
+const Reflection::ConstantBufferInfo* Reflection::QueryBuffer(std::string_view value) const
+{ return m_ConstantBufferDictionary.Find(value); }
 
 //-------------------------------------------------------------------------------------------------
 //      構造体定義を問い合わせします.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::QueryStructure(const std::string& value, Structure* pInfo)
-{
-    if (m_StructureDictionary.find(value) == m_StructureDictionary.end())
-    { return false; }
-
-    *pInfo = m_StructureDictionary[value];
-    return true;
-}
+const Structure* Reflection::QueryStructure(std::string_view value) const
+{ return m_StructureDictionary.Find(value); }
 
 //-------------------------------------------------------------------------------------------------
 //      UAV定義を問い合わせします.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::QueryUav(const std::string& value, ResourceInfo* pInfo)
-{
-    if (m_UavDictionary.find(value) == m_UavDictionary.end())
-    { return false; }
-
-    *pInfo = m_UavDictionary[value];
-    return true;
-}
+const Reflection::ResourceInfo* Reflection::QueryUav(std::string_view value) const
+{ return m_UavDictionary.Find(value); }
 
 //-------------------------------------------------------------------------------------------------
 //      入力データを持つかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Reflection::HasInput() const
-{ return !m_InputDictionary.empty(); }
+{ return !m_InputDictionary.IsEmpty(); }
 
 //-------------------------------------------------------------------------------------------------
 //      出力データを持つかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Reflection::HasOutput() const
-{ return !m_OutputDictionary.empty(); }
+{ return !m_OutputDictionary.IsEmpty(); }
+
+//-------------------------------------------------------------------------------------------------
+//      パッチ定数データを持つかどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool Reflection::HasPatchConstant() const
+{ return !m_PatchConstantDictionary.IsEmpty(); }
 
 //-------------------------------------------------------------------------------------------------
 //      テクスチャデータを持つかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Reflection::HasTexture() const
-{ return !m_TextureDictionary.empty(); }
+{ return !m_TextureDictionary.IsEmpty(); }
 
 //-------------------------------------------------------------------------------------------------
 //      サンプラーデータを持つかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Reflection::HasSampler() const
-{ return !m_SamplerDictionary.empty(); }
+{ return !m_SamplerDictionary.IsEmpty(); }
 
 //-------------------------------------------------------------------------------------------------
 //      バッファデータを持つかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Reflection::HasBuffer() const
-{ return !m_ConstantBufferDictionary.empty(); }
+{ return !m_ConstantBufferDictionary.IsEmpty(); }
 
 //-------------------------------------------------------------------------------------------------
 //      gl_PerVertexの定義を持つかどうかチェックします.
@@ -1167,479 +1346,194 @@ bool Reflection::HasUav() const
 //-------------------------------------------------------------------------------------------------
 //      入力シグニチャを検索します.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::FindInputName(const std::string& value, std::string& result)
+bool Reflection::FindInputName(const Operand& value, std::string& result)
 {
-    std::string sign;
-    std::string temp = value;
-
-    // 符号を取り除いておく.
-    auto pos = temp.find("-");
-    if (pos == 0)
-    {
-        sign = "-";
-        temp = temp.substr(1);
-    }
-
-    // 絶対値符号を取り除く.
-    auto abs1 = temp.find("|");
-    auto abs2 = temp.rfind("|");
-    if (abs1 != std::string::npos
-     && abs2 != std::string::npos 
-     && abs1 != abs2)
-    {
-        temp = temp.substr(abs1 + 1, abs2 - abs1 - 1);
-    }
-
-    auto name = StringHelper::GetWithSwizzle(temp, 0);
+    auto name = value.Name;
 
-    // 演算子があるかどうかチェックする.
-    auto arr = StringHelper::SplitArrayElement(name);
-    if (!arr.empty())
+    auto pDef = m_InputDictionary.Find(name);
+    if (pDef != nullptr)
     {
-        auto hasOp = StringHelper::Contain(arr[0], "+");
-
-        if (hasOp)
-        {
-            auto ops = StringHelper::Split(arr[0], "+");
-        }
-    }
-
-    auto func = [&](const std::string& name) 
-    {
-        if (m_InputDictionary.find(name) != m_InputDictionary.end())
-        {
-            auto& def = m_InputDictionary[name];
-            result = sign + "input." + def.VarName;
-            if (def.ArraySize > 1)
-            {
-                result += "[" + std::to_string(def.Index) + "]";
-            }
-
-            auto swz = StringHelper::GetSwizzle(temp);
-            if (swz.length() - 1 == def.Mask.length())
-            {
-                char buf1[6] = {};
-                char buf2[6] = {};
-                strcpy_s(buf1, swz.c_str());
-                strcpy_s(buf2, def.Mask.c_str());
-
-                auto matchCount = 0;
-                for(auto i=0; i<swz.length() - 1; ++i)
-                {
-                    if (buf1[i + 1] == buf2[i])
-                    { matchCount++; }
-                }
-
-                if (matchCount != def.Mask.length())
-                {
-                    result += swz;
-                }
-            }
-            else
-            {
-                result += swz;
-            }
-
-            return true;
-        }
-
-        bool hit = false;
-
-        if (name == "vGSInstanceId")
-        {
-            result = "gsInstanceId";
-            hit = true;
-        }
-        else if (name == "vOutputControlPointID")
-        {
-            result = "controlPointId";
-            hit = true;
-        }
-        else if (name == "vThreadID")
-        {
-            result = "dispatchId";
-            hit = true;
-        }
-        else if (name == "vThreadGroupID")
-        {
-            result = "groupId";
-            hit = true;
-        }
-        else if (name == "vThreadIDInGroup")
+        auto& def = *pDef;
+        result = value.Negate ? "-input." : "input.";
+        result += def.VarName;
+        if (def.ArraySize > 1)
         {
-            result = "groupThreadId";
-            hit = true;
-        }
-        else if (name == "vThreadIDInGroupFlattened")
-        {
-            result = "groupIndex";
-            hit = true;
+            result += "[" + std::to_string(def.Index) + "]";
         }
 
-        if (hit)
-        {
-            auto swz = StringHelper::GetSwizzle(temp);
-            result += swz;
-            return true;
-        }
+        AppendSwizzle(result, value.Swizzle, def.Mask);
+        return true;
+    }
 
-        return false;
-    };
+    // システム値は番号を持たない.
+    if (value.Type != OPERAND_TYPE_INPUT_SYSTEM && value.Type != OPERAND_TYPE_UNKNOWN)
+    { return false; }
 
-    if (func(name))
-    { return true; }
+    if (name == "vGSInstanceId")
+    { result = "gsInstanceId"; }
+    else if (name == "vOutputControlPointID")
+    { result = "controlPointId"; }
+    else if (name == "vThreadID")
+    { result = "dispatchId"; }
+    else if (name == "vThreadGroupID")
+    { result = "groupId"; }
+    else if (name == "vThreadIDInGroup")
+    { result = "groupThreadId"; }
+    else if (name == "vThreadIDInGroupFlattened")
+    { result = "groupIndex"; }
+    else
+    { return false; }
 
-    return false;
+    result += value.Swizzle;
+    return true;
 }
 
 //-------------------------------------------------------------------------------------------------
 //      出力シグニチャを検索します.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::FindOutputName(const std::string& value, std::string& result)
+bool Reflection::FindOutputName(const Operand& value, std::string& result)
 {
-    std::string sign;
-    std::string temp = value;
+    auto pDef = m_OutputDictionary.Find(value.Name);
+    if (pDef == nullptr)
+    { return false; }
 
-    // 符号を取り除いておく.
-    auto pos = temp.find("-");
-    if (pos == 0)
+    auto& def = *pDef;
+    result = value.Negate ? "-output." : "output.";
+    result += def.VarName;
+    if (def.ArraySize > 1)
     {
-        sign = "-";
-        temp = temp.substr(1);
+        result += "[" + std::to_string(def.Index) + "]";
     }
 
-    // 絶対値符号を取り除く.
-    auto abs1 = temp.find("|");
-    auto abs2 = temp.rfind("|");
-    if (abs1 != std::string::npos
-     && abs2 != std::string::npos 
-     && abs1 != abs2)
-    {
-        temp = temp.substr(abs1 + 1, abs2 - abs1 - 1);
-    }
+    AppendSwizzle(result, value.Swizzle, def.Mask);
+    return true;
+}
 
-    auto name = StringHelper::GetWithSwizzle(temp, 0);
+//-------------------------------------------------------------------------------------------------
+//      パッチ定数シグニチャを検索します.
+//-------------------------------------------------------------------------------------------------
+bool Reflection::FindPatchConstantName(const Operand& value, std::string& result)
+{
+    auto pDef = m_PatchConstantDictionary.Find(value.Name);
+    if (pDef == nullptr)
+    { return false; }
 
-    auto func = [&](const std::string& name)
+    auto& def = *pDef;
+    result = value.Negate ? "-patch." : "patch.";
+    result += def.VarName;
+    if (def.ArraySize > 1)
     {
-        if (m_OutputDictionary.find(name) != m_OutputDictionary.end())
-        {
-            auto& def = m_OutputDictionary[name];
-            result = sign + "output." + def.VarName;
-            if (def.ArraySize > 1)
-            {
-                result += "[" + std::to_string(def.Index) + "]";
-            }
-
-            auto swz = StringHelper::GetSwizzle(temp);
-            if (swz.length() - 1 == def.Mask.length())
-            {
-                char buf1[6] = {};
-                char buf2[6] = {};
-                strcpy_s(buf1, swz.c_str());
-                strcpy_s(buf2, def.Mask.c_str());
-
-                auto matchCount = 0;
-                for(auto i=0; i<swz.length() - 1; ++i)
-                {
-                    if (buf1[i + 1] == buf2[i])
-                    { matchCount++; }
-                }
-
-                if (matchCount != def.Mask.length())
-                {
-                    result += swz;
-                }
-            }
-            else
-            {
-                result += swz;
-            }
-            return true;
-        }
-
-        return false;
-    };
-
-    if (func(name))
-    { return true; }
+        result += "[" + std::to_string(def.Index) + "]";
+    }
 
-    return false;
+    AppendSwizzle(result, value.Swizzle, def.Mask);
+    return true;
 }
 
 //-------------------------------------------------------------------------------------------------
 //      テクスチャを検索します.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::FindTextureName(const std::string& value, std::string& result)
+bool Reflection::FindTextureName(std::string_view value, std::string& result)
 {
-    if (m_TextureDictionary.find(value) != m_TextureDictionary.end())
-    {
-        auto& def = m_TextureDictionary[value];
-        result = def.ExpandName;
-        return true;
-    }
+    auto pDef = m_TextureDictionary.Find(value);
+    if (pDef == nullptr)
+    { return false; }
 
-    return false;
+    result = pDef->ExpandName;
+    return true;
 }
 
 //-------------------------------------------------------------------------------------------------
 //      サンプラーを検索します.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::FindSamplerName(const std::string& value, std::string& result)
+bool Reflection::FindSamplerName(std::string_view value, std::string& result)
 {
-    if (m_SamplerDictionary.find(value) != m_SamplerDictionary.end())
-    {
-        auto& def = m_SamplerDictionary[value];
-        result = def.ExpandName;
-        return true;
-    }
+    auto pDef = m_SamplerDictionary.Find(value);
+    if (pDef == nullptr)
+    { return false; }
 
-    return false;
+    result = pDef->ExpandName;
+    return true;
 }
 
 //-------------------------------------------------------------------------------------------------
 //      UAVを検索します.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::FindUavName(const std::string& value, std::string& result)
+bool Reflection::FindUavName(std::string_view value, std::string& result)
 {
-    if (m_UavDictionary.find(value) != m_UavDictionary.end())
-    {
-        auto& def = m_UavDictionary[value];
-        result = def.ExpandName;
-        return true;
-    }
+    auto pDef = m_UavDictionary.Find(value);
+    if (pDef == nullptr)
+    { return false; }
 
-    return false;
+    result = pDef->ExpandName;
+    return true;
 }
 
 //-------------------------------------------------------------------------------------------------
 //      UAV名に対応する構造体名を取得します.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::FindUavStructureName(const std::string& value, std::string& result)
+bool Reflection::FindUavStructureName(std::string_view value, std::string& result)
 {
-    if (m_UavStructureDictionary.find(value) != m_UavStructureDictionary.end())
-    {
-        result = m_UavStructureDictionary[value];
-        return true;
-    }
+    auto pName = m_UavStructureDictionary.Find(value);
+    if (pName == nullptr)
+    { return false; }
 
-    return false;
+    result = *pName;
+    return true;
 }
 
 //-------------------------------------------------------------------------------------------------
 //      定数バッファを検索します.
 //-------------------------------------------------------------------------------------------------
-bool Reflection::FindConstantBufferName(const std::string& value, std::string& result)
+bool Reflection::FindConstantBufferName(const Operand& value, std::string& result)
 {
-    std::string temp = value;
-
-    // 符号を取り除く.
-    std::string sign;
-    auto pos3 = temp.find("-");
-    if (pos3 == 0)
-    {
-        sign = "-";
-        temp = temp.substr(pos3 + 1);
-    }
-
-    // 絶対値記号を取り除く.
-    auto abs1 = temp.find("|");
-    auto abs2 = temp.rfind("|");
-    if (abs1 != std::string::npos && abs2 != std::string::npos && abs1 != abs2)
-    {
-        temp = temp.substr(abs1 + 1, abs2 - abs1 - 1);
-    }
-
     // 基本定数バッファはcb0[1]みたいな感じなので，必ず配列形式.
-    auto pos1 = temp.find("[");
-    auto pos2 = temp.find("]");
-    if (pos2 == std::string::npos || pos1 == std::string::npos)
+    if (value.Element.empty() || value.RegisterNumber < 0)
     { return false; }
 
-    auto name = temp.substr(0, pos1);   
-    if (m_ConstantBufferDictionary.find(name) != m_ConstantBufferDictionary.end())
-    {
-        auto& cb = m_ConstantBufferDictionary[name];
-
-        // スウィズル付きがあるかどうかチェック.
-        if (cb.VariableMap.find(temp) != cb.VariableMap.end())
-        {
-            auto& var = cb.VariableMap[temp];
-            //result = sign + cb.Name + ".";
-            result = sign;
-            result += var.ExpandNames.Name;
-            result += var.ExpandNames.ArrayElement;
-
-            if (var.ExpandNames.Swizzle.empty())
-            {
-                auto count = StringHelper::GetSwizzleCount(temp);
-
-                // スウィズルの妥当性をチェック.
-                if (count > 0)
-                {
-                    // スウィズル取得.
-                    auto swizzle = StringHelper::GetSwizzle(temp);
-
-                    char buf[6];
-                    strcpy_s(buf, swizzle.c_str());
-
-                    bool err = false;
-
-                    // 1スロット当たりの要素数を求める.
-                    auto elementCount = var.TypeUsedCount % 4;
-                    elementCount = (elementCount == 0) ? 4 : elementCount;
+    auto number = size_t(value.RegisterNumber);
+    if (number >= m_ConstantBufferBindings.size() || m_ConstantBufferBindings[number] == nullptr)
+    { return false; }
 
-                    // 各スウィズルをチェック.
-                    for(auto i=1; i<count; ++i)
-                    {
-                        auto dif = 0;
-
-                        // 距離差分を求める.
-                        if (buf[i] == 'x')
-                        { dif = 0; }
-                        else if (buf[i] == 'y')
-                        { dif = 1; }
-                        else if (buf[i] == 'z')
-                        { dif = 2; }
-                        else if (buf[i] == 'w')
-                        { dif = 3; }
-
-                        // 要素数を超えるものがあれば補正が必要.
-                        if (dif >= elementCount)
-                        {
-                            err = true;
-                            break;
-                        }
-                    }
+    auto& cb = *m_ConstantBufferBindings[number];
+    if (value.Register != cb.pBuffer->HLSLBind)
+    { return false; }
 
-                    if (err)
-                    {
-                        // スウィズル補正が必要な場合.
-                        std::string swz[4] = {"x", "y", "z", "w"};
-                        result += ".";
-
-                        // 1文字ずつ直す.
-                        for(auto i=0; i<count; ++i)
-                        {
-                            auto dif = 0;
-                            if (buf[i] == 'x')
-                            { dif = 0; }
-                            else if (buf[i] == 'y')
-                            { dif = 1; }
-                            else if (buf[i] == 'z')
-                            { dif = 2; }
-                            else if (buf[i] == 'w')
-                            { dif = 3; }
-
-                            // 要素数を超えないようにインデックスをループさせる.
-                            auto idx = dif % elementCount;
-
-                            // スウィズル追加.
-                            result += swz[idx];
-                        }
-                    }
-                    else
-                    {
-                        // スウィズル補正が必要ない場合はそのままくっつける.
-                        result += swizzle;
-                    }
-                }
-            }
+    // 相対アドレスの場合は変数を特定できない.
+    int slot = 0;
+    if (!ToSlotIndex(value.Index[0], slot) || size_t(slot) * 4 >= cb.SlotTable.size())
+    { return false; }
 
-            return true;
-        }
+    auto pEntry = &cb.SlotTable[size_t(slot) * 4];
 
-        auto varName = temp.substr(0, pos2 + 1);
-        if (cb.VariableMap.find(varName) != cb.VariableMap.end())
+    // スロットの途中から始まる変数はスウィズルまで一致するものを優先する.
+    const VariableInfo* pVar = nullptr;
+    if (value.Name.size() == value.Element.size() && !value.Swizzle.empty())
+    {
+        auto component = ToSwizzleIndex(value.Swizzle[1]);
+        if (component > 0 && pEntry[component] >= 0)
         {
-            auto& var = cb.VariableMap[varName];
-            //result = sign + cb.Name + ".";
-            result = sign;
-            result += var.ExpandNames.Name;
-            result += var.ExpandNames.ArrayElement;
-
-            if (var.ExpandNames.Swizzle.empty())
-            {
-                auto count = StringHelper::GetSwizzleCount(temp);
-
-                // スウィズルの妥当性をチェック.
-                if (count > 0)
-                {
-                    // スウィズル取得.
-                    auto swizzle = StringHelper::GetSwizzle(temp);
-
-                    char buf[6];
-                    strcpy_s(buf, swizzle.c_str());
-
-                    bool err = false;
+            auto& var = cb.Variables[pEntry[component]];
+            if (var.ExpandNames.Swizzle == value.Swizzle)
+            { pVar = &var; }
+        }
+    }
 
-                    // 1スロット当たりの要素数を求める.
-                    auto elementCount = var.TypeUsedCount % 4;
-                    elementCount = (elementCount == 0) ? 4 : elementCount;
+    if (pVar == nullptr && pEntry[0] >= 0)
+    { pVar = &cb.Variables[pEntry[0]]; }
 
-                    // 各スウィズルをチェック.
-                    for(auto i=1; i<count; ++i)
-                    {
-                        auto dif = 0;
-
-                        // 距離差分を求める.
-                        if (buf[i] == 'x')
-                        { dif = 0; }
-                        else if (buf[i] == 'y')
-                        { dif = 1; }
-                        else if (buf[i] == 'z')
-                        { dif = 2; }
-                        else if (buf[i] == 'w')
-                        { dif = 3; }
-
-                        // 要素数を超えるものがあれば補正が必要.
-                        if (dif >= elementCount)
-                        {
-                            err = true;
-                            break;
-                        }
-                    }
+    if (pVar == nullptr)
+    { return false; }
 
-                    if (err)
-                    {
-                        // スウィズル補正が必要な場合.
-                        std::string swz[4] = {"x", "y", "z", "w"};
-                        result += ".";
-
-                        // 1文字ずつ直す.
-                        for(auto i=0; i<count; ++i)
-                        {
-                            auto dif = 0;
-                            if (buf[i] == 'x')
-                            { dif = 0; }
-                            else if (buf[i] == 'y')
-                            { dif = 1; }
-                            else if (buf[i] == 'z')
-                            { dif = 2; }
-                            else if (buf[i] == 'w')
-                            { dif = 3; }
-
-                            // 要素数を超えないようにインデックスをループさせる.
-                            auto idx = dif % elementCount;
-                            assert(0 <= idx && idx <= 3);
-
-                            // スウィズル追加.
-                            result += swz[idx];
-                        }
-                    }
-                    else
-                    {
-                        // スウィズル補正が必要ない場合はそのままくっつける.
-                        result += swizzle;
-                    }
-                }
-            }
+    // 配列の要素番号は先頭からのスロット数で決まる.
+    result = value.Negate ? "-" : "";
+    result += pVar->ExpandNames.Name;
+    result += ToArrayElementString(slot - pVar->StartRegister, pVar->ArraySizeVal);
 
-            return true;
-        }
-    }
+    if (pVar->ExpandNames.Swizzle.empty())
+    { AppendBufferSwizzle(result, value.Swizzle, pVar->TypeUsedCount); }
 
-    return false;
+    return true;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1675,73 +1569,7 @@ std::string Reflection::GetCastedString(std::string value, const SwizzleInfo& in
     if (pos == std::string::npos)
     { return value; }
 
-    std::string sign;
-    std::string temp = value;
-    pos = temp.find("-");
-
-    // 符号があれば取り除いておく.
-    if (pos == 0)
-    {
-        sign = "-";
-        temp = temp.substr(pos + 1);
-    }
-
-    bool hasAbs = false;
-    // 絶対値符号を取り除く.
-    auto abs1 = temp.find("|");
-    auto abs2 = temp.rfind("|");
-    if (abs1 != std::string::npos
-     && abs2 != std::string::npos 
-     && abs1 != abs2)
-    {
-        temp = temp.substr(abs1 + 1, abs2 - abs1 - 1);
-        hasAbs = true;
-    }
-
-    abs1 = temp.find("abs(");
-    abs2 = temp.rfind(")");
-    if (abs1 != std::string::npos
-     && abs2 != std::string::npos 
-     && abs1 != abs2)
-    {
-        temp = temp.substr(abs1 + 4, abs2 - abs1 - 4);
-        hasAbs = true;
-    }
-
-    auto cbName  = temp.substr(0, pos);
-    auto varName = temp.substr(pos + 1);
-
-    // 配列は取り除いて，名前だけにしておく.
-    pos = varName.find("[");
-    if (pos != std::string::npos)
-    { varName = varName.substr(0, pos); }
-
-    for(auto& cb : m_ConstantBuffers)
-    {
-        if (cb.Name != cbName )
-        { continue; }
-
-        for(auto& var : cb.Variables)
-        {
-            if (var.Name != varName)
-            { continue; }
-
-            auto elements = ToElementCount(var.Type);
-
-            // 一致していれば，何もせずに返す.
-            if (elements == info.Count)
-            { return value; }
-            else if (elements == 1) // 要素１のやつはスウィズル出来ないので，キャストする.
-            {
-                auto hlslType = var.Type + std::to_string(info.Count);
-                auto ret = sign + hlslType + "(" + value + ")";
-                if (hasAbs)
-                { ret = "abs(" + ret + ")"; }
-                return ret;
-            }
-        }
-    }
-
+    // 定数バッファの変数は "変数名.スウィズル" の形で渡されるので，スウィズル数だけ合わせればよい.
     return FilterSwizzle(value, info);
 }
 
@@ -1909,4 +1737,22 @@ SwizzleInfo Reflection::ToSwizzleInfo(std::string value)
     return ret;
 }
 
+//-------------------------------------------------------------------------------------------------
+//      字句解析済みのオペランドをスウィズル情報に変換します.
+//-------------------------------------------------------------------------------------------------
+SwizzleInfo Reflection::ToSwizzleInfo(const Operand& value)
+{
+    SwizzleInfo ret = {};
+    ret.Count = value.Swizzle.empty() ? 0 : static_cast<int>(value.Swizzle.size() - 1);
+    memset(ret.Index, -1, sizeof(ret.Index));
+
+    for(auto i=0; i<ret.Count; ++i)
+    {
+        ret.Pattern[i] = value.Swizzle[i + 1];
+        ret.Index[i]   = ToSwizzleIndex(ret.Pattern[i]);
+    }
+
+    return ret;
+}
+
 } // namespace a3d
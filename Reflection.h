@@ -9,8 +9,10 @@
 // Includes
 //-------------------------------------------------------------------------------------------------
 #include <string>
+#include <string_view>
 #include <vector>
-#include <map>
+#include "Operand.h"
+#include "FlatMap.h"
 
 
 namespace a3d {
@@ -136,7 +138,6 @@ public:
     struct VarExpandName
     {
         std::string                 Name;
-        std::string                 ArrayElement;
         std::string                 Swizzle;
     };
 
@@ -149,8 +150,6 @@ public:
         int                         RegisteOffset;
         int                         TypeUsedCount;
         int                         ArrayExpandSize;
-        std::vector<std::string>    ArrayIndex;
-        std::vector<int>            ArrayIndexVal;
         VarExpandName               ExpandNames;
         ConstantBuffer*             pBuffer;
     };
@@ -161,7 +160,8 @@ public:
         std::string         Name;
         int                 SlotCount;
         ConstantBuffer*     pBuffer;
-        std::map<std::string, VariableInfo> VariableMap;
+        std::vector<VariableInfo>   Variables;  // 宣言された変数 (配列は展開しない).
+        std::vector<int>            SlotTable;  // [スロット * 4 + 成分] の Variables の番号 (-1 は無し).
     };
 
     //=============================================================================================
@@ -175,33 +175,40 @@ public:
     void AddResource        (const Resource& value);
     void AddInputSignature  (const Signature& value);
     void AddOutputSignature (const Signature& value);
+    void AddPatchConstantSignature(const Signature& value);
     void AddConstantBuffer  (const ConstantBuffer& value);
     void AddStructure       (const Structure& value);
     void AddInputArgs       (const std::string& value);
     void AddUavStructPair   (const std::string& uav, const std::string& structure);
 
     void Resolve();
-    bool QueryName(std::string value, std::string& result);
+    bool QueryName(const Operand& value, std::string& result);
+
+    // ハルシェーダのフォーク/ジョインフェーズでは出力レジスタ (o#) がパッチ定数を指す.
+    void SetPatchConstantPhase(bool value);
 
     const std::vector<std::string>& GetDefConstantBuffer    () const;
     const std::vector<std::string>& GetDefInputSignature    () const;
     const std::vector<std::string>& GetDefInputArgs         () const;
     const std::vector<std::string>& GetDefOutputSignature   () const;
+    const std::vector<std::string>& GetDefPatchConstantSignature() const;
     const std::vector<std::string>& GetDefSamplers          () const;
     const std::vector<std::string>& GetDefTextures          () const;
     const std::vector<std::string>& GetDefBuiltInOutput     () const;
     const std::vector<std::string>& GetDefStructures        () const;
     const std::vector<std::string>& GetDefUavs              () const;
 
-    bool QuerySampler   (const std::string& value, ResourceInfo* pInfo);
-    bool QueryTexture   (const std::string& value, ResourceInfo* pInfo);
-    bool QueryUav       (const std::string& value, ResourceInfo* pInfo);
-    bool QueryInput     (const std::string& value, Signature* pInfo);
-    bool QueryOutput    (const std::string& value, Signature* pInfo);
-    bool QueryBuffer    (const std::string& value, ConstantBufferInfo* pInfo);
-    bool QueryStructure (const std::string& value, Structure* pInfo);
+    // 見つからない場合は nullptr を返却します. ポインタは Resolve() や Clear() を呼ぶまで有効です.
+    const ResourceInfo*         QuerySampler   (std::string_view value) const;
+    const ResourceInfo*         QueryTexture   (std::string_view value) const;
+    const ResourceInfo*         QueryUav       (std::string_view value) const;
+    const Signature*            QueryInput     (std::string_view value) const;
+    const Signature*            QueryOutput    (std::string_view value) const;
+    const ConstantBufferInfo*   QueryBuffer    (std::string_view value) const;
+    const Structure*            QueryStructure (std::string_view value) const;
     bool HasInput       () const;
     bool HasOutput      () const;
+    bool HasPatchConstant() const;
     bool HasTexture     () const;
     bool HasSampler     () const;
     bool HasBuffer      () const;
@@ -214,6 +221,7 @@ public:
     //static std::string ToGLSLType(std::string type);
     static int         ToElementCount(std::string type);
     static SwizzleInfo ToSwizzleInfo(std::string value);
+    static SwizzleInfo ToSwizzleInfo(const Operand& value);
 
     bool IsLiteral(std::string type, Literal* pInfo);
 
@@ -224,6 +232,7 @@ private:
     std::vector<Resource>       m_Resources;
     std::vector<Signature>      m_InputSignatures;
     std::vector<Signature>      m_OutputSignatures;
+    std::vector<Signature>      m_PatchConstantSignatures;
     std::vector<ConstantBuffer> m_ConstantBuffers;
     std::vector<Structure>      m_Structures;
 
@@ -232,39 +241,45 @@ private:
     std::vector<std::string>    m_InputDefinitions;
     std::vector<std::string>    m_InputArgs;
     std::vector<std::string>    m_OutputDefinitions;
+    std::vector<std::string>    m_PatchConstantDefinitions;
     std::vector<std::string>    m_ConstantBufferDefinitions;
     std::vector<std::string>    m_TextureDefinitions;
     std::vector<std::string>    m_SamplerDefinitions;
     std::vector<std::string>    m_StructureDefinitions;
     std::vector<std::string>    m_UavDefinitions;
 
-    std::map<std::string, Signature>            m_InputDictionary;
-    std::map<std::string, Signature>            m_OutputDictionary;
-    std::map<std::string, ResourceInfo>         m_TextureDictionary;
-    std::map<std::string, ResourceInfo>         m_SamplerDictionary;
-    std::map<std::string, ConstantBufferInfo>   m_ConstantBufferDictionary;
-    std::map<std::string, Structure>            m_StructureDictionary;
-    std::map<std::string, ResourceInfo>         m_UavDictionary;
-    std::map<std::string, std::string>          m_UavStructureDictionary;   // UAV名 <---> 構造体名.
+    FlatMap<Signature>                          m_InputDictionary;
+    FlatMap<Signature>                          m_OutputDictionary;
+    FlatMap<Signature>                          m_PatchConstantDictionary;
+    FlatMap<ResourceInfo>                       m_TextureDictionary;
+    FlatMap<ResourceInfo>                       m_SamplerDictionary;
+    FlatMap<ConstantBufferInfo>                 m_ConstantBufferDictionary;
+    std::vector<const ConstantBufferInfo*>      m_ConstantBufferBindings;   // レジスタ番号 (cb#) で引く定数バッファ.
+    FlatMap<Structure>                          m_StructureDictionary;
+    FlatMap<ResourceInfo>                       m_UavDictionary;
+    FlatMap<std::string>                        m_UavStructureDictionary;   // UAV名 <---> 構造体名.
+    bool                                        m_PatchConstantPhase = false;
 
     //=============================================================================================
     // private methods.
     //=============================================================================================
     void ResolveInput           ();
     void ResolveOutput          ();
+    void ResolvePatchConstant   ();
     void ResolveTexture         ();
     void ResolveSampler         ();
     void ResolveStructure       ();
     void ResolveUav             ();
     void ResolveConstantBuffer  ();
 
-    bool FindInputName          (const std::string& value, std::string& result);
-    bool FindOutputName         (const std::string& value, std::string& result);
-    bool FindTextureName        (const std::string& value, std::string& result);
-    bool FindSamplerName        (const std::string& value, std::string& result);
-    bool FindUavName            (const std::string& value, std::string& result);
-    bool FindConstantBufferName (const std::string& value, std::string& result);
-    bool FindUavStructureName   (const std::string& value, std::string& result);
+    bool FindInputName          (const Operand& value, std::string& result);
+    bool FindOutputName         (const Operand& value, std::string& result);
+    bool FindPatchConstantName  (const Operand& value, std::string& result);
+    bool FindTextureName        (std::string_view value, std::string& result);
+    bool FindSamplerName        (std::string_view value, std::string& result);
+    bool FindUavName            (std::string_view value, std::string& result);
+    bool FindConstantBufferName (const Operand& value, std::string& result);
+    bool FindUavStructureName   (std::string_view value, std::string& result);
 
     std::string FilterLiteral   (std::string value, const SwizzleInfo& info);
     std::string FilterPrimitive (std::string value, const SwizzleInfo& info);
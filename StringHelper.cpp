@@ -584,7 +584,7 @@ std::string StringHelper::GetWithSwizzle(std::string value, int count)
 
         auto result = name + swizzle;
         if (hasAbs)
-        { result = "abs(" + result + ")"; }
+        { result = value.substr(0, abs1) + "abs(" + result + ")"; }
         return result;
     }
 
@@ -775,7 +775,7 @@ std::string StringHelper::GetWithSwizzleEx(std::string value, int count, const i
 
         auto result = name + swizzle;
         if (hasAbs)
-        { result = "abs(" + result + ")"; }
+        { result = value.substr(0, abs1) + "abs(" + result + ")"; }
         return result;
     }
 
@@ -0,0 +1,254 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : TextScanner.cpp
+// Desc : SIMD Text Scanning Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "TextScanner.h"
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#define SCANNER_ENABLE_SIMD     (1)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+namespace {
+
+using SIMD_LEVEL = TextScanner::SIMD_LEVEL;
+
+//-------------------------------------------------------------------------------------------------
+// Global Variables.
+//-------------------------------------------------------------------------------------------------
+std::atomic<int>    g_MaxLevel(TextScanner::SIMD_LEVEL_AVX2);   // 使用する命令セットの上限 (テストで各経路を通すために下げる).
+
+//-------------------------------------------------------------------------------------------------
+//      実行中のCPUで使える命令セットを判定します.
+//-------------------------------------------------------------------------------------------------
+SIMD_LEVEL DetectSimdLevel()
+{
+#if SCANNER_ENABLE_SIMD
+    int info[4] = {};
+    __cpuid(info, 0);
+    auto maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    auto sse2    = (info[3] & (1 << 26)) != 0;
+    auto osxsave = (info[2] & (1 << 27)) != 0;
+    auto avx     = (info[2] & (1 << 28)) != 0;
+
+    // AVX2 は OS が YMM レジスタを退避する場合のみ使える.
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5))
+        { return TextScanner::SIMD_LEVEL_AVX2; }
+    }
+
+    if (sse2)
+    { return TextScanner::SIMD_LEVEL_SSE2; }
+#endif
+
+    return TextScanner::SIMD_LEVEL_SCALAR;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      判定結果をキャッシュして返却します.
+//-------------------------------------------------------------------------------------------------
+SIMD_LEVEL GetCpuLevel()
+{
+    static const SIMD_LEVEL s_Level = DetectSimdLevel();
+    return s_Level;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      上限を考慮して使用する命令セットを取得します.
+//-------------------------------------------------------------------------------------------------
+int GetSimdLevel()
+{ return std::min<int>(GetCpuLevel(), g_MaxLevel.load(std::memory_order_relaxed)); }
+
+#if SCANNER_ENABLE_SIMD
+
+//-------------------------------------------------------------------------------------------------
+//      16バイト中で集合に含まれる文字のビットマスクを求めます.
+//-------------------------------------------------------------------------------------------------
+inline uint32_t MatchSSE2(const char* p, const TextScanner::CharSet& set)
+{
+    auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    auto match = _mm_setzero_si128();
+    for(size_t i=0; i<set.Count; ++i)
+    {
+        auto c = _mm_load_si128(reinterpret_cast<const __m128i*>(set.Broadcast[i]));
+        match = _mm_or_si128(match, _mm_cmpeq_epi8(value, c));
+    }
+
+    return uint32_t(_mm_movemask_epi8(match));
+}
+
+//-------------------------------------------------------------------------------------------------
+//      32バイト中で集合に含まれる文字のビットマスクを求めます.
+//-------------------------------------------------------------------------------------------------
+inline uint32_t MatchAVX2(const char* p, const TextScanner::CharSet& set)
+{
+    auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    auto match = _mm256_setzero_si256();
+    for(size_t i=0; i<set.Count; ++i)
+    {
+        auto c = _mm256_load_si256(reinterpret_cast<const __m256i*>(set.Broadcast[i]));
+        match = _mm256_or_si256(match, _mm256_cmpeq_epi8(value, c));
+    }
+
+    return uint32_t(_mm256_movemask_epi8(match));
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ビットマスク中で最初に立っているビットの位置を求めます.
+//-------------------------------------------------------------------------------------------------
+inline size_t FirstBit(uint32_t mask)
+{
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return size_t(index);
+}
+
+#endif//SCANNER_ENABLE_SIMD
+
+//-------------------------------------------------------------------------------------------------
+//      集合への所属が expected と異なる最初の文字を検索します.
+//-------------------------------------------------------------------------------------------------
+const char* Scan(const char* pHead, const char* pEnd, const TextScanner::CharSet& set, bool expected)
+{
+    auto p = pHead;
+
+#if SCANNER_ENABLE_SIMD
+    // 文字数が多すぎる集合は比較回数が増えるだけなのでテーブル引きに任せる.
+    if (set.Count > 0)
+    {
+        auto level = GetSimdLevel();
+
+        // 読み飛ばす場合は一致しなかった文字, 検索する場合は一致した文字を探す.
+        const uint32_t invert32 = expected ? 0xffffffffu : 0u;
+        const uint32_t invert16 = expected ? 0xffffu : 0u;
+
+        if (level >= TextScanner::SIMD_LEVEL_AVX2)
+        {
+            while (pEnd - p >= 32)
+            {
+                auto mask = MatchAVX2(p, set) ^ invert32;
+                if (mask != 0)
+                { return p + FirstBit(mask); }
+                p += 32;
+            }
+        }
+
+        if (level >= TextScanner::SIMD_LEVEL_SSE2)
+        {
+            while (pEnd - p >= 16)
+            {
+                auto mask = MatchSSE2(p, set) ^ invert16;
+                if (mask != 0)
+                { return p + FirstBit(mask); }
+                p += 16;
+            }
+        }
+    }
+#endif
+
+    // 残りはスカラーで処理する.
+    while (p < pEnd && set.Table[uint8_t(*p)] == expected)
+    { p++; }
+
+    return p;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      改行文字の集合を作成します.
+//-------------------------------------------------------------------------------------------------
+TextScanner::CharSet MakeLineEndSet()
+{
+    TextScanner::CharSet result;
+    result.Set("\n", false);
+    return result;
+}
+
+} // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TextScanner::CharSet structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      文字集合を設定します.
+//-------------------------------------------------------------------------------------------------
+void TextScanner::CharSet::Set(const char* chars, bool includeNull)
+{
+    memset(Table, 0, sizeof(Table));
+    Count = 0;
+
+    for(auto p = chars; *p != '\0'; ++p)
+    { Table[uint8_t(*p)] = true; }
+
+    if (includeNull)
+    { Table[0] = true; }
+
+    // 重複を除いた文字を SIMD 比較用に並べる.
+    for(auto i=0; i<256; ++i)
+    {
+        if (!Table[i])
+        { continue; }
+
+        if (Count >= MaxChars)
+        {
+            Count = 0;
+            break;
+        }
+
+        memset(Broadcast[Count], i, sizeof(Broadcast[Count]));
+        Count++;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TextScanner class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+//      集合に含まれる文字を読み飛ばします.
+//-------------------------------------------------------------------------------------------------
+const char* TextScanner::SkipAny(const char* pHead, const char* pEnd, const CharSet& set)
+{ return Scan(pHead, pEnd, set, true); }
+
+//-------------------------------------------------------------------------------------------------
+//      集合に含まれる文字を検索します.
+//-------------------------------------------------------------------------------------------------
+const char* TextScanner::FindAny(const char* pHead, const char* pEnd, const CharSet& set)
+{ return Scan(pHead, pEnd, set, false); }
+
+//-------------------------------------------------------------------------------------------------
+//      行末を検索します.
+//-------------------------------------------------------------------------------------------------
+const char* TextScanner::FindLineEnd(const char* pHead, const char* pEnd)
+{
+    static const CharSet s_LineEnd = MakeLineEndSet();
+    return Scan(pHead, pEnd, s_LineEnd, false);
+}
+
+//-------------------------------------------------------------------------------------------------
+//      実行中のCPUで使える命令セットを取得します.
+//-------------------------------------------------------------------------------------------------
+TextScanner::SIMD_LEVEL TextScanner::GetSupportedLevel()
+{ return GetCpuLevel(); }
+
+//-------------------------------------------------------------------------------------------------
+//      使用する命令セットの上限を設定します.
+//-------------------------------------------------------------------------------------------------
+void TextScanner::SetMaxLevel(SIMD_LEVEL level)
+{ g_MaxLevel.store(level, std::memory_order_relaxed); }
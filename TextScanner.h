@@ -0,0 +1,113 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : TextScanner.h
+// Desc : SIMD Text Scanning Module.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TextScanner class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class TextScanner
+{
+    //=============================================================================================
+    // list of friend classes and methods.
+    //=============================================================================================
+    /* NOTHING */
+
+public:
+    //=============================================================================================
+    // public variables.
+    //=============================================================================================
+    static constexpr size_t MaxChars = 16;      //!< 文字集合に登録できる最大文字数.
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // SIMD_LEVEL enum
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    enum SIMD_LEVEL
+    {
+        SIMD_LEVEL_SCALAR   = 0,    //!< SIMD 無し.
+        SIMD_LEVEL_SSE2     = 1,    //!< 16バイト単位.
+        SIMD_LEVEL_AVX2     = 2,    //!< 32バイト単位.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // CharSet structure
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct CharSet
+    {
+        alignas(32) uint8_t Broadcast[MaxChars][32];   //!< 各文字を32バイトに並べたもの (SIMD比較用).
+        size_t              Count;                      //!< 登録文字数.
+        bool                Table[256];                 //!< 文字毎の所属判定 (スカラー処理用).
+
+        //-----------------------------------------------------------------------------------------
+        //! @brief      文字集合を設定します.
+        //!
+        //! @param[in]      chars           集合に含める文字.
+        //! @param[in]      includeNull     終端文字も集合に含めるかどうか.
+        //! @note       MaxChars を超える場合はスカラー処理のみで判定します.
+        //-----------------------------------------------------------------------------------------
+        void Set(const char* chars, bool includeNull);
+    };
+
+    //=============================================================================================
+    // public methods.
+    //=============================================================================================
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      集合に含まれる文字を読み飛ばします.
+    //!
+    //! @param[in]      pHead           走査開始位置.
+    //! @param[in]      pEnd            走査終了位置.
+    //! @return     集合に含まれない最初の文字の位置を返却します. 見つからない場合は pEnd.
+    //---------------------------------------------------------------------------------------------
+    static const char* SkipAny(const char* pHead, const char* pEnd, const CharSet& set);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      集合に含まれる文字を検索します.
+    //!
+    //! @param[in]      pHead           走査開始位置.
+    //! @param[in]      pEnd            走査終了位置.
+    //! @return     集合に含まれる最初の文字の位置を返却します. 見つからない場合は pEnd.
+    //---------------------------------------------------------------------------------------------
+    static const char* FindAny(const char* pHead, const char* pEnd, const CharSet& set);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      行末 ('\n') を検索します.
+    //!
+    //! @param[in]      pHead           走査開始位置.
+    //! @param[in]      pEnd            走査終了位置.
+    //! @return     最初の改行文字の位置を返却します. 見つからない場合は pEnd.
+    //---------------------------------------------------------------------------------------------
+    static const char* FindLineEnd(const char* pHead, const char* pEnd);
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      実行中のCPUで使える命令セットを取得します.
+    //---------------------------------------------------------------------------------------------
+    static SIMD_LEVEL GetSupportedLevel();
+
+    //---------------------------------------------------------------------------------------------
+    //! @brief      使用する命令セットの上限を設定します. 各経路の結果を比較するテスト用です.
+    //!
+    //! @param[in]      level           上限. CPU が対応していない命令セットは指定しても使いません.
+    //---------------------------------------------------------------------------------------------
+    static void SetMaxLevel(SIMD_LEVEL level);
+
+private:
+    //=============================================================================================
+    // private variables.
+    //=============================================================================================
+    /* NOTHING */
+
+    //=============================================================================================
+    // private methods.
+    //=============================================================================================
+    /* NOTHING */
+};
@@ -9,34 +9,66 @@
 //-------------------------------------------------------------------------------------------------
 #include "Tokenizer.h"
 #include <new>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
 
 
 namespace {
 
 //-------------------------------------------------------------------------------------------------
-//      小文字にして部分文字列比較を行います.
+// Constant Values.
 //-------------------------------------------------------------------------------------------------
-static const char *stristr (const char *haystack, const char *needle)
+const uint8_t kCharSeparator    = 0x1;      // 区切り文字.
+const uint8_t kCharCutOff       = 0x2;      // 切り出し文字.
+const uint8_t kCharTerminator   = 0x4;      // 終端文字.
+
+//-------------------------------------------------------------------------------------------------
+//      行頭の空白文字の集合を作成します.
+//-------------------------------------------------------------------------------------------------
+TextScanner::CharSet MakeBlankSet()
 {
-    int haypos;
-    int needlepos;
+    TextScanner::CharSet result;
+    result.Set(" \t", false);
+    return result;
+}
+
+const TextScanner::CharSet kBlankSet = MakeBlankSet();
 
-    haypos = 0;
-    while (haystack[haypos]) 
+//-------------------------------------------------------------------------------------------------
+//      大文字小文字を区別せずに文字を比較します.
+//-------------------------------------------------------------------------------------------------
+bool EqualAsLower(const char* lhs, const char* rhs, size_t count)
+{
+    for(size_t i=0; i<count; ++i)
     {
-        if (tolower (haystack[haypos]) == tolower(needle[0])) 
-        {
-            needlepos = 1;
-            while ( (needle[needlepos]) &&
-                    (tolower(haystack[haypos + needlepos])
-                    == tolower(needle[needlepos])) )
-                ++needlepos;
-            if (!needle[needlepos])
-                return (haystack + haypos);
-        }
-        ++haypos;
+        if (tolower(uint8_t(lhs[i])) != tolower(uint8_t(rhs[i])))
+        { return false; }
     }
-    return NULL;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      コピーせずに数値として解釈します (atoi/atof と同じく解釈できない場合は 0).
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+T ParseNumber(std::string_view token)
+{
+    auto pHead = token.data();
+    auto pTail = token.data() + token.size();
+
+    // from_chars は先頭の空白と '+' を受け付けないので読み飛ばしておく.
+    while(pHead != pTail && isspace(uint8_t(*pHead)))
+    { pHead++; }
+    if (pHead != pTail && *pHead == '+')
+    { pHead++; }
+
+    T result = 0;
+    std::from_chars(pHead, pTail, result);
+    return result;
 }
 
 } // namespace
@@ -51,11 +83,14 @@ static const char *stristr (const char *haystack, const char *needle)
 Tokenizer::Tokenizer()
 : m_pBuffer     (nullptr)
 , m_pPtr        (nullptr)
+, m_pEnd        (nullptr)
+, m_Token       ()
 , m_pToken      (nullptr)
+, m_Copied      (false)
 , m_Separator   ()
 , m_CutOff      ()
 , m_BufferSize  (0)
-{ /* DO_NOTHING */ }
+{ UpdateCharClass(); }
 
 //-------------------------------------------------------------------------------------------------
 //      デストラクタです.
@@ -68,12 +103,29 @@ Tokenizer::~Tokenizer()
 //-------------------------------------------------------------------------------------------------
 bool Tokenizer::Init(uint32_t size)
 {
+    // 十分な大きさのバッファを確保済みであれば再利用する.
+    if (m_pToken != nullptr)
+    {
+        if (m_BufferSize >= size)
+        {
+            m_pToken[0] = '\0';
+            m_Token     = std::string_view();
+            m_Copied    = true;
+            return true;
+        }
+
+        delete [] m_pToken;
+        m_pToken = nullptr;
+    }
+
     m_pToken = new(std::nothrow) char[size];
     if (m_pToken == nullptr)
     { return false; }
 
     memset(m_pToken, 0, sizeof(char) * size);
     m_BufferSize = size;
+    m_Token      = std::string_view();
+    m_Copied     = true;
 
     return true;
 }
@@ -91,41 +143,86 @@ void Tokenizer::Term()
 
     m_Separator.clear();
     m_CutOff.clear();
+    UpdateCharClass();
     m_pPtr      = nullptr;
+    m_pEnd      = nullptr;
     m_pBuffer   = nullptr;
+    m_Token     = std::string_view();
+    m_Copied    = false;
+    m_BufferSize = 0;
 }
 
 //-------------------------------------------------------------------------------------------------
 //      区切り文字を設定します.
 //-------------------------------------------------------------------------------------------------
 void Tokenizer::SetSeparator(const char *separator)
-{ m_Separator = std::string(separator); }
+{
+    m_Separator = std::string(separator);
+    UpdateCharClass();
+}
 
 //-------------------------------------------------------------------------------------------------
 //      区切り文字を設定します.
 //-------------------------------------------------------------------------------------------------
 void Tokenizer::SetSeparator(const std::string& separator)
-{ m_Separator = separator; }
+{
+    m_Separator = separator;
+    UpdateCharClass();
+}
 
 //-------------------------------------------------------------------------------------------------
 //      切り出し文字を設定します.
 //-------------------------------------------------------------------------------------------------
 void Tokenizer::SetCutOff(const char *cutoff)
-{ m_CutOff = std::string(cutoff); }
+{
+    m_CutOff = std::string(cutoff);
+    UpdateCharClass();
+}
 
 //-------------------------------------------------------------------------------------------------
 //      切り出し文字を設定します.
 //-------------------------------------------------------------------------------------------------
 void Tokenizer::SetCutOff(const std::string& cutoff)
-{ m_CutOff = cutoff; }
+{
+    m_CutOff = cutoff;
+    UpdateCharClass();
+}
+
+//-------------------------------------------------------------------------------------------------
+//      文字種別テーブルを更新します.
+//-------------------------------------------------------------------------------------------------
+void Tokenizer::UpdateCharClass()
+{
+    memset(m_CharClass, 0, sizeof(m_CharClass));
+
+    for(auto c : m_Separator)
+    { m_CharClass[uint8_t(c)] |= kCharSeparator; }
+
+    for(auto c : m_CutOff)
+    { m_CharClass[uint8_t(c)] |= kCharCutOff; }
+
+    // 終端文字は区切り文字にも切り出し文字にもしない.
+    m_CharClass[0] = kCharTerminator;
+
+    auto tokenEnd = m_Separator + m_CutOff;
+    m_SeparatorSet.Set(m_Separator.c_str(), false);
+    m_TokenEndSet .Set(tokenEnd.c_str(), true);
+}
 
 //-------------------------------------------------------------------------------------------------
 //      バッファを設定します.
 //-------------------------------------------------------------------------------------------------
-void Tokenizer::SetBuffer(char *buffer)
+void Tokenizer::SetBuffer(const char *buffer)
+{ SetBuffer(buffer, strlen(buffer)); }
+
+//-------------------------------------------------------------------------------------------------
+//      サイズ指定でバッファを設定します.
+//-------------------------------------------------------------------------------------------------
+void Tokenizer::SetBuffer(const char *buffer, size_t size)
 {
     m_pBuffer = buffer;
     m_pPtr    = buffer;
+    m_pEnd    = buffer + size;
 
     Next();
 }
@@ -136,39 +233,39 @@ void Tokenizer::SetBuffer(char *buffer)
 void Tokenizer::Next()
 {
     auto p = m_pPtr;
-    auto q = m_pToken;
 
-    // 区切り文字はスキップする
-    while ((*p) != '\0' && strchr(m_Separator.c_str(), *p))
-    { p++; }
+    // 区切り文字はスキップする (空白の連続はまとめて読み飛ばす)
+    p = TextScanner::SkipAny(p, m_pEnd, m_SeparatorSet);
+
+    auto head = p;
 
-    // 切り出し文字とヒットするか判定
-    if (strchr(m_CutOff.c_str(), *p))
+    // 切り出し文字とヒットするか判定 (範囲の終端より先は見ない)
+    if (p < m_pEnd && (m_CharClass[uint8_t(*p)] & kCharCutOff))
     {
         //切り出し文字とヒットしたら，単体トークンとする
-        if (size_t(q - m_pToken) < m_BufferSize)
-        { (*(q++)) = (*(p++)); }
-        else
-        { p++; }
+        p++;
     }
     else
     {
         //区切り文字または切り出し文字以外ならトークンとする
-        std::string split = m_Separator + m_CutOff;
-        while (*p != '\0' && !strchr(split.c_str(), *p))
-        {
-            if (size_t(q - m_pToken) < m_BufferSize)
-            { (*(q++)) = (*(p++)); }
-            else
-            { p++; }
-        }
+        p = TextScanner::FindAny(p, m_pEnd, m_TokenEndSet);
     }
 
     //抜き出した分だけバッファを進める
     m_pPtr = p;
 
-    //文字列として返すためにNULL終端文字を加える
-    *q = '\0';
+    // トークンはバッファを指すだけにして，char* で要求されるまでコピーしない.
+    m_Token  = std::string_view(head, size_t(p - head));
+    m_Copied = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      次のトークンを取得して，コピーせずに返却します.
+//-------------------------------------------------------------------------------------------------
+std::string_view Tokenizer::NextAsView()
+{
+    Next();
+    return m_Token;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -197,64 +294,83 @@ void Tokenizer::SkipTo(const std::string& text)
 void Tokenizer::SkipLine()
 {
     auto p = m_pPtr;
-    auto q = m_pToken;
 
     // 区切り文字はスキップする
-    while ((*p) != '\0' && strchr(" \t", *p))
-    { p++; }
+    p = TextScanner::SkipAny(p, m_pEnd, kBlankSet);
 
-    auto pos = strstr(p, "\n");
-    if (pos != nullptr)
+    auto pos = TextScanner::FindLineEnd(p, m_pEnd);
+    if (pos != m_pEnd)
     {
-        m_pPtr = pos;
-        m_pToken[0] = '\0';
+        m_pPtr   = pos;
+        m_Token  = std::string_view();
+        m_Copied = false;
     }
 }
 
+//-------------------------------------------------------------------------------------------------
+//      指定位置に移動します. トークンは空になり，次の Next() で ptr 以降を切り出します.
+//-------------------------------------------------------------------------------------------------
+void Tokenizer::Seek(const char* ptr)
+{
+    if (ptr < m_pBuffer || ptr > m_pEnd)
+    { return; }
+
+    m_pPtr   = ptr;
+    m_Token  = std::string_view();
+    m_Copied = false;
+}
+
 //-------------------------------------------------------------------------------------------------
 //      トークンを1行として取得します.
 //-------------------------------------------------------------------------------------------------
 char* Tokenizer::GetLine()
 {
     auto p = m_pPtr;
-    auto q = m_pToken;
 
     // 区切り文字はスキップする
-    while ((*p) != '\0' && strchr(" \t", *p))
-    { p++; }
+    p = TextScanner::SkipAny(p, m_pEnd, kBlankSet);
 
-    auto pos = strstr(p, "\n");
-    if (pos != nullptr)
+    // 改行文字まで含めて1行とする.
+    auto pos = TextScanner::FindLineEnd(p, m_pEnd);
+    if (pos != m_pEnd)
     {
-        auto size = pos - p;
-        memcpy(m_pToken, p, size);
-        m_pToken[size] = '\n';
-        m_pToken[size + 1] = '\0';
+        auto size = size_t(pos - p);
+        m_Token  = std::string_view(p, size + 1);
+        m_Copied = false;
         p += size;
     }
 
     m_pPtr = p;
 
-    return m_pToken;
+    return GetAsChar();
 }
 
+//-------------------------------------------------------------------------------------------------
+//      指定された文字列とトークンが一致するかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool Tokenizer::Compare(std::string_view token) const
+{ return m_Token == token; }
+
 //-------------------------------------------------------------------------------------------------
 //      指定された文字列とトークンが一致するかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Tokenizer::Compare(const char *token) const
-{ return (strcmp(m_pToken, token) == 0); }
+{ return Compare(std::string_view(token)); }
 
 //-------------------------------------------------------------------------------------------------
 //      指定された文字列とトークンが一致するかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Tokenizer::Compare(const std::string& token) const
-{ return (strcmp(m_pToken, token.c_str() ) == 0); }
+{ return Compare(std::string_view(token)); }
 
 //-------------------------------------------------------------------------------------------------
 //      指定された文字列とトークンが一致するかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Tokenizer::CompareAsLower(const char *token) const
-{ return (_stricmp(m_pToken, token) == 0); }
+{
+    auto size = strlen(token);
+    return (m_Token.size() == size) && EqualAsLower(m_Token.data(), token, size);
+}
 
 //-------------------------------------------------------------------------------------------------
 //      指定された文字列とトークンが一致するかチェックします.
@@ -262,23 +378,38 @@ bool Tokenizer::CompareAsLower(const char *token) const
 bool Tokenizer::CompareAsLower(const std::string& token) const
 { return CompareAsLower(token.c_str()); }
 
+//-------------------------------------------------------------------------------------------------
+//      指定された文字列を含むかどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool Tokenizer::Contain(std::string_view token) const
+{ return m_Token.find(token) != std::string_view::npos; }
+
 //-------------------------------------------------------------------------------------------------
 //      指定された文字列を含むかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Tokenizer::Contain(const char* token) const
-{ return strstr(m_pToken, token) != nullptr; }
+{ return Contain(std::string_view(token)); }
 
 //-------------------------------------------------------------------------------------------------
 //      指定された文字列を含むかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Tokenizer::Contain(const std::string& token) const
-{ return Contain(token.c_str()); }
+{ return Contain(std::string_view(token)); }
 
 //-------------------------------------------------------------------------------------------------
 //      指定された文字列を含むかどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Tokenizer::ContainAsLower(const char* token) const
-{ return stristr(m_pToken, token) != nullptr; }
+{
+    auto size = strlen(token);
+    for(size_t i=0; i + size <= m_Token.size(); ++i)
+    {
+        if (EqualAsLower(m_Token.data() + i, token, size))
+        { return true; }
+    }
+
+    return false;
+}
 
 //-------------------------------------------------------------------------------------------------
 //      指定された文字列を含むかどうかチェックします.
@@ -286,53 +417,85 @@ bool Tokenizer::ContainAsLower(const char* token) const
 bool Tokenizer::ContainAsLower(const std::string& token) const
 { return ContainAsLower(token.c_str()); }
 
+//-------------------------------------------------------------------------------------------------
+//      トークンが指定された文字列で始まるかどうかチェックします.
+//-------------------------------------------------------------------------------------------------
+bool Tokenizer::StartsWith(std::string_view token) const
+{ return m_Token.substr(0, token.size()) == token; }
+
 //-------------------------------------------------------------------------------------------------
 //      最後かどうかチェックします.
 //-------------------------------------------------------------------------------------------------
 bool Tokenizer::IsEnd() const
-{ return (*m_pPtr == '\0' || m_pPtr == nullptr); }
+{ return (m_pPtr == nullptr || m_pPtr >= m_pEnd || *m_pPtr == '\0'); }
 
 //-------------------------------------------------------------------------------------------------
 //      バッファを取得します.
 //-------------------------------------------------------------------------------------------------
-char* Tokenizer::GetBuffer() const
+const char* Tokenizer::GetBuffer() const
 { return m_pBuffer; }
 
+//-------------------------------------------------------------------------------------------------
+//      バッファの終端 (終端文字の位置) を取得します.
+//-------------------------------------------------------------------------------------------------
+const char* Tokenizer::GetEnd() const
+{ return m_pEnd; }
+
 //-------------------------------------------------------------------------------------------------
 //      現在のポインタを取得します.
 //-------------------------------------------------------------------------------------------------
-char* Tokenizer::GetPtr() const
+const char* Tokenizer::GetPtr() const
 { return m_pPtr; }
 
+//-------------------------------------------------------------------------------------------------
+//      トークンをコピーせずに取得します. 次のトークンに進むまで有効です.
+//-------------------------------------------------------------------------------------------------
+std::string_view Tokenizer::GetView() const
+{ return m_Token; }
+
 //-------------------------------------------------------------------------------------------------
 //      char型としてトークンを取得します.
 //-------------------------------------------------------------------------------------------------
 char* Tokenizer::GetAsChar() const
-{ return m_pToken; }
+{
+    if (m_pToken == nullptr)
+    { return nullptr; }
+
+    // 終端文字が必要なので，要求された時に初めてバッファにコピーする.
+    if (!m_Copied)
+    {
+        auto size = std::min(m_Token.size(), m_BufferSize - 1);
+        memcpy(m_pToken, m_Token.data(), size);
+        m_pToken[size] = '\0';
+        m_Copied = true;
+    }
+
+    return m_pToken;
+}
 
 //-------------------------------------------------------------------------------------------------
 //      double型としてトークンを取得します.
 //-------------------------------------------------------------------------------------------------
 double Tokenizer::GetAsDouble() const
-{ return atof(m_pToken); }
+{ return ParseNumber<double>(m_Token); }
 
 //-------------------------------------------------------------------------------------------------
 //      float型としてトークンを取得します.
 //-------------------------------------------------------------------------------------------------
 float Tokenizer::GetAsFloat() const
-{ return static_cast<float>(atof(m_pToken)); }
+{ return ParseNumber<float>(m_Token); }
 
 //-------------------------------------------------------------------------------------------------
 //      int型としてトークンを取得します.
 //-------------------------------------------------------------------------------------------------
 int Tokenizer::GetAsInt() const
-{ return atoi(m_pToken); }
+{ return ParseNumber<int>(m_Token); }
 
 //-------------------------------------------------------------------------------------------------
 //      std::string型としてトークンを取得します.
 //-------------------------------------------------------------------------------------------------
 std::string Tokenizer::GetAsString() const
-{ return std::string(m_pToken); }
+{ return std::string(m_Token); }
 
 //-------------------------------------------------------------------------------------------------
 //      次のトークンを取得して，char型として返却します.
@@ -10,6 +10,8 @@
 //-------------------------------------------------------------------------------------------------
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include "TextScanner.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -40,48 +42,64 @@ public:
     void        SetSeparator    ( const std::string& seperator );
     void        SetCutOff       ( const char* cutoff );
     void        SetCutOff       ( const std::string& cutoff );
-    void        SetBuffer       ( char *buffer );
+    void        SetBuffer       ( const char *buffer );
+    void        SetBuffer       ( const char *buffer, size_t size );   // [buffer, buffer+size) を切り出す. buffer[size] は読み出し可能であること.
+    bool        Compare         ( std::string_view token ) const;
     bool        Compare         ( const char *token ) const;
     bool        CompareAsLower  ( const char *token ) const;
     bool        Compare         ( const std::string& token ) const;
     bool        CompareAsLower  ( const std::string& token ) const;
+    bool        Contain         ( std::string_view token ) const;
     bool        Contain         ( const char *token ) const;
     bool        Contain         ( const std::string& token ) const;
     bool        ContainAsLower  ( const char * token ) const;
     bool        ContainAsLower  ( const std::string& token ) const;
+    bool        StartsWith      ( std::string_view token ) const;
     bool        IsEnd           () const;
+    std::string_view GetView    () const;
     char*       GetAsChar       () const;
     double      GetAsDouble     () const;
     float       GetAsFloat      () const;
     int         GetAsInt        () const;
     std::string GetAsString     () const;
     void        Next            ();
+    std::string_view NextAsView ();
     char*       NextAsChar      ();
     double      NextAsDouble    ();
     float       NextAsFloat     ();
     int         NextAsInt       ();
     std::string NextAsString    ();
-    char*       GetPtr          () const;
-    char*       GetBuffer       () const;
+    const char* GetPtr          () const;
+    const char* GetBuffer       () const;
+    const char* GetEnd          () const;
     void        SkipTo          ( const char* text );
     void        SkipTo          ( const std::string& text );
     void        SkipLine        ();
+    void        Seek            ( const char* ptr );
     char*       GetLine         ();
 
 private:
     //=============================================================================================
     // private variables
     //=============================================================================================
-    char*           m_pBuffer;      //!< 先頭ポインタ.
-    char*           m_pPtr;         //!< バッファ位置です.
-    char*           m_pToken;       //!< トークン.
+    const char*     m_pBuffer;      //!< 先頭ポインタ.
+    const char*     m_pPtr;         //!< バッファ位置です.
+    const char*     m_pEnd;         //!< バッファの終端 (終端文字の位置).
+    std::string_view m_Token;       //!< トークン (バッファ内を指す).
+    char*           m_pToken;       //!< char* で返すためのトークンのコピー.
+    mutable bool    m_Copied;       //!< m_pToken が m_Token と同じ内容かどうか.
     std::string     m_Separator;    //!< 区切り文字.
     std::string     m_CutOff;       //!< 切り出し文字.
     size_t          m_BufferSize;
+    uint8_t         m_CharClass[256];   //!< 文字種別テーブル (区切り文字, 切り出し文字, 終端文字).
+    TextScanner::CharSet m_SeparatorSet;    //!< 区切り文字の集合 (SIMD走査用).
+    TextScanner::CharSet m_TokenEndSet;     //!< トークンを終える文字の集合 (SIMD走査用).
 
     //=============================================================================================
     // private methods
     //=============================================================================================
+    void UpdateCharClass();
+
     Tokenizer       (const Tokenizer&) = delete;
     void operator = (const Tokenizer&) = delete;
 };
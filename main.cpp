@@ -9,29 +9,204 @@
 //-------------------------------------------------------------------------------------------------
 #include "AsmParser.h"
 #include "StringHelper.h"
+#include "Logger.h"
+#include "Bundle.h"
+#include "PackWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Option structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Option
+{
+    AsmParser::Argument         Base;       // 全入力に共通の引数.
+    std::vector<std::string>    Inputs;     // 入力ファイル.
+    std::vector<std::string>    Lists;      // 入力ファイルを列挙したリストファイル.
+    std::vector<std::string>    Dirs;       // 入力ファイルを含むディレクトリ.
+    int                         Jobs;       // 並列数 (0 以下の場合は論理コア数).
+    bool                        Bundle;     // 入力ファイルを複数シェーダの連結として扱うかどうか.
+    std::string                 Pack;       // 全ての出力をまとめるパックファイル (空の場合は個別に出力).
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Task structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Task
+{
+    std::string             Input;      // 入力名 (メッセージ表示用).
+    std::string             Output;     // 出力ファイル名 (接尾辞無し, 空の場合は入力から決める).
+    std::string             Name;       // リフレクションの検索に使う名前.
+    const Bundle::Segment*  pSegment;   // バンドルから切り出したシェーダ (ファイル単位の場合は nullptr).
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Result structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct Result
+{
+    bool                    Success;    // 変換に成功したかどうか.
+    std::vector<LogRecord>  Records;    // 変換中に出力されたメッセージ.
+};
+
 //-------------------------------------------------------------------------------------------------
 //      コマンドライン引数を解析します.
 //-------------------------------------------------------------------------------------------------
-void ParseArg(int argc, char** argv, AsmParser::Argument& result)
+void ParseArg(int argc, char** argv, Option& result)
 {
-    result.Input = argv[1];
-    for(auto i=2; i<argc; ++i)
+    for(auto i=1; i<argc; ++i)
     {
-        if (_stricmp(argv[i], "-o") == 0)
+        if (_stricmp(argv[i], "-o") == 0 && i + 1 < argc)
         {
             i++;
-            result.Output = argv[i];
+            result.Base.Output = argv[i];
         }
-        else if (_stricmp(argv[i], "-e") == 0)
+        else if (_stricmp(argv[i], "-e") == 0 && i + 1 < argc)
         {
             i++;
-            result.EntryPoint = argv[i];
+            result.Base.EntryPoint = argv[i];
+        }
+        else if (_stricmp(argv[i], "-nomap") == 0)
+        {
+            result.Base.DisableMapping = true;
+        }
+        else if (_stricmp(argv[i], "-l") == 0 && i + 1 < argc)
+        {
+            i++;
+            result.Lists.push_back(argv[i]);
+        }
+        else if (_stricmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            i++;
+            result.Dirs.push_back(argv[i]);
+        }
+        else if (_stricmp(argv[i], "-cache") == 0 && i + 1 < argc)
+        {
+            i++;
+            result.Base.CacheDir = argv[i];
+        }
+        else if (_stricmp(argv[i], "-cachesize") == 0 && i + 1 < argc)
+        {
+            i++;
+            result.Base.CacheSize = strtoull(argv[i], nullptr, 10) * 1024 * 1024;
+        }
+        else if (_stricmp(argv[i], "-r") == 0 && i + 1 < argc)
+        {
+            i++;
+            result.Base.Reflection = argv[i];
+        }
+        else if (_stricmp(argv[i], "-rcheck") == 0)
+        {
+            result.Base.CheckReflection = true;
+        }
+        else if (_stricmp(argv[i], "-bundle") == 0)
+        {
+            result.Bundle = true;
+        }
+        else if (_stricmp(argv[i], "-pack") == 0 && i + 1 < argc)
+        {
+            i++;
+            result.Pack = argv[i];
+        }
+        else if (_stricmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            i++;
+            result.Jobs = atoi(argv[i]);
+        }
+        else if (argv[i][0] != '-' || argv[i][1] == '\0')
+        {
+            result.Inputs.push_back(argv[i]);
         }
     }
 }
 
+//-------------------------------------------------------------------------------------------------
+//      リストファイルに記載された入力ファイルを追加します.
+//-------------------------------------------------------------------------------------------------
+bool AddFromList(const std::string& filename, std::vector<std::string>& result)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+    { return false; }
+
+    std::string line;
+    while(std::getline(file, line))
+    {
+        // 前後の空白を取り除く.
+        auto head = line.find_first_not_of(" \t\r");
+        if (head == std::string::npos)
+        { continue; }
+
+        auto tail = line.find_last_not_of(" \t\r");
+        line = line.substr(head, tail - head + 1);
+
+        // コメント行は飛ばす.
+        if (line[0] == '#')
+        { continue; }
+
+        result.push_back(line);
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      ディレクトリ内のアセンブリファイル及びコンパイル済みシェーダを追加します.
+//-------------------------------------------------------------------------------------------------
+bool AddFromDirectory(const std::string& path, std::vector<std::string>& result)
+{
+    std::error_code err;
+    std::vector<std::string> files;
+
+    std::filesystem::directory_iterator itr(path, err);
+    for(; !err && itr != std::filesystem::directory_iterator(); itr.increment(err))
+    {
+        if (!itr->is_regular_file(err))
+        { continue; }
+
+        auto ext = StringHelper::ToLower(itr->path().extension().string());
+        if (ext == ".asm" || ext == ".dxbc" || ext == ".cso")
+        { files.push_back(itr->path().string()); }
+    }
+
+    if (err)
+    { return false; }
+
+    // 列挙順に依存しないように整列しておく.
+    std::sort(files.begin(), files.end());
+    result.insert(result.end(), files.begin(), files.end());
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      入力ファイルに対応するコンパイル済みシェーダを探します.
+//-------------------------------------------------------------------------------------------------
+std::string FindReflection(const std::string& path, const std::string& input)
+{
+    // ファイルが直接指定されている場合はそのまま使う.
+    std::error_code err;
+    if (path.empty() || !std::filesystem::is_directory(path, err))
+    { return path; }
+
+    // ディレクトリの場合は同名のファイルがある入力だけバイナリから読み込む.
+    auto stem = std::filesystem::path(input).stem().string();
+    for(auto ext : { ".dxbc", ".cso" })
+    {
+        auto candidate = std::filesystem::path(path) / (stem + ext);
+        if (std::filesystem::is_regular_file(candidate, err))
+        { return candidate.string(); }
+    }
+
+    return std::string();
+}
+
 //-------------------------------------------------------------------------------------------------
 //      メインエントリーポイントです.
 //-------------------------------------------------------------------------------------------------
@@ -39,29 +214,242 @@ int main(int argc, char** argv)
 {
     if (argc <= 1)
     {
-        printf_s("revert_mesh.exe inputfile [option]\n");
+        printf_s("revert_mesh.exe inputfile [inputfile ...] [option]\n");
+        printf_s("    (inputfile is fxc disassembly text or compiled DXBC binary, - reads stdin)\n");
         printf_s("[option]\n");
-        printf_s("    -o outputfile\n");
+        printf_s("    -o outputfile (output directory when converting multiple files, - writes stdout)\n");
         printf_s("    -e entrypoint\n");
+        printf_s("    -l listfile (text file listing one input file per line)\n");
+        printf_s("    -d directory (convert every *.asm, *.dxbc and *.cso file in the directory)\n");
+        printf_s("    -j jobs (number of worker threads for multiple files, default is all cores)\n");
+        printf_s("    -bundle (each input file holds many shaders, outputs are named <input name>_NNNN)\n");
+        printf_s("    -pack packfile (append every output to one pack file with a name sorted index)\n");
+        printf_s("    -nomap (read input file without memory mapping)\n");
+        printf_s("    -r file|directory (read reflection from compiled shader instead of asm comments,\n");
+        printf_s("                       a directory is searched for <input name>.dxbc or .cso per input)\n");
+        printf_s("    -rcheck (verify that -r reflection matches the asm comments)\n");
+        printf_s("    -cache directory (reuse outputs of identical inputs stored in the directory)\n");
+        printf_s("    -cachesize megabytes (cache capacity, default is 256)\n");
         printf_s("    (ex) revert_mesh.exe test.asm -o test.hlsl -e main\n");
+        printf_s("    (ex) revert_mesh.exe -d shaders -o output -j 8\n");
+        printf_s("    (ex) revert_mesh.exe -d shaders -pack shaders.hpak\n");
+        printf_s("    (ex) fxc /T ps_5_0 /Fc - test.hlsl | revert_mesh.exe - > test_ps.hlsl\n");
         return 0;
     }
 
-    AsmParser::Argument argument = {};
-    argument.EntryPoint = "main";
+    Option option = {};
+    option.Base.EntryPoint = "main";
+
+    ParseArg(argc, argv, option);
+
+    // 照合する相手が無いので -rcheck は -r と一緒に指定する必要がある.
+    if (option.Base.CheckReflection && option.Base.Reflection.empty())
+    {
+        fprintf_s(stderr, "Error : -rcheck Requires -r.\n");
+        return -1;
+    }
+
+    auto inputs = option.Inputs;
+    for(auto& itr : option.Lists)
+    {
+        if (!AddFromList(itr, inputs))
+        {
+            fprintf_s(stderr, "Error : List File Open Failed. filename = %s\n", itr.c_str());
+            return -1;
+        }
+    }
+    for(auto& itr : option.Dirs)
+    {
+        if (!AddFromDirectory(itr, inputs))
+        {
+            fprintf_s(stderr, "Error : Directory Open Failed. path = %s\n", itr.c_str());
+            return -1;
+        }
+    }
 
-    ParseArg(argc, argv, argument);
+    if (inputs.empty())
+    {
+        fprintf_s(stderr, "Error : No Input File.\n");
+        return -1;
+    }
 
-    AsmParser parser;
-    if (!parser.Convert(argument))
+    // 単一ファイルの場合は従来通り.
+    if (inputs.size() == 1 && !option.Bundle && option.Pack.empty())
     {
-        fprintf_s(stderr, "Error : Convert Failed. filename = %s\n", argument.Input.c_str());
+        auto argument       = option.Base;
+        argument.Input      = inputs[0];
+        argument.Reflection = FindReflection(option.Base.Reflection, inputs[0]);
+
+        // 標準出力に変換結果を流す場合はメッセージを混ぜない.
+        auto pInfo = (argument.Output == "-" || (argument.Output.empty() && argument.Input == "-"))
+            ? stderr : stdout;
+
+        AsmParser parser;
+        if (!parser.Convert(argument))
+        {
+            fprintf_s(stderr, "Error : Convert Failed. filename = %s\n", argument.Input.c_str());
+            return -1;
+        }
+        else
+        {
+            fprintf_s(pInfo, "Info : Convert Success.");
+        }
+
+        return 0;
+    }
+
+    // 標準入出力は1ファイル分しか扱えない.
+    if (option.Base.Output == "-" || std::find(inputs.begin(), inputs.end(), "-") != inputs.end())
+    {
+        fprintf_s(stderr, "Error : Standard Input/Output Is Only Available For A Single Input.\n");
         return -1;
     }
-    else
+
+    // 複数ファイルで1つのバイナリを共有することは無いので，ディレクトリ指定に限る.
+    std::error_code err;
+    if (!option.Base.Reflection.empty() && !std::filesystem::is_directory(option.Base.Reflection, err))
+    {
+        fprintf_s(stderr, "Error : Reflection Path Must Be Directory For Multiple Inputs. path = %s\n", option.Base.Reflection.c_str());
+        return -1;
+    }
+
+    // 複数ファイルの場合は -o を出力ディレクトリとして扱う.
+    // パックに出力する場合はエントリ名にファイル名部分だけを使うのでディレクトリは作らない.
+    auto outputDir = option.Base.Output;
+    if (!outputDir.empty() && option.Pack.empty())
     {
-        fprintf_s(stdout, "Info : Convert Success.");
+        std::filesystem::create_directories(outputDir, err);
     }
 
-    return 0;
-}
\ No newline at end of file
+    // 変換単位を列挙する. バンドルはファイルをマッピングしたまま，シェーダ毎の範囲を渡す.
+    std::vector<std::unique_ptr<Bundle>> bundles;
+    std::vector<Task> tasks;
+    tasks.reserve(inputs.size());
+
+    for(auto& input : inputs)
+    {
+        auto path = std::filesystem::path(input);
+        auto dir  = outputDir.empty() ? path.parent_path() : std::filesystem::path(outputDir);
+        auto stem = path.stem().string();
+
+        if (!option.Bundle)
+        {
+            Task task = {};
+            task.Input  = input;
+            task.Output = outputDir.empty() ? std::string() : (dir / stem).string();
+            task.Name   = input;
+            tasks.push_back(task);
+            continue;
+        }
+
+        std::unique_ptr<Bundle> bundle(new Bundle());
+        if (!bundle->Open(input.c_str(), option.Base.DisableMapping))
+        {
+            fprintf_s(stderr, "Error : Bundle File Open Failed. filename = %s\n", input.c_str());
+            return -1;
+        }
+
+        auto& segments = bundle->GetSegments();
+        for(size_t i=0; i<segments.size(); ++i)
+        {
+            auto name = StringHelper::Format("%s_%04zu", stem.c_str(), i);
+
+            Task task = {};
+            task.Input    = StringHelper::Format("%s(%zu)", input.c_str(), i);
+            task.Output   = (dir / name).string();
+            task.Name     = name;
+            task.pSegment = &segments[i];
+            tasks.push_back(task);
+        }
+
+        bundles.push_back(std::move(bundle));
+    }
+
+    // パックは全ワーカーで共有し，入力順に追記していく.
+    PackWriter pack;
+    if (!option.Pack.empty())
+    {
+        if (!pack.Open(option.Pack.c_str()))
+        {
+            fprintf_s(stderr, "Error : Pack File Open Failed. filename = %s\n", option.Pack.c_str());
+            return -1;
+        }
+
+        option.Base.pPack = &pack;
+    }
+
+    // 各ワーカーが自前のパーサーを持ち，変換単位を先頭から順に取り出して変換する.
+    std::vector<Result> results(tasks.size());
+    std::atomic<size_t> next(0);
+
+    auto worker = [&]()
+    {
+        // パーサーは使い回して，ファイル毎の初期化コストを抑える.
+        AsmParser parser;
+
+        for(auto idx = next++; idx < tasks.size(); idx = next++)
+        {
+            auto& task = tasks[idx];
+
+            auto argument       = option.Base;
+            argument.Input      = task.Input;
+            argument.Output     = task.Output;
+            argument.Reflection = FindReflection(option.Base.Reflection, task.Name);
+            argument.PackSequence = idx;
+
+            // 出力が混ざらないよう，メッセージはファイル毎に溜めておく.
+            Logger::BeginCapture();
+            auto success = (task.pSegment != nullptr)
+                ? parser.Convert(argument, task.pSegment->pData, task.pSegment->Size)
+                : parser.Convert(argument);
+            if (!success)
+            { Logger::Print(stderr, "Error : Convert Failed. filename = %s\n", task.Input.c_str()); }
+
+            results[idx].Success = success;
+            results[idx].Records = Logger::EndCapture();
+
+            // 先行する入力が全て終わっていれば，ここまでの出力がパックに書き出される.
+            if (argument.pPack != nullptr)
+            { argument.pPack->Commit(idx); }
+        }
+    };
+
+    auto jobs = (option.Jobs > 0)
+        ? size_t(option.Jobs)
+        : size_t(std::max(std::thread::hardware_concurrency(), 1u));
+    jobs = std::max(std::min(jobs, tasks.size()), size_t(1));
+
+    std::vector<std::thread> threads;
+    threads.reserve(jobs - 1);
+    for(size_t i=1; i<jobs; ++i)
+    { threads.emplace_back(worker); }
+
+    // メインスレッドもワーカーとして働く.
+    worker();
+
+    for(auto& itr : threads)
+    { itr.join(); }
+
+    // インデックスを書き出すまではパックとして読めないので，失敗したら全体を失敗とする.
+    auto packed = option.Pack.empty() || pack.Close();
+
+    // 完了順に依らず，入力順に結果を報告する.
+    auto failed = 0;
+    for(auto& itr : results)
+    {
+        Logger::Flush(itr.Records);
+        if (!itr.Success)
+        { failed++; }
+    }
+
+    fprintf_s(stdout, "Info : Convert Finished. success = %d, failed = %d\n",
+        int(tasks.size()) - failed, failed);
+
+    if (!packed)
+    {
+        fprintf_s(stderr, "Error : Pack File Write Failed. filename = %s\n", option.Pack.c_str());
+        return -1;
+    }
+
+    return (failed == 0) ? 0 : -1;
+}
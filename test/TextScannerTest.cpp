@@ -0,0 +1,168 @@
+﻿//-------------------------------------------------------------------------------------------------
+// File : TextScannerTest.cpp
+// Desc : TextScanner SIMD/Scalar Consistency Test.
+// Copyright(c) Project Asura. All right reserved.
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+#include "../TextScanner.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <vector>
+
+
+namespace {
+
+using namespace std::string_view_literals;
+
+//-------------------------------------------------------------------------------------------------
+// Constant Values.
+//-------------------------------------------------------------------------------------------------
+const size_t    kMaxLength  = 100;      // 検査する最大長 (16/32 の倍数でない端数も含める).
+const size_t    kMaxOffset  = 33;       // 検査する開始位置のずれ (アライメントの違いを含める).
+const int       kTrialCount = 20;       // 長さと開始位置の組み合わせごとの試行回数.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// TestCase structure
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct TestCase
+{
+    const char*     Name;           // 表示名.
+    const char*     Chars;          // 集合に含める文字.
+    bool            IncludeNull;    // 終端文字も集合に含めるかどうか.
+    std::string_view Alphabet;      // 入力に使う文字 (終端文字を含む場合があるので長さ付き).
+};
+
+const TestCase kTestCases[] = {
+    { "separator"   , " \t\r\n,"            , false , " \t\r\n,abc.xyzw[]0"sv               },
+    { "null"        , " \t"                 , true  , " \t\0ab"sv                           },
+    { "line"        , "\n"                  , false , "\n\rab "sv                           },
+    { "high"        , "\x80\xff"            , false , "\x80\xff\x7f" "a"sv                  },
+    { "many"        , "abcdefghijklmnopq"   , false , "abcdefghijklmnopqrstuvwxyz"sv        },  // MaxChars を超えるのでスカラーのみ.
+};
+
+const char* kLevelNames[] = { "scalar", "sse2", "avx2" };
+
+//-------------------------------------------------------------------------------------------------
+//      集合に含まれるかどうかを1文字ずつ判定する参照実装です.
+//-------------------------------------------------------------------------------------------------
+const char* Reference(const char* pHead, const char* pEnd, const TestCase& test, bool expected)
+{
+    auto p = pHead;
+    for(; p < pEnd; ++p)
+    {
+        auto contained = (*p == '\0')
+            ? test.IncludeNull
+            : (strchr(test.Chars, *p) != nullptr);
+        if (contained != expected)
+        { break; }
+    }
+    return p;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      結果を比較します.
+//-------------------------------------------------------------------------------------------------
+bool Check(const char* func, const TestCase& test, int level, size_t offset, size_t length, const char* pBase, const char* actual, const char* expected)
+{
+    if (actual == expected)
+    { return true; }
+
+    fprintf_s(stderr, "Error : %s mismatch. set = %s, level = %s, offset = %zu, length = %zu, actual = %td, expected = %td\n",
+        func, test.Name, kLevelNames[level], offset, length, actual - pBase, expected - pBase);
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//      指定した命令セットで全ての組み合わせを検査します.
+//-------------------------------------------------------------------------------------------------
+bool RunLevel(int level)
+{
+    TextScanner::SetMaxLevel(static_cast<TextScanner::SIMD_LEVEL>(level));
+
+    std::mt19937 random(12345);
+    std::vector<char> buffer(kMaxOffset + kMaxLength + 32);
+    auto failed = 0;
+
+    for(auto& test : kTestCases)
+    {
+        TextScanner::CharSet set;
+        set.Set(test.Chars, test.IncludeNull);
+
+        std::uniform_int_distribution<size_t> pick(0, test.Alphabet.size() - 1);
+
+        for(size_t length=0; length<=kMaxLength; ++length)
+        {
+            for(size_t offset=0; offset<=kMaxOffset; ++offset)
+            {
+                for(auto trial=0; trial<kTrialCount; ++trial)
+                {
+                    // 範囲外に読み出しても結果が変わらないように，前後は集合の文字で埋めておく.
+                    memset(buffer.data(), test.Chars[0], buffer.size());
+
+                    auto pHead = buffer.data() + offset;
+                    auto pEnd  = pHead + length;
+
+                    // 試行の前半は一様に, 後半は最後の1文字だけを変えて端数の処理を通す.
+                    for(auto p = pHead; p < pEnd; ++p)
+                    {
+                        *p = (trial < kTrialCount / 2 || p + 1 == pEnd)
+                            ? test.Alphabet[pick(random)]
+                            : test.Chars[0];
+                    }
+
+                    auto ok = true;
+                    ok &= Check("SkipAny", test, level, offset, length, pHead,
+                        TextScanner::SkipAny(pHead, pEnd, set),
+                        Reference(pHead, pEnd, test, true));
+                    ok &= Check("FindAny", test, level, offset, length, pHead,
+                        TextScanner::FindAny(pHead, pEnd, set),
+                        Reference(pHead, pEnd, test, false));
+
+                    if (strcmp(test.Chars, "\n") == 0)
+                    {
+                        ok &= Check("FindLineEnd", test, level, offset, length, pHead,
+                            TextScanner::FindLineEnd(pHead, pEnd),
+                            Reference(pHead, pEnd, test, false));
+                    }
+
+                    if (!ok && ++failed >= 10)
+                    { return false; }
+                }
+            }
+        }
+    }
+
+    return failed == 0;
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------------------
+//      メインエントリーポイントです.
+//-------------------------------------------------------------------------------------------------
+int main(int, char**)
+{
+    auto supported = static_cast<int>(TextScanner::GetSupportedLevel());
+    auto failed    = 0;
+
+    for(auto level=0; level<=supported; ++level)
+    {
+        if (RunLevel(level))
+        { fprintf_s(stdout, "Info : %s ... OK\n", kLevelNames[level]); }
+        else
+        { failed++; }
+    }
+
+    if (supported < TextScanner::SIMD_LEVEL_AVX2)
+    { fprintf_s(stdout, "Info : %s is not supported on this CPU, skipped.\n", kLevelNames[supported + 1]); }
+
+    TextScanner::SetMaxLevel(TextScanner::SIMD_LEVEL_AVX2);
+
+    return (failed == 0) ? 0 : -1;
+}